@@ -122,15 +122,17 @@ namespace MyHost {
     : OFX::Host::ImageEffect::Image(clip) /// this ctor will set basic props on the image
     , _data(NULL)
   {
-    // make some memory
-    _data = new OfxRGBAColourB[kPalSizeXPixels * kPalSizeYPixels] ; /// PAL SD RGBA
+    // make some memory, with the row alignment we promise in the host descriptor
+    const size_t rowBytes = OFX::Host::Memory::getRowBytes(kPalSizeXPixels, sizeof(OfxRGBAColourB));
+    const int rowPixels = int(rowBytes / sizeof(OfxRGBAColourB));
+    _data = static_cast<OfxRGBAColourB*>(OFX::Host::Memory::allocAligned(rowBytes * kPalSizeYPixels)); /// PAL SD RGBA
     
     int fillValue = (int)(floor(255.0 * (time/OFXHOSTDEMOCLIPLENGTH))) & 0xff;
     OfxRGBAColourB color;
     color.r = color.g = color.b = fillValue;
     color.a = 255;
 
-    std::fill(_data, _data + kPalSizeXPixels * kPalSizeYPixels, color);
+    std::fill(_data, _data + rowPixels * kPalSizeYPixels, color);
     // draw the time and the view number in reverse color
     const int scale = 5;
     const int charwidth = 4*scale;
@@ -139,20 +141,20 @@ namespace MyHost {
     int yy = 50;
     int d;
     d = (int(time)/10)%10;
-    drawDigit(_data, kPalSizeXPixels, kPalSizeYPixels, d, xx, yy, scale, color);
+    drawDigit(_data, rowPixels, kPalSizeYPixels, d, xx, yy, scale, color);
     xx += charwidth;
     d = int(time)%10;
-    drawDigit(_data, kPalSizeXPixels, kPalSizeYPixels, d, xx, yy, scale, color);
+    drawDigit(_data, rowPixels, kPalSizeYPixels, d, xx, yy, scale, color);
     xx += charwidth;
     d = 10;
-    drawDigit(_data, kPalSizeXPixels, kPalSizeYPixels, d, xx, yy, scale, color);
+    drawDigit(_data, rowPixels, kPalSizeYPixels, d, xx, yy, scale, color);
     xx += charwidth;
     d = int(time*10)%10;
-    drawDigit(_data, kPalSizeXPixels, kPalSizeYPixels, d, xx, yy, scale, color);
+    drawDigit(_data, rowPixels, kPalSizeYPixels, d, xx, yy, scale, color);
     xx = 50;
     yy += 8*scale;
     d = int(view)%10;
-    drawDigit(_data, kPalSizeXPixels, kPalSizeYPixels, d, xx, yy, scale, color);
+    drawDigit(_data, rowPixels, kPalSizeYPixels, d, xx, yy, scale, color);
 
     // render scale x and y of 1.0
     setDoubleProperty(kOfxImageEffectPropRenderScale, 1.0, 0);
@@ -173,7 +175,7 @@ namespace MyHost {
     setIntProperty(kOfxImagePropRegionOfDefinition, kPalRegionPixels.y2, 3);        
 
     // row bytes
-    setIntProperty(kOfxImagePropRowBytes, kPalSizeXPixels * sizeof(OfxRGBAColourB));
+    setIntProperty(kOfxImagePropRowBytes, int(rowBytes));
   }
 
   OfxRGBAColourB* MyImage::pixel(int x, int y) const
@@ -190,7 +192,7 @@ namespace MyHost {
 
   MyImage::~MyImage() 
   {
-    delete _data;
+    OFX::Host::Memory::freeAligned(_data);
   }
 
   MyClipInstance::MyClipInstance(MyEffectInstance* effect, OFX::Host::ImageEffect::ClipDescriptor *desc)
@@ -14,6 +14,9 @@
 #include "ofxhPropertySuite.h"
 #include "ofxhClip.h"
 #include "ofxhParam.h"
+#ifdef OFX_SUPPORTS_PARAMETRIC
+#include "ofxhParametricParam.h"
+#endif
 #include "ofxhMemory.h"
 #include "ofxhImageEffect.h"
 #include "ofxhPluginAPICache.h"
@@ -160,6 +163,10 @@ namespace MyHost {
       return new OFX::Host::Param::GroupInstance(descriptor,this);
     else if(descriptor.getType()==kOfxParamTypePage)
       return new OFX::Host::Param::PageInstance(descriptor,this);
+#ifdef OFX_SUPPORTS_PARAMETRIC
+    else if(descriptor.getType()==kOfxParamTypeParametric)
+      return new OFX::Host::ParametricParam::ParametricInstance(descriptor,this);
+#endif
     else
       return 0;
   }
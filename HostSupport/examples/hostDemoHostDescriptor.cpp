@@ -8,6 +8,7 @@
 #include "ofxCore.h"
 #include "ofxImageEffect.h"
 #include "ofxPixels.h"
+#include "ofxImageAlignment.h"
 
 // ofx host
 #include "ofxhBinary.h"
@@ -41,6 +42,7 @@ namespace MyHost
     _properties.setIntProperty(kOfxImageEffectHostPropIsBackground, 0);
     _properties.setIntProperty(kOfxImageEffectPropSupportsOverlays, 0);
     _properties.setIntProperty(kOfxImageEffectPropSupportsMultiResolution, 0);
+    _properties.setIntProperty(kOfxImageEffectHostPropRowAlignment, OFX::Host::Memory::kRowAlignment);
     _properties.setIntProperty(kOfxImageEffectPropSupportsTiles, true);
     _properties.setIntProperty(kOfxImageEffectPropTemporalClipAccess, true);
     _properties.setStringProperty(kOfxImageEffectPropSupportedComponents,  kOfxImageComponentRGBA, 0);
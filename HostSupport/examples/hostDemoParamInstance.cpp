@@ -14,6 +14,7 @@
 #include "ofxhPropertySuite.h"
 #include "ofxhClip.h"
 #include "ofxhParam.h"
+#include "ofxhParamAnimation.h"
 #include "ofxhMemory.h"
 #include "ofxhImageEffect.h"
 #include "ofxhPluginAPICache.h"
@@ -66,42 +67,10 @@ namespace MyHost {
   MyDoubleInstance::MyDoubleInstance(MyEffectInstance* effect, 
                                      const std::string& name, 
                                      OFX::Host::Param::Descriptor& descriptor)
-    : _effect(effect), _descriptor(descriptor), OFX::Host::Param::DoubleInstance(descriptor)
-  {
-  }
-
-  OfxStatus MyDoubleInstance::get(double& d)
+    : OFX::Host::Param::AnimatedDoubleInstance(descriptor, effect), _effect(effect), _descriptor(descriptor)
   {
     // values for the Basic OFX plugin to work
-    d = 2.0;
-    return kOfxStatOK;
-  }
-
-  OfxStatus MyDoubleInstance::get(OfxTime time, double& d)
-  {
-    // values for the Basic OFX plugin to work
-    d = 2.0;
-    return kOfxStatOK;
-  }
-
-  OfxStatus MyDoubleInstance::set(double)
-  {
-    return kOfxStatErrMissingHostFeature;
-  }
-
-  OfxStatus MyDoubleInstance::set(OfxTime time, double) 
-  {
-    return kOfxStatErrMissingHostFeature;
-  }
-
-  OfxStatus MyDoubleInstance::derive(OfxTime time, double&)
-  {
-    return kOfxStatErrMissingHostFeature;
-  }
-
-  OfxStatus MyDoubleInstance::integrate(OfxTime time1, OfxTime time2, double&)
-  {
-    return kOfxStatErrMissingHostFeature;
+    getCurve(0).setValue(2.0);
   }
 
   //
@@ -3,6 +3,8 @@
 #ifndef HOST_DEMO_PARAM_INSTANCE_H
 #define HOST_DEMO_PARAM_INSTANCE_H
 
+#include "ofxhParamAnimation.h"
+
 namespace MyHost {
 
   class MyPushbuttonInstance : public OFX::Host::Param::PushbuttonInstance {
@@ -25,18 +27,12 @@ namespace MyHost {
     OfxStatus set(OfxTime time, int);
   };
 
-  class MyDoubleInstance : public OFX::Host::Param::DoubleInstance {
+  class MyDoubleInstance : public OFX::Host::Param::AnimatedDoubleInstance {
   protected:
     MyEffectInstance*   _effect;
     OFX::Host::Param::Descriptor& _descriptor;
   public:
     MyDoubleInstance(MyEffectInstance* effect, const std::string& name, OFX::Host::Param::Descriptor& descriptor);
-    OfxStatus get(double&);
-    OfxStatus get(OfxTime time, double&);
-    OfxStatus set(double);
-    OfxStatus set(OfxTime time, double);
-    OfxStatus derive(OfxTime time, double&);
-    OfxStatus integrate(OfxTime time1, OfxTime time2, double&);
   };
 
   class MyBooleanInstance : public OFX::Host::Param::BooleanInstance {
@@ -0,0 +1,251 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_ACTION_LOG_H
+#define OFXH_ACTION_LOG_H
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ofxCore.h"
+
+#include "ofxhPropertySuite.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace Param {
+      class Instance;
+    }
+
+    namespace ImageEffect {
+      class Instance;
+      class ClipInstance;
+      class Image;
+    }
+
+    /// Recording of the action stream sent to plugin instances, and deterministic
+    /// replay of such recordings against a live instance for benchmarking.
+    ///
+    /// The log is a compact binary file made of tagged records. Integers are
+    /// written as LEB128 varints, doubles as raw little endian 8 byte values
+    /// and strings as a varint length followed by the bytes.
+    namespace ActionLog {
+
+      /// magic number at the start of a log file, "OFXL"
+      static const unsigned int kMagic = 0x4c58464f;
+
+      /// version of the log format
+      static const unsigned int kVersion = 1;
+
+      /// tags of the various records found in a log
+      enum RecordTag {
+        eRecordInstance   = 1, ///< first sighting of an instance, with its plugin identifier and context
+        eRecordAction     = 2, ///< an action being called, with its in args and the shape of its out args
+        eRecordActionEnd  = 3, ///< the status an action returned and the time it took
+        eRecordParamValue = 4, ///< a value returned to the plugin by paramGetValue(AtTime)
+        eRecordImage      = 5  ///< an image returned to the plugin by clipGetImage
+      };
+
+      /// a single property value, as held in a log
+      struct PropertyRecord {
+        std::string name;
+        Property::TypeEnum type;
+        std::vector<int> intValues;
+        std::vector<double> doubleValues;
+        std::vector<std::string> stringValues;
+        int dimension;
+      };
+
+      /// a param value the plugin read during an action
+      struct ParamValueRecord {
+        std::string name;
+        std::string type;
+        bool atTime;
+        OfxTime time;
+        std::vector<double> values;  ///< numeric values, ints are stored as doubles
+        std::string stringValue;     ///< value of string and custom params
+      };
+
+      /// an image the plugin fetched during an action
+      struct ImageRecord {
+        std::string clip;
+        OfxTime time;
+        OfxRectI bounds;
+        int rowBytes;
+        std::string components;
+        std::string depth;
+        unsigned long long checksum;
+      };
+
+      /// an action read back from a log
+      struct ActionRecord {
+        unsigned long long serial;
+        unsigned long long instance;
+        std::string action;
+        bool hasInArgs;
+        bool hasOutArgs;
+        std::vector<PropertyRecord> inArgs;
+        std::vector<PropertyRecord> outArgs;
+        std::vector<ParamValueRecord> params;
+        std::vector<ImageRecord> images;
+        OfxStatus status;
+        double seconds;              ///< time the action took when recorded
+      };
+
+      /// checksum the pixels of an image within its bounds, ignoring any row padding
+      unsigned long long ChecksumImage(const ImageEffect::Image &image);
+
+      /// Writes a log of the actions and suite calls made to plugin instances.
+      ///
+      /// A host turns recording on by pointing gRecorder at an open recorder,
+      /// the hooks in ImageEffect::Instance::mainEntry, the param suite and
+      /// the clip suite then feed it. All the record functions are thread safe.
+      class Recorder {
+      protected :
+        FILE *_fp;
+        std::mutex _mutex;
+        unsigned long long _nextSerial;
+        unsigned long long _lastSerial;     ///< most recently started action, used by threads not inside an action
+        bool _checksumImages;
+        std::set<const void *> _instances;  ///< instances we have already written an eRecordInstance for
+        std::vector<unsigned char> _buffer; ///< record being assembled
+
+        void putByte(unsigned char v);
+        void putVarint(unsigned long long v);
+        void putInt(int v);
+        void putDouble(double v);
+        void putString(const std::string &s);
+        void putProperties(const Property::Set &set, bool withValues);
+        void flushRecord();
+
+        /// the serial of the action the calling thread is currently inside
+        unsigned long long currentSerial() const;
+
+      public :
+        Recorder();
+        virtual ~Recorder();
+
+        /// open the log file, returns false if it could not be created
+        bool open(const std::string &filename);
+
+        /// close the log file
+        void close();
+
+        /// is the log open
+        bool isOpen() const {return _fp != 0;}
+
+        /// should images be checksummed as they are fetched, on by default
+        void setChecksumImages(bool v) {_checksumImages = v;}
+
+        /// record an action about to be called, returns the serial to pass to endAction
+        unsigned long long beginAction(ImageEffect::Instance &instance,
+                                       const char *action,
+                                       const Property::Set *inArgs,
+                                       const Property::Set *outArgs);
+
+        /// record the end of an action, timing it from the matching beginAction
+        void endAction(unsigned long long serial, OfxStatus stat);
+
+        /// record the value a get call returned, ap is the var args list passed to the get call
+        void recordParamValue(Param::Instance &param, bool atTime, OfxTime time, va_list ap);
+
+        /// record an image returned to the plugin
+        void recordImage(ImageEffect::ClipInstance &clip, OfxTime time, const ImageEffect::Image &image);
+      };
+
+      /// the global recorder, null unless the host is recording
+      extern Recorder *gRecorder;
+
+      /// timings gathered by a replay for one action name
+      struct ActionTiming {
+        int count;
+        double total;
+        double minimum;
+        double maximum;
+        double recordedTotal;  ///< total time the same calls took when recorded
+
+        ActionTiming() : count(0), total(0), minimum(0), maximum(0), recordedTotal(0) {}
+      };
+
+      /// Reads a log back and drives an image effect instance with the recorded
+      /// action sequence at full speed, timing each action.
+      ///
+      /// Actions that create, destroy or describe are skipped, as the host has
+      /// already made the instance being replayed against.
+      class Replayer {
+      protected :
+        std::vector<ActionRecord> _actions;
+        std::vector<unsigned long long> _instanceIds;
+        std::map<unsigned long long, std::string> _pluginIds;
+        std::map<std::string, ActionTiming> _timings;
+        bool _syntheticImages;
+        const ActionRecord *_current;
+
+        /// build a property set from recorded properties
+        static void buildPropertySet(const std::vector<PropertyRecord> &props, Property::Set &set);
+
+      public :
+        Replayer();
+        virtual ~Replayer();
+
+        /// read a log, returns false if the file is not a valid log
+        bool load(const std::string &filename);
+
+        /// the instances found in the log, in order of first appearance
+        const std::vector<unsigned long long> &getInstanceIds() const {return _instanceIds;}
+
+        /// the plugin identifier of a recorded instance
+        const std::string &getPluginIdentifier(unsigned long long instanceId) const;
+
+        /// the recorded actions
+        const std::vector<ActionRecord> &getActions() const {return _actions;}
+
+        /// replay images are synthetic rather than the host's own, see fillSyntheticImage
+        void setSyntheticImages(bool v) {_syntheticImages = v;}
+
+        /// are replay images synthetic
+        bool getSyntheticImages() const {return _syntheticImages;}
+
+        /// Replay the actions recorded against instanceId on the given instance,
+        /// an id of 0 means the first instance in the log. repeat is the number
+        /// of passes over the sequence. Returns kOfxStatFailed if the id is not
+        /// in the log.
+        OfxStatus replay(ImageEffect::Instance &instance, unsigned long long instanceId = 0, int repeat = 1);
+
+        /// The action currently being replayed, null outside of replay. Hosts
+        /// can use this from ClipInstance::getImage to find what was fetched.
+        const ActionRecord *getCurrentAction() const {return _current;}
+
+        /// find the image the current action fetched from the given clip at the given time
+        const ImageRecord *findImage(const std::string &clip, OfxTime time) const;
+
+        /// fill a buffer with a deterministic pattern matching the recorded image description
+        static void fillSyntheticImage(const ImageRecord &image, void *data, int rowBytes);
+
+        /// called before each action is replayed, by default sets the params
+        /// the action read to the values they had when recorded
+        virtual void prepareAction(ImageEffect::Instance &instance, const ActionRecord &action);
+
+        /// the per action timings from the last replay
+        const std::map<std::string, ActionTiming> &getTimings() const {return _timings;}
+
+        /// write a table of the timings
+        void report(std::ostream &os) const;
+      };
+
+    } // namespace ActionLog
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_ACTION_LOG_H
@@ -0,0 +1,118 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_ACTION_MEMO_H
+#define OFXH_ACTION_MEMO_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "ofxCore.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ImageEffect {
+
+      class ClipInstance;
+
+      /// the arguments and param state an isIdentity result depends on
+      struct IdentityKey {
+        unsigned long long paramsHash;
+        OfxTime time;
+        std::string field;
+        OfxRectI renderRoI;
+        OfxPointD renderScale;
+
+        bool operator<(const IdentityKey &other) const;
+      };
+
+      /// what an isIdentity action replied
+      struct IdentityResult {
+        OfxStatus status;     ///< kOfxStatOK if the effect is an identity, kOfxStatReplyDefault if not
+        OfxTime time;         ///< the time to take the identity clip's image at
+        std::string clip;     ///< the identity clip
+      };
+
+      /// the arguments, param state and upstream state a region action result depends on
+      struct RegionKey {
+        unsigned long long paramsHash;
+        unsigned long long inputsHash;  ///< hash of the input clips' regions of definition
+        OfxTime time;
+        OfxPointD renderScale;
+        OfxRectD roi;                   ///< the region of interest asked about, zero for regions of definition
+
+        bool operator<(const RegionKey &other) const;
+      };
+
+      /// what a region of definition action replied
+      struct RoDResult {
+        OfxStatus status;
+        OfxRectD rod;
+      };
+
+      /// what a regions of interest action replied
+      struct RoIResult {
+        OfxStatus status;
+        std::map<ClipInstance *, OfxRectD> rois;
+      };
+
+      /// Remembers the replies of actions that depend only on their arguments
+      /// and the instance's param state, so asking again skips the plugin.
+      ///
+      /// Each table is bounded, once full it is emptied rather than evicting
+      /// entries one by one. Access is thread safe.
+      class ActionMemo {
+      protected :
+        std::mutex _mutex;
+        std::map<IdentityKey, IdentityResult> _identity;
+        std::map<RegionKey, RoDResult> _rods;
+        std::map<RegionKey, RoIResult> _rois;
+        size_t _maxEntries;
+        std::atomic<int> _nHits;
+        std::atomic<int> _nMisses;
+
+      public :
+        explicit ActionMemo(size_t maxEntries = 1024);
+
+        /// look up an isIdentity reply
+        bool findIdentity(const IdentityKey &key, IdentityResult &result);
+
+        /// remember an isIdentity reply
+        void addIdentity(const IdentityKey &key, const IdentityResult &result);
+
+        /// look up a region of definition reply
+        bool findRoD(const RegionKey &key, RoDResult &result);
+
+        /// remember a region of definition reply
+        void addRoD(const RegionKey &key, const RoDResult &result);
+
+        /// look up a regions of interest reply
+        bool findRoI(const RegionKey &key, RoIResult &result);
+
+        /// remember a regions of interest reply
+        void addRoI(const RegionKey &key, const RoIResult &result);
+
+        /// forget the region replies, eg: when a param changes
+        void clearRegions();
+
+        /// forget everything, eg: when a clip is reconnected
+        void clear();
+
+        /// number of lookups answered from the memo
+        int getNumHits() const {return _nHits;}
+
+        /// number of lookups that had to go to the plugin
+        int getNumMisses() const {return _nMisses;}
+      };
+
+    } // namespace ImageEffect
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_ACTION_MEMO_H
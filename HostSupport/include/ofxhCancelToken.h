@@ -0,0 +1,74 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_CANCEL_TOKEN_H
+#define OFXH_CANCEL_TOKEN_H
+
+#include <atomic>
+
+#include "ofxCore.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ImageEffect {
+
+      /// Lets a host cancel a render request from any thread.
+      ///
+      /// A host makes a token for each render request and installs it with a
+      /// CancelScope on the thread that makes the request's actions. Effect
+      /// instances then report the token from the abort suite function and
+      /// hand its flag to plugins as kOfxImageEffectPropRenderAbortFlag. The
+      /// token follows the render onto the threads of the multi thread suite,
+      /// and onto any upstream renders the host makes from a clip's getImage
+      /// on the same thread, so a single cancel stops the whole graph.
+      class CancelToken {
+      protected :
+        std::atomic<int> _cancelled;
+
+      public :
+        CancelToken() : _cancelled(0) {}
+
+        /// cancel the render, can be called from any thread
+        void cancel() {_cancelled.store(1, std::memory_order_release);}
+
+        /// has the render been cancelled
+        bool isCancelled() const {return _cancelled.load(std::memory_order_relaxed) != 0;}
+
+        /// make the token usable for another render
+        void reset() {_cancelled.store(0, std::memory_order_relaxed);}
+
+        /// the flag handed to plugins
+        const int *getFlag() const;
+
+        /// the token installed on the calling thread, if any
+        static CancelToken *getCurrent();
+
+        /// has the token installed on the calling thread been cancelled
+        static bool isCurrentCancelled()
+        {
+          CancelToken *token = getCurrent();
+          return token && token->isCancelled();
+        }
+      };
+
+      /// installs a token on the calling thread for its lifetime, restoring the previous one after
+      class CancelScope {
+        CancelToken *_previous;
+
+        CancelScope(const CancelScope &);
+        CancelScope &operator=(const CancelScope &);
+
+      public :
+        explicit CancelScope(CancelToken *token);
+        ~CancelScope();
+      };
+
+    } // namespace ImageEffect
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_CANCEL_TOKEN_H
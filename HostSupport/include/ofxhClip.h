@@ -5,6 +5,8 @@
 #ifndef OFX_CLIP_H
 #define OFX_CLIP_H
 
+#include <atomic>
+
 #include "ofxImageEffect.h"
 #include "ofxhUtilities.h"
 
@@ -115,6 +117,9 @@ namespace OFX {
         /// is the clip an output clip
         bool isOutput() const {return  _isOutput;}
 
+        /// the effect instance the clip belongs to
+        ImageEffect::Instance *getEffectInstance() const {return _effectInstance;}
+
         /// notify override properties
         virtual void notify(const std::string &name, bool isSingle, int indexOrN);
         
@@ -281,7 +286,7 @@ namespace OFX {
       protected :
         /// called during ctors to get bits from the clip props into ours
         void getClipBits(ClipInstance& instance);
-        int _referenceCount; ///< reference count on this image
+        std::atomic<int> _referenceCount; ///< reference count on this image, images can be shared between threads
 
       public:
         // default constructor
@@ -419,6 +424,48 @@ namespace OFX {
               std::string uniqueIdentifier);
       };
 
+      /// An image whose pixels are a window onto those of another image.
+      ///
+      /// The view's data pointer points into the parent's buffer and it has
+      /// the parent's row bytes, so a host holding a large image can answer a
+      /// request for part of it without allocating or copying. The view holds
+      /// a reference on its parent, which it releases when it is deleted.
+      ///
+      /// If the host advertises kOfxImageEffectHostPropRowAlignment, the
+      /// window's left edge is moved out to the nearest pixel whose rows start
+      /// on that alignment, so the view still shares the parent's pixels. Only
+      /// if the parent's own rows are not aligned is the view made with a copy
+      /// of the window's pixels instead, laid out as Memory::Instance lays out
+      /// images, so plugins can count on what the host promised. Writes to
+      /// such a view are not seen in the parent.
+      class ImageView : public Image {
+      protected :
+        Image *_parent; ///< the image whose pixels we share
+        char *_copy;    ///< our own copy of the pixels, if the parent's could not be shared
+
+        /// make a view onto the given pixel bounds of the parent, which must lie within its bounds
+        ImageView(Image &parent, const OfxRectI &bounds, int bytesPerPixel);
+
+      public :
+        virtual ~ImageView();
+
+        /// the image whose pixels are shared
+        Image &getParent() const {return *_parent;}
+
+        /// whether the view has a copy of its parent's pixels, rather than sharing them
+        bool isCopy() const {return _copy != 0;}
+
+        /// Make a view onto the part of an image covering the given pixel
+        /// bounds, clipped to the image's bounds and widened to the left to
+        /// the host's row alignment. Returns NULL if the bounds miss the image
+        /// or its pixels are of custom components.
+        static ImageView *create(Image &parent, const OfxRectI &bounds);
+
+        /// Make a view onto the part of an image covering the given region of
+        /// the canonical image plane, as passed to ClipInstance::getImage.
+        static ImageView *create(Image &parent, const OfxRectD &canonicalBounds);
+      };
+
 #   ifdef OFX_SUPPORTS_OPENGLRENDER
       /// instance of an OpenGL texture inside an image effect
       class Texture : public ImageBase {
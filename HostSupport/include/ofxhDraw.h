@@ -0,0 +1,180 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_DRAW_H
+#define OFXH_DRAW_H
+
+#include <vector>
+
+#include "ofxCore.h"
+#include "ofxPixels.h"
+#include "ofxDrawSuite.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    /// A software implementation of the draw suite, so overlays can be drawn
+    /// without a GL context, eg: burnt into frames by a headless render.
+    ///
+    /// A Context records the calls an interact makes during its draw action
+    /// into a command buffer, which a Rasteriser then renders into an RGBA
+    /// buffer.
+    namespace Draw {
+
+      /// fetch the draw suite
+      const void *GetSuite(int version);
+
+      /// the primitive of a text command
+      static const int kPrimitiveText = -1;
+
+      /// a single recorded draw call, with the state it was made in
+      struct Command {
+        int primitive;                      ///< an OfxDrawPrimitive, or kPrimitiveText
+        OfxRGBAColourF colour;
+        float lineWidth;
+        OfxDrawLineStipplePattern stipple;
+        int first;                          ///< index of the first point, text has a single point for its position
+        int count;                          ///< number of points
+        int text;                           ///< offset of the text in the text buffer, text commands only
+        int alignment;                      ///< OfxDrawTextAlignment flags, text commands only
+      };
+
+      /// The context handed to an interact's draw action as kOfxInteractPropDrawContext.
+      ///
+      /// All the points and text of a draw action go into shared buffers, so
+      /// recording a frame's overlay allocates nothing once the buffers have
+      /// grown to size.
+      class Context {
+      protected :
+        std::vector<Command>   _commands;
+        std::vector<OfxPointD> _points;
+        std::vector<char>      _text;       ///< null terminated strings of the text commands
+        OfxRGBAColourF         _colour;
+        float                  _lineWidth;
+        OfxDrawLineStipplePattern _stipple;
+        OfxRGBAColourF         _standardColours[kOfxStandardColourOverlayText + 1];
+        bool                   _drawing;
+
+        /// start a command with the current state
+        Command &addCommand(int primitive);
+
+      public :
+        Context();
+        virtual ~Context();
+
+        /// get a handle to pass to the C API
+        OfxDrawContextHandle getHandle() {return (OfxDrawContextHandle)this;}
+
+        /// clear the buffer and reset the state, called as a draw action starts
+        void begin();
+
+        /// called as a draw action ends, the suite fails outside of begin/end
+        void end() {_drawing = false;}
+
+        /// is a draw action being recorded
+        bool isDrawing() const {return _drawing;}
+
+        /// set the colour returned for a standard colour
+        void setStandardColour(OfxStandardColour which, const OfxRGBAColourF &colour);
+
+        /// the recorded commands
+        const std::vector<Command> &getCommands() const {return _commands;}
+
+        /// the points of the recorded commands
+        const std::vector<OfxPointD> &getPoints() const {return _points;}
+
+        /// the text of a text command
+        const char *getText(const Command &command) const {return &_text[command.text];}
+
+        //
+        // the draw suite
+        //
+
+        OfxStatus getColour(OfxStandardColour which, OfxRGBAColourF &colour) const;
+        OfxStatus setColour(const OfxRGBAColourF &colour);
+        OfxStatus setLineWidth(float width);
+        OfxStatus setLineStipple(OfxDrawLineStipplePattern pattern);
+        OfxStatus draw(OfxDrawPrimitive primitive, const OfxPointD *points, int nPoints);
+        OfxStatus drawText(const char *text, const OfxPointD &pos, int alignment);
+      };
+
+      /// Renders recorded draw commands into a premultiplied float RGBA buffer,
+      /// bottom row first as with OFX images.
+      ///
+      /// Shapes are scan converted with exact area coverage, each edge adding
+      /// its signed area to an accumulation buffer, a running sum along each
+      /// row then gives the coverage of every pixel. Lines are stroked as
+      /// quads, line widths are in pixels, a width of 0 being a 1 pixel line.
+      ///
+      /// Text needs a font engine, which HostSupport does not have, so hosts
+      /// that want text override renderText.
+      class Rasteriser {
+      protected :
+        int _width, _height;
+        std::vector<float> _pixels;
+        std::vector<float> _coverage;       ///< signed area accumulation, _width + 2 per row
+        std::vector<float> _span;           ///< coverage of the row being composited
+        std::vector<OfxPointD> _path;       ///< points of the command being rendered, in pixels
+        double _scaleX, _scaleY;            ///< canonical to pixel transform
+        double _offsetX, _offsetY;
+        int _minRow, _maxRow;               ///< rows touched in _coverage by the shape being built
+        std::vector<int> _minCols;          ///< per row, first column touched in _coverage by the shape being built
+        std::vector<int> _maxCols;          ///< per row, last column touched in _coverage by the shape being built
+
+        /// add an edge, in pixels, to the shape being built
+        void addEdge(double x0, double y0, double x1, double y1);
+
+        /// add a closed polygon, in pixels, to the shape being built
+        void addPolygon(const OfxPointD *points, int nPoints);
+
+        /// add the quad covering a line segment, in pixels, to the shape being built, all quads
+        /// wind the same way so where the segments of a stroke overlap the coverage saturates
+        void addSegment(const OfxPointD &a, const OfxPointD &b, double halfWidth);
+
+        /// add a stroke along a run of points, in pixels, to the shape being built
+        void addStroke(const OfxPointD *points, int nPoints, bool closed, float lineWidth, OfxDrawLineStipplePattern stipple);
+
+        /// composite the shape being built over the buffer, and clear it
+        void fillShape(const OfxRGBAColourF &colour);
+
+        /// canonical to pixel coordinates
+        OfxPointD toPixels(const OfxPointD &p) const
+        {
+          OfxPointD r = {p.x * _scaleX + _offsetX, p.y * _scaleY + _offsetY};
+          return r;
+        }
+
+      public :
+        Rasteriser(int width, int height);
+        virtual ~Rasteriser();
+
+        int getWidth() const {return _width;}
+        int getHeight() const {return _height;}
+
+        /// set the mapping from the canonical coordinates interacts draw in to pixels
+        void setTransform(double scaleX, double scaleY, double offsetX, double offsetY);
+
+        /// clear the buffer to transparent black
+        void clear();
+
+        /// render the commands recorded on a context over the buffer
+        void render(const Context &context);
+
+        /// render a text command at the given pixel position, by default draws nothing
+        virtual void renderText(const Command &command, const char *text, const OfxPointD &pos);
+
+        /// the pixels, 4 floats per pixel
+        const float *getPixels() const {return &_pixels[0];}
+
+        /// composite the buffer over a float RGBA image of the same size
+        void compositeOver(float *dst, int dstRowBytes) const;
+      };
+
+    } // namespace Draw
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_DRAW_H
@@ -0,0 +1,141 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_FRAME_PREFETCH_H
+#define OFXH_FRAME_PREFETCH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ofxCore.h"
+#include "ofxhCancelToken.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ImageEffect {
+
+      class Instance;
+      class ClipInstance;
+      class Image;
+
+      /// Fetches the input frames of a sequential render ahead of the playhead.
+      ///
+      /// A host attaches one of these to an effect instance with
+      /// Instance::setFramePrefetcher. When the effect is asked to begin a
+      /// sequential render, each render action first runs the frames needed
+      /// action for any of the frame being rendered and the next few after it
+      /// that have not already been asked about, and has background threads
+      /// fetch any input frames in that window that are not yet cached. Frames
+      /// that fall out of the window, which will be those behind the playhead,
+      /// are released. Images the plugin fetches during the render are then
+      /// handed out of the cache, waiting on a fetch still in flight rather
+      /// than making a second one.
+      ///
+      /// Frames are fetched with ClipInstance::getImage from the background
+      /// threads, with no bounds, so that must be thread safe. The fetches
+      /// are made under a CancelToken that is cancelled when the render ends.
+      class FramePrefetcher {
+      protected :
+        /// a frame of a clip
+        struct Key {
+          ClipInstance *clip;
+          OfxTime time;
+
+          bool operator<(const Key &other) const
+          {
+            return clip < other.clip || (clip == other.clip && time < other.time);
+          }
+        };
+
+        /// a cached frame
+        struct Entry {
+          Image *image;     ///< the image, which the cache holds a reference to, null if the fetch failed
+          bool fetching;    ///< is a thread fetching it
+          bool ready;       ///< has the fetch finished
+        };
+
+        Instance &_effect;
+        int _nThreads;
+        int _lookAhead;
+
+        std::atomic<bool> _active;
+        OfxTime _startFrame, _endFrame, _step;
+
+        /// the frames needed by each time in the window, so each is only asked
+        /// of the plugin once a sequence, used by the rendering thread only
+        std::map<OfxTime, std::vector<Key> > _framesNeeded;
+
+        std::mutex _mutex;
+        std::condition_variable _wake;    ///< signalled when frames are queued or the threads should stop
+        std::condition_variable _ready;   ///< signalled when a fetch finishes
+        std::map<Key, Entry> _cache;
+        std::deque<Key> _queue;           ///< frames to fetch, nearest the playhead first
+        std::vector<std::thread> _threads;
+        bool _stopping;
+        CancelToken _cancel;
+
+        std::atomic<int> _nHits;
+        std::atomic<int> _nMisses;
+
+        /// what the background threads run
+        void threadLoop();
+
+        /// fetch a frame whose entry the caller has just marked as fetching,
+        /// unlocking whilst it does, and put the image in the cache
+        void fetchEntry(std::unique_lock<std::mutex> &lock, const Key &key);
+
+        /// add the frames needed to render at the given time to the window
+        void addFramesNeeded(OfxTime time, std::vector<Key> &window);
+
+        /// fetch a frame, called from a background thread, or from the rendering
+        /// thread for a frame no background thread has started on, by default
+        /// calls ClipInstance::getImage
+        virtual Image *fetch(ClipInstance &clip, OfxTime time);
+
+      public :
+        /// the prefetcher fetches with nThreads threads, over a window of the
+        /// frames needed to render the current frame and the lookAhead after it
+        explicit FramePrefetcher(Instance &effect, int nThreads = 2, int lookAhead = 2);
+        virtual ~FramePrefetcher();
+
+        /// start prefetching, called as a render sequence begins, does nothing unless it is sequential
+        void begin(OfxTime startFrame, OfxTime endFrame, OfxTime step, bool sequential);
+
+        /// move the playhead on, called as each frame of the sequence is about to render
+        void advance(OfxTime time);
+
+        /// stop prefetching and release the cache, called as a render sequence ends
+        void end();
+
+        /// is a sequential render being prefetched for
+        bool isActive() const {return _active;}
+
+        /// Get a cached frame covering the given bounds, with a reference added
+        /// for the caller. Returns null if the frame is not in the window, in
+        /// which case the caller should fetch it itself.
+        Image *getImage(ClipInstance &clip, OfxTime time, const OfxRectD *optionalBounds);
+
+        /// number of frames in the cache, fetched or not
+        int getNumCached();
+
+        /// number of images handed out of the cache
+        int getNumHits() const {return _nHits;}
+
+        /// number of images asked for that were not in the window
+        int getNumMisses() const {return _nMisses;}
+      };
+
+    } // namespace ImageEffect
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_FRAME_PREFETCH_H
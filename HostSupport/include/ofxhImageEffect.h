@@ -15,6 +15,7 @@
 #include "ofxhParam.h"
 #include "ofxhMemory.h"
 #include "ofxhInteract.h"
+#include "ofxhActionMemo.h"
 
 #ifdef _MSC_VER
 //Use visual studio extension
@@ -39,6 +40,7 @@ namespace OFX {
       class OverlayInstance;
       class Instance;
       class Descriptor;
+      class FramePrefetcher;
 
       /// An image effect host, passed to the setHost function of all image effect plugins
       class Host : public OFX::Host::Host {
@@ -73,6 +75,11 @@ namespace OFX {
         ///   \arg reason - set this to report the reason the plugin was not loaded
         virtual bool pluginSupported(ImageEffectPlugin *plugin, std::string &reason) const;
 
+        /// Override this to return true if ClipInstance::getImage can be called
+        /// from several threads at once, in which case plugins are given the
+        /// async image fetch suite, which fetches each image on its own thread.
+        virtual bool supportsAsyncImageFetch() const;
+
         /// Override this to create a descriptor, this makes the 'root' descriptor
         virtual Descriptor *makeDescriptor(ImageEffectPlugin* plugin) = 0;
 
@@ -297,6 +304,8 @@ namespace OFX {
         std::string                                   _outputPreMultiplication;  ///< set by clip prefs
         std::string                                   _outputFielding;  ///< set by clip prefs
         double                                        _outputFrameRate; ///< set by clip prefs
+        FramePrefetcher                              *_framePrefetcher; ///< fetches inputs ahead of sequential renders, not owned
+        ActionMemo                                    _actionMemo; ///< remembered action replies
 
       public:        
         /// constructor based on clip descriptor
@@ -325,6 +334,20 @@ namespace OFX {
         /// get the descriptor for this instance
         Descriptor &getDescriptor() {return *_descriptor;}
 
+        /// set the prefetcher used during sequential renders, the instance does not own it
+        void setFramePrefetcher(FramePrefetcher *prefetcher) {_framePrefetcher = prefetcher;}
+
+        /// get the prefetcher used during sequential renders, if any
+        FramePrefetcher *getFramePrefetcher() const {return _framePrefetcher;}
+
+        /// get the remembered action replies
+        ActionMemo &getActionMemo() {return _actionMemo;}
+
+        /// Hash of what the region actions depend on from upstream, that is
+        /// the connection and region of definition of each input clip at the
+        /// given time, and the project's extent.
+        virtual unsigned long long getInputsHash(OfxTime time);
+
         /// get default output fielding. This is passed into the clip prefs action
         /// and  might be mapped (if the host allows such a thing)
         virtual const std::string &getDefaultOutputFielding() const = 0;
@@ -371,7 +394,8 @@ namespace OFX {
         /// pure virtuals that must  be overridden
         virtual ClipInstance* getClip(const std::string& name) const;
 
-        /// override this to make processing abort, return 1 to abort processing
+        /// override this to make processing abort, return 1 to abort processing, by default
+        /// reports the CancelToken installed on the calling thread
         virtual int abort();
 
         /// override this to use your own memory instance - must inherit from memory::instance
@@ -587,6 +611,19 @@ namespace OFX {
                                                     const OfxRectD &roi,
                                                     std::map<ClipInstance *, OfxRectD> &rois);
 
+        /// as getRegionOfDefinitionAction, but answered from the action memo if the
+        /// same question has been asked before with the same params and inputs
+        virtual OfxStatus getRegionOfDefinitionMemoised(OfxTime  time,
+                                                        OfxPointD   renderScale,
+                                                        OfxRectD &rod);
+
+        /// as getRegionOfInterestAction, but answered from the action memo if the
+        /// same question has been asked before with the same params and inputs
+        virtual OfxStatus getRegionOfInterestMemoised(OfxTime  time,
+                                                      OfxPointD   renderScale,
+                                                      const OfxRectD &roi,
+                                                      std::map<ClipInstance *, OfxRectD> &rois);
+
         // get frames needed to render the given frame
         virtual OfxStatus getFrameNeededAction(OfxTime time, 
                                                RangeMap &rangeMap);
@@ -598,6 +635,27 @@ namespace OFX {
                                            OfxPointD   renderScale,
                                            std::string &clip);
 
+        /// as isIdentityAction, but answered from the action memo if the same
+        /// question has been asked before with the same param values
+        virtual OfxStatus isIdentityMemoised(OfxTime     &time,
+                                             const std::string &  field,
+                                             const OfxRectI  &renderRoI,
+                                             OfxPointD   renderScale,
+                                             std::string &clip);
+
+        /// Call before rendering to see if the render can be skipped. If the
+        /// effect is an identity, this returns the image it passes through,
+        /// as a view sharing its pixels onto the render window, widened to the
+        /// host's row alignment, where that is smaller, for the host to use as the output without allocating or copying. The
+        /// caller releases the image with releaseReference. Returns NULL if
+        /// the effect needs to be rendered, which includes when the image's
+        /// pixel depth, components or pixel aspect ratio differ from the
+        /// output clip's.
+        virtual Image *getPassThroughImage(OfxTime     time,
+                                           const std::string &  field,
+                                           const OfxRectI  &renderRoI,
+                                           OfxPointD   renderScale);
+
         // time domain
         virtual OfxStatus getTimeDomainAction(OfxRangeD& range);
 
@@ -0,0 +1,132 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_IMAGE_PYRAMID_H
+#define OFXH_IMAGE_PYRAMID_H
+
+#include <atomic>
+#include <list>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "ofxCore.h"
+#include "ofxhPropertySuite.h"
+#include "ofxhClip.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ImageEffect {
+
+      /// An image made by halving the resolution of another, which owns its
+      /// pixels, laid out as Memory::Instance lays out a host's images
+      class PyramidLevel : public Image {
+      protected :
+        unsigned char *_pixels;
+
+        PyramidLevel(const PyramidLevel &);
+        PyramidLevel &operator=(const PyramidLevel &);
+
+      public :
+        /// make a level half the resolution of the source, leaving its pixels to be filled
+        PyramidLevel(const Image &source, int bytesPerPixel);
+        virtual ~PyramidLevel();
+
+        /// the pixels, rows a row bytes apart from the bottom of the bounds
+        unsigned char *getPixels() {return _pixels;}
+      };
+
+      /// Caches full resolution images and serves them at lower render scales.
+      ///
+      /// A host adds the full resolution images it has rendered with add.
+      /// When its ClipInstance::getImage is asked for an image at a render
+      /// scale of a half, a quarter and so on, it asks the pyramid first,
+      /// which hands out the matching level, building it and any levels above
+      /// it from the cached image if need be, each from the one above it. A
+      /// proxy playback then need not render the tree again at its scale.
+      ///
+      /// Levels are only made for byte, short and float pixels of RGBA, RGB
+      /// or alpha components, and only for render scales that are a power of
+      /// two below that of the cached image. The cache holds a bounded number
+      /// of frames, dropping the least recently used. Access is thread safe.
+      class ImagePyramid {
+      public :
+        /// how a level is made from the one above it
+        enum FilterEnum {
+          eFilterBox,      ///< average each 2x2 block, fast
+          eFilterLanczos   ///< a separable lanczos 2 filter, sharper and without aliasing
+        };
+
+      protected :
+        /// a frame of a clip
+        struct Key {
+          ClipInstance *clip;
+          OfxTime time;
+
+          bool operator<(const Key &other) const
+          {
+            return clip < other.clip || (clip == other.clip && time < other.time);
+          }
+        };
+
+        /// a cached frame, the full resolution image followed by the levels made from it so far,
+        /// each of which the cache holds a reference to
+        struct Entry {
+          std::vector<Image *> levels;
+          std::list<Key>::iterator use;
+        };
+
+        FilterEnum _filter;
+        size_t _maxFrames;
+
+        std::mutex _mutex;
+        std::map<Key, Entry> _cache;
+        std::list<Key> _uses;           ///< the cached frames, most recently used first
+
+        std::atomic<int> _nHits;
+        std::atomic<int> _nMisses;
+
+        /// release the images of an entry
+        static void releaseEntry(Entry &entry);
+
+        /// Make a level half the resolution of the given image. Returns NULL
+        /// if the image's pixels are not of a kind levels can be made from.
+        virtual Image *makeLevel(const Image &source);
+
+      public :
+        /// the pyramid caches up to maxFrames full resolution images
+        explicit ImagePyramid(FilterEnum filter = eFilterBox, size_t maxFrames = 16);
+        virtual ~ImagePyramid();
+
+        /// cache a full resolution image of a clip, adding a reference to it and
+        /// replacing any image cached for that frame
+        void add(ClipInstance &clip, OfxTime time, Image &image);
+
+        /// Get an image of a clip at the given render scale, covering the
+        /// given canonical bounds if they are not NULL, with a reference added
+        /// for the caller. Returns NULL if there is no cached image of the frame
+        /// the scale can be had from, in which case the caller should render it.
+        Image *getImage(ClipInstance &clip, OfxTime time, OfxPointD renderScale, const OfxRectD *optionalBounds);
+
+        /// forget the cached images of a clip, eg: when it is reconnected
+        void remove(ClipInstance &clip);
+
+        /// forget all cached images
+        void clear();
+
+        /// number of images handed out
+        int getNumHits() const {return _nHits;}
+
+        /// number of images asked for that could not be had
+        int getNumMisses() const {return _nMisses;}
+      };
+
+    } // namespace ImageEffect
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_IMAGE_PYRAMID_H
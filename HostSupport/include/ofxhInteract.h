@@ -11,6 +11,10 @@ namespace OFX {
 
   namespace Host {
 
+    namespace Draw {
+      class Context;
+    }
+
     namespace Interact {
       
       /// fetch a versioned suite for our interact
@@ -85,6 +89,7 @@ namespace OFX {
         State         _state;       ///< how is it feeling today
         void         *_effectInstance; ///< this is ugly, we need a base class to all plugin instances at some point.
         Property::Set _argProperties;
+        Draw::Context *_drawContext;   ///< records draw suite calls made in drawAction, if set
 
         /// initialise the argument properties
         void initArgProp(OfxTime time, 
@@ -113,6 +118,13 @@ namespace OFX {
         /// get prop set
         const Property::Set &getProperties() const {return _properties;}
 
+        /// set the context draw suite calls are recorded into during drawAction, null to
+        /// leave kOfxInteractPropDrawContext unset so the plugin draws with GL
+        void setDrawContext(Draw::Context *context) {_drawContext = context;}
+
+        /// get the draw context
+        Draw::Context *getDrawContext() const {return _drawContext;}
+
         /// call the entry point in the descriptor with action and the given args
         virtual OfxStatus callEntry(const char *action,
                                     Property::Set *inArgs);
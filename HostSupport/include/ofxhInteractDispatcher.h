@@ -0,0 +1,176 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_INTERACT_DISPATCHER_H
+#define OFXH_INTERACT_DISPATCHER_H
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ofxCore.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace Interact {
+
+      class Instance;
+
+      /// event-to-draw latencies gathered by a dispatcher
+      struct LatencyStats {
+        /// latencies are binned into this many buckets, of a millisecond each, the last takes any overflow
+        static const int kNumBuckets = 256;
+
+        int count;
+        double total;
+        double maximum;
+        int buckets[kNumBuckets];
+
+        LatencyStats() {reset();}
+
+        void reset();
+
+        /// add a latency in seconds
+        void add(double seconds);
+
+        /// mean latency in seconds
+        double getMean() const {return count ? total / count : 0;}
+
+        /// latency below which the given fraction of the samples fall, in seconds, to the millisecond
+        double getPercentile(double fraction) const;
+      };
+
+      /// Queues the input events for interacts and delivers them from the
+      /// host's UI loop.
+      ///
+      /// Pen motion events posted while an interact still has a motion event
+      /// queued replace that event, so a slow plugin only ever sees the latest
+      /// pen position. Draws asked for with requestRedraw are held back so
+      /// that each interact is drawn at most once per display refresh. The
+      /// time from the oldest event an interact has been sent since it was
+      /// last drawn to the end of its next draw is recorded as its latency.
+      ///
+      /// Events can be posted from any thread, process must be called from
+      /// the thread the host makes interact actions on. An interact must be
+      /// removed from the dispatcher before it is destroyed, which may be done
+      /// from within an action process is making, the interact is then sent
+      /// none of the events and draws still to come in that call.
+      class Dispatcher {
+      public :
+        /// the kinds of event that can be queued
+        enum EventType {
+          ePenMotion,
+          ePenDown,
+          ePenUp,
+          eKeyDown,
+          eKeyUp,
+          eKeyRepeat,
+          eGainFocus,
+          eLoseFocus
+        };
+
+        /// a queued event
+        struct Event {
+          EventType type;
+          Instance *interact;
+          OfxTime time;
+          OfxPointD renderScale;
+          OfxPointD penPos;
+          OfxPointI penPosViewport;
+          double pressure;
+          int key;
+          std::string keyString;
+          double posted;          ///< when the oldest event merged into this one was posted
+        };
+
+      protected :
+        /// what the dispatcher knows about an interact's drawing
+        struct DrawState {
+          bool pending;           ///< has a redraw been asked for
+          double inputAt;         ///< when the oldest event not yet followed by a draw was posted, negative if none
+          double lastDraw;        ///< when the last draw started, negative if never drawn
+          OfxTime time;           ///< time of the last event or redraw request, which draws are made at
+          OfxPointD renderScale;
+        };
+
+        std::mutex _mutex;
+        std::deque<Event> _events;
+        std::deque<Event> _delivering;    ///< the batch process is working through, removeInteract drops events from it too
+        std::map<Instance *, DrawState> _drawStates;
+        double _refreshRate;
+        LatencyStats _latency;
+        std::atomic<int> _nCoalesced;
+
+        /// queue an event, merging it into a queued pen motion if it is one
+        void post(Event &event);
+
+        /// get the draw state of an interact, making it if need be, the mutex must be held
+        DrawState &getDrawState(Instance *interact);
+
+        /// send an event to its interact
+        virtual OfxStatus deliver(Event &event);
+
+      public :
+        explicit Dispatcher(double refreshRate = 60);
+        virtual ~Dispatcher();
+
+        /// the rate, in Hz, an interact is drawn at most at
+        void setRefreshRate(double refreshRate);
+        double getRefreshRate() const {return _refreshRate;}
+
+        /// the time now, in seconds, from an arbitrary origin
+        virtual double now() const;
+
+        void postPenMotion(Instance &interact, OfxTime time, const OfxPointD &renderScale,
+                           const OfxPointD &penPos, const OfxPointI &penPosViewport, double pressure);
+        void postPenDown(Instance &interact, OfxTime time, const OfxPointD &renderScale,
+                         const OfxPointD &penPos, const OfxPointI &penPosViewport, double pressure);
+        void postPenUp(Instance &interact, OfxTime time, const OfxPointD &renderScale,
+                       const OfxPointD &penPos, const OfxPointI &penPosViewport, double pressure);
+        void postKeyDown(Instance &interact, OfxTime time, const OfxPointD &renderScale, int key, const std::string &keyString);
+        void postKeyUp(Instance &interact, OfxTime time, const OfxPointD &renderScale, int key, const std::string &keyString);
+        void postKeyRepeat(Instance &interact, OfxTime time, const OfxPointD &renderScale, int key, const std::string &keyString);
+        void postGainFocus(Instance &interact, OfxTime time, const OfxPointD &renderScale);
+        void postLoseFocus(Instance &interact, OfxTime time, const OfxPointD &renderScale);
+
+        /// ask for an interact to be drawn at the given time and render scale
+        void requestRedraw(Instance &interact, OfxTime time, const OfxPointD &renderScale);
+
+        /// ask for an interact to be drawn at the time and render scale of its last event,
+        /// meant to be called from a host's Instance::redraw
+        void requestRedraw(Instance &interact);
+
+        /// forget an interact, dropping its queued events
+        void removeInteract(Instance &interact);
+
+        /// Deliver the queued events in order, then draw the interacts that
+        /// have asked to be and whose refresh interval has passed. Returns the
+        /// seconds until the next held back draw is due, or a negative number
+        /// if there is none, so the host knows when to call again.
+        double process();
+
+        /// number of events queued
+        int getNumQueued();
+
+        /// number of pen motion events merged into one already queued
+        int getNumCoalesced() const {return _nCoalesced;}
+
+        /// the event-to-draw latencies recorded so far
+        LatencyStats getLatency();
+
+        /// clear the latencies and the coalesced count
+        void resetStats();
+      };
+
+    } // namespace Interact
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_INTERACT_DISPATCHER_H
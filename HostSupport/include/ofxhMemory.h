@@ -11,6 +11,27 @@ namespace OFX {
 
     namespace Memory {
 
+      /// Alignment in bytes of the memory an Instance allocates, a cache line,
+      /// and wide enough for the widest vector loads plugins make.
+      const int kRowAlignment = 64;
+
+      /// Critical stride in bytes. Rows a multiple of this apart fall on the
+      /// same few cache sets, and loads from one row can be mistaken for
+      /// stores to another (4K aliasing), stalling vertical filters.
+      const int kCriticalStride = 1024;
+
+      /// The row bytes to lay out an image of nPixels a row of pixelBytes each
+      /// with, so that every row starts kRowAlignment aligned in memory from an
+      /// Instance. Rows are padded to a multiple of kRowAlignment, and by one
+      /// more kRowAlignment if that makes them a multiple of kCriticalStride.
+      size_t getRowBytes(int nPixels, int pixelBytes);
+
+      /// allocate nBytes aligned to kRowAlignment, throws std::bad_alloc on failure
+      void *allocAligned(size_t nBytes);
+
+      /// free memory from allocAligned
+      void freeAligned(void *ptr);
+
       class Instance {
       public:
         Instance();
@@ -0,0 +1,197 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_NUMA_H
+#define OFXH_NUMA_H
+
+#include <stddef.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+#include "ofxMultiThread.h"
+
+#include "ofxhMemory.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    /// NUMA aware thread placement and image memory placement.
+    ///
+    /// On a machine with several memory nodes, memory is placed on the node
+    /// of the thread that first writes each page of it. A host that runs the
+    /// multithread suite on a ThreadPool and allocates image memory with a
+    /// MemoryInstance has each thread of a multiThread call run on a fixed
+    /// node, and the rows of an image placed on the node of the thread that
+    /// Support library processors will later give them to, since those split
+    /// the rows into nThreads equal bands in thread order. To do so, a host
+    /// forwards its ImageEffect::Host::multiThread and friends to a pool,
+    /// and returns a MemoryInstance on that pool from its newMemoryInstance,
+    /// telling it the row bytes of the image about to be allocated.
+    ///
+    /// The topology is read from /sys on Linux. Elsewhere the machine is
+    /// taken to be a single node, threads are not pinned, and all this
+    /// reduces to a plain thread pool and allocation.
+    namespace Numa {
+
+      /// the memory nodes of the machine and the CPUs on each
+      class Topology {
+      protected :
+        std::vector<std::vector<int> > _nodes;
+
+      public :
+        /// a single node of all the CPUs
+        Topology();
+
+        /// the machine's topology, read once
+        static const Topology &get();
+
+        /// number of nodes, at least one
+        int getNumNodes() const {return (int) _nodes.size();}
+
+        /// the CPUs of a node
+        const std::vector<int> &getCPUs(int node) const {return _nodes[node];}
+
+        /// number of CPUs over all the nodes
+        int getNumCPUs() const;
+
+        /// The node the given thread of a multiThread call runs on. Threads are
+        /// given to nodes in contiguous runs, in proportion to each node's
+        /// CPUs, so the contiguous bands of rows a call's threads process fall
+        /// node by node too.
+        int getNodeOfThread(unsigned int threadIndex, unsigned int nThreads) const;
+      };
+
+      /// pin the calling thread to the CPUs of a node, returns false if it could not be
+      bool pinThreadToNode(int node);
+
+      /// how image memory is placed across the nodes
+      enum PlacementEnum {
+        ePlacementDefault,    ///< leave it to the OS, pages go to the node of whichever thread writes them first
+        ePlacementBands,      ///< rows go to the node of the thread of a multiThread call that processes their band
+        ePlacementInterleave  ///< pages go to the nodes round robin, for memory with no one thread that uses it most
+      };
+
+      /// counters kept per node
+      struct NodeStatistics {
+        unsigned long long bytesPlaced;  ///< bytes of memory first touched on the node
+        double placeSeconds;             ///< time the node's workers spent touching them
+        unsigned long long nTasks;       ///< threads of multiThread calls run on the node
+        double busySeconds;              ///< time the node's workers spent running them
+
+        NodeStatistics() : bytesPlaced(0), placeSeconds(0), nTasks(0), busySeconds(0) {}
+
+        /// rate memory was zeroed at on the node, in bytes a second, which says
+        /// how long placing took rather than what the node's memory can do
+        double getPlaceRate() const {return placeSeconds > 0 ? bytesPlaced / placeSeconds : 0;}
+      };
+
+      /// the counters of every node
+      std::vector<NodeStatistics> getStatistics();
+
+      /// zero the counters
+      void resetStatistics();
+
+      /// write a line per node of its counters
+      void writeStatistics(std::ostream &os);
+
+      /// Runs the threads of multiThread calls on workers pinned to the
+      /// nodes, a worker per CPU, with thread i of n on the node given by
+      /// Topology::getNodeOfThread. A call from one of the pool's own threads
+      /// runs its threads one after the other on the caller.
+      class ThreadPool {
+      protected :
+        /// a multiThread call in progress
+        struct Call {
+          unsigned int nRemaining;  ///< threads of the call yet to finish
+        };
+
+        /// a thread of a multiThread call, or a node's share of a placeMemory call
+        struct Task {
+          OfxThreadFunctionV1 *func;
+          void *customArg;
+          unsigned int threadIndex;
+          unsigned int nThreads;
+          Call *call;
+          bool placing;             ///< is it placing memory, which keeps its own counters
+        };
+
+        /// the tasks waiting for each node's workers
+        struct NodeQueue {
+          std::deque<Task> tasks;
+        };
+
+        std::mutex _mutex;
+        std::condition_variable _wake;    ///< signalled when tasks are queued or the workers should stop
+        std::condition_variable _done;    ///< signalled when a call's last thread finishes
+        std::vector<NodeQueue> _queues;
+        std::vector<std::thread> _workers;
+        bool _stopping;
+
+        /// what each worker runs
+        void workerLoop(int node);
+
+      public :
+        /// start a worker for every CPU of every node
+        ThreadPool();
+
+        /// stop the workers, waiting for any calls in progress
+        virtual ~ThreadPool();
+
+        /// @see OfxMultiThreadSuiteV1.multiThread()
+        OfxStatus multiThread(OfxThreadFunctionV1 func, unsigned int nThreads, void *customArg);
+
+        /// @see OfxMultiThreadSuiteV1.multiThreadNumCPUS()
+        unsigned int getNumCPUs() const {return (unsigned int) _workers.size();}
+
+        /// @see OfxMultiThreadSuiteV1.multiThreadIndex(), 0 if the calling thread is not running a call's thread
+        static unsigned int getThreadIndex();
+
+        /// @see OfxMultiThreadSuiteV1.multiThreadIsSpawnedThread()
+        static bool isSpawnedThread();
+
+        /// Place memory, which must not have been written to yet, by zeroing
+        /// it on the workers of the nodes it should go to. For bands, rowBytes
+        /// and nThreads say how the rows will be split between threads. Memory
+        /// is left alone for ePlacementDefault, on a single node machine, or
+        /// when called from one of the pool's own threads.
+        void placeMemory(void *ptr, size_t nBytes, PlacementEnum placement, size_t rowBytes = 0, unsigned int nThreads = 0);
+      };
+
+      /// Image memory placed across the nodes by a pool's workers. Set the
+      /// placement, and for bands the row bytes and the number of threads the
+      /// image will be processed with, before alloc is called.
+      class MemoryInstance : public Memory::Instance {
+      protected :
+        ThreadPool &_pool;
+        PlacementEnum _placement;
+        size_t _rowBytes;
+        unsigned int _nThreads;
+
+      public :
+        explicit MemoryInstance(ThreadPool &pool, PlacementEnum placement = ePlacementInterleave);
+
+        /// how the memory will be placed
+        void setPlacement(PlacementEnum v) {_placement = v;}
+
+        /// the rows the memory will hold and the threads they will be split between, for bands
+        void setRows(size_t rowBytes, unsigned int nThreads) {_rowBytes = rowBytes; _nThreads = nThreads;}
+
+        /// allocate and place the memory
+        virtual bool alloc(size_t nBytes);
+      };
+
+    } // namespace Numa
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_NUMA_H
@@ -26,6 +26,9 @@ namespace OFX {
       /// fetch the param suite
       const void *GetSuite(int version);
 
+      /// fetch the param batch suite
+      const void *GetBatchSuite(int version);
+
       bool isColourParam(const std::string &paramType);
 
       bool isIntParam(const std::string &paramType);
@@ -230,6 +233,9 @@ namespace OFX {
         /// integrate a value, implemented by instances to deconstruct var args
         virtual OfxStatus integrateV(OfxTime time1, OfxTime time2, va_list arg);
 
+        /// get the values at many times into an interleaved buffer, implemented by double valued instances
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
+
         /// overridden from Property::NotifyHook
         virtual void notify(const std::string &name, bool single, int num);
       };
@@ -355,6 +361,9 @@ namespace OFX {
 
         /// implementation of var args function
         virtual OfxStatus integrateV(OfxTime time1, OfxTime time2, va_list arg);
+
+        /// implementation of the batch get, calls get(time, ...) at each time
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
       };
 
       class BooleanInstance : public Instance, public KeyframeParam {
@@ -411,6 +420,9 @@ namespace OFX {
 
         /// implementation of var args function
         virtual OfxStatus integrateV(OfxTime time1, OfxTime time2, va_list arg);
+
+        /// implementation of the batch get, calls get(time, ...) at each time
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
       };
 
       class RGBInstance : public Instance, public KeyframeParam {
@@ -444,6 +456,9 @@ namespace OFX {
 
         /// implementation of var args function
         virtual OfxStatus integrateV(OfxTime time1, OfxTime time2, va_list arg);
+
+        /// implementation of the batch get, calls get(time, ...) at each time
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
       };
         
       class Double2DInstance : public Instance, public KeyframeParam {
@@ -477,6 +492,9 @@ namespace OFX {
 
         /// implementation of var args function
         virtual OfxStatus integrateV(OfxTime time1, OfxTime time2, va_list arg);
+
+        /// implementation of the batch get, calls get(time, ...) at each time
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
       };
 
       class Integer2DInstance : public Instance, public KeyframeParam {
@@ -543,6 +561,9 @@ namespace OFX {
 
         /// implementation of var args function
         virtual OfxStatus integrateV(OfxTime time1, OfxTime time2, va_list arg);
+
+        /// implementation of the batch get, calls get(time, ...) at each time
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
       };
 
       class Integer3DInstance : public Instance, public KeyframeParam {
@@ -653,6 +674,11 @@ namespace OFX {
         /// plug-ins changing their own values.
         virtual void paramChangedByPlugin(Param::Instance *param) = 0;
 
+        /// Hash the values of all the params at the given time, so results that
+        /// depend on them can be remembered. Override this if the host has a
+        /// cheaper way of knowing its param state.
+        virtual unsigned long long getValuesHash(OfxTime time);
+
         /// add a param
         virtual OfxStatus addParam(const std::string& name, Instance* instance);
 
@@ -0,0 +1,339 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_PARAM_ANIMATION_H
+#define OFXH_PARAM_ANIMATION_H
+
+#include <atomic>
+#include <vector>
+
+#include "ofxCore.h"
+
+#include "ofxhParam.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace Param {
+
+      /// how a curve moves from one key to the next
+      enum InterpolationEnum {
+        eInterpolationConstant,   ///< hold the key value until the next key
+        eInterpolationLinear,     ///< straight line to the next key
+        eInterpolationSmooth,     ///< catmull-rom, but flattened at the ends and at local extremes so it never overshoots
+        eInterpolationCatmullRom, ///< catmull-rom through the neighbouring keys
+        eInterpolationBezier      ///< cubic with the slopes held on the key
+      };
+
+      /// a single key on a curve
+      struct Keyframe {
+        OfxTime time;
+        double value;
+        InterpolationEnum interpolation; ///< used for the segment leaving this key
+        double inSlope;                  ///< slope arriving at the key, value per frame, only used by eInterpolationBezier
+        double outSlope;                 ///< slope leaving the key, value per frame, only used by eInterpolationBezier
+      };
+
+      /// An animation curve.
+      ///
+      /// Keys are held sorted in contiguous storage, alongside the cubic for each
+      /// segment between two keys, which is rebuilt whenever the keys are edited.
+      /// Evaluation is a binary search for the segment, with the last segment
+      /// found cached to make sequential evaluation O(1), and a polynomial
+      /// evaluation. Derivatives and integrals are analytical. Before the first
+      /// and after the last key the curve holds the end key's value. A curve
+      /// with no keys has a static value.
+      ///
+      /// Edits are not thread safe with respect to evaluations, evaluations are
+      /// safe to make from several threads at once.
+      class Curve {
+      public :
+        /// the cubic a + b.u + c.u^2 + d.u^3 on a segment, with u going 0..1 across the segment
+        struct Segment {
+          double a, b, c, d;
+          double invDuration;
+        };
+
+      protected :
+        std::vector<Keyframe> _keys;
+        std::vector<Segment>  _segments;   ///< one less than there are keys
+        std::vector<double>   _integrals;  ///< integral from the first key to each key
+        double                _value;      ///< static value, used when there are no keys
+        InterpolationEnum     _defaultInterpolation;
+        mutable std::atomic<int> _lastSegment; ///< segment found by the last lookup
+
+        /// recompute the segments and integrals after an edit
+        void rebuild();
+
+        /// slopes arriving at and leaving the nth key
+        void getSlopes(int nth, double &in, double &out) const;
+
+        /// find the segment containing the time, which must be within the keys
+        int findSegment(OfxTime time) const;
+
+        /// integral from the first key to the given time, there must be keys
+        double getPrimitive(OfxTime time) const;
+
+      public :
+        explicit Curve(double value = 0, InterpolationEnum interpolation = eInterpolationSmooth);
+        Curve(const Curve &other);
+        Curve &operator=(const Curve &other);
+
+        /// is the curve animated
+        bool isAnimated() const {return !_keys.empty();}
+
+        /// set the static value, used when there are no keys
+        void setValue(double v) {_value = v;}
+
+        /// get the static value
+        double getStaticValue() const {return _value;}
+
+        /// the interpolation given to keys set without one
+        void setDefaultInterpolation(InterpolationEnum i) {_defaultInterpolation = i;}
+        InterpolationEnum getDefaultInterpolation() const {return _defaultInterpolation;}
+
+        /// set a key, replacing any key at the same time
+        void setKey(OfxTime time, double value);
+
+        /// set a key with explicit interpolation and slopes
+        void setKey(const Keyframe &key);
+
+        /// the keys, sorted on time
+        const std::vector<Keyframe> &getKeys() const {return _keys;}
+
+        /// the value at the given time
+        double getValue(OfxTime time) const;
+
+        /// the values at an array of times, written to values[i * stride]
+        void getValues(const OfxTime *times, int nTimes, double *values, int stride = 1) const;
+
+        /// the derivative at the given time
+        double getDerivative(OfxTime time) const;
+
+        /// the integral between the two times
+        double getIntegral(OfxTime time1, OfxTime time2) const;
+
+        //
+        // KeyframeParam API
+        //
+
+        unsigned int getNumKeys() const {return (unsigned int)_keys.size();}
+        OfxStatus getKeyTime(int nth, OfxTime &time) const;
+        OfxStatus getKeyIndex(OfxTime time, int direction, int &index) const;
+        OfxStatus deleteKey(OfxTime time);
+        OfxStatus deleteAllKeys();
+      };
+
+      /// return the time a param instance is currently at, used when setting an animated param without a time
+      OfxTime GetCurrentTime(Instance &param);
+
+      /// Implements the KeyframeParam API and holds one curve per dimension for
+      /// one of the typed param instances. The curves are keyed together.
+      template <class BASE>
+      class AnimatedInstance : public BASE {
+      protected :
+        std::vector<Curve> _curves;
+
+        /// set the nth dimension at the current time, keying it if the param is animated
+        void setCurrent(int n, double v)
+        {
+          if(_curves[n].isAnimated())
+            _curves[n].setKey(GetCurrentTime(*this), v);
+          else
+            _curves[n].setValue(v);
+        }
+
+        /// evaluate all the curves at the given times into an interleaved buffer
+        OfxStatus getCurveValues(const OfxTime *times, int nTimes, double *values) const
+        {
+          int nDims = (int)_curves.size();
+          for(int i = 0; i < nDims; ++i)
+            _curves[i].getValues(times, nTimes, values + i, nDims);
+          return kOfxStatOK;
+        }
+
+      public :
+        AnimatedInstance(Descriptor &descriptor, SetInstance *instance, int nDims, InterpolationEnum interpolation)
+          : BASE(descriptor, instance)
+          , _curves(nDims, Curve(0, interpolation))
+        {
+          // start off at the default
+          const Property::Set &props = descriptor.getProperties();
+          if(props.fetchDoubleProperty(kOfxParamPropDefault)) {
+            for(int i = 0; i < nDims; ++i)
+              _curves[i].setValue(props.getDoubleProperty(kOfxParamPropDefault, i));
+          }
+          else if(props.fetchIntProperty(kOfxParamPropDefault)) {
+            for(int i = 0; i < nDims; ++i)
+              _curves[i].setValue(props.getIntProperty(kOfxParamPropDefault, i));
+          }
+        }
+
+        /// get the curve for the nth dimension
+        Curve &getCurve(int n) {return _curves[n];}
+        const Curve &getCurve(int n) const {return _curves[n];}
+
+        virtual OfxStatus getNumKeys(unsigned int &nKeys) const
+        {
+          nKeys = _curves[0].getNumKeys();
+          return kOfxStatOK;
+        }
+
+        virtual OfxStatus getKeyTime(int nth, OfxTime &time) const
+        {
+          return _curves[0].getKeyTime(nth, time);
+        }
+
+        virtual OfxStatus getKeyIndex(OfxTime time, int direction, int &index) const
+        {
+          return _curves[0].getKeyIndex(time, direction, index);
+        }
+
+        virtual OfxStatus deleteKey(OfxTime time)
+        {
+          OfxStatus stat = kOfxStatOK;
+          for(size_t i = 0; i < _curves.size(); ++i) {
+            OfxStatus s = _curves[i].deleteKey(time);
+            if(s != kOfxStatOK)
+              stat = s;
+          }
+          return stat;
+        }
+
+        virtual OfxStatus deleteAllKeys()
+        {
+          for(size_t i = 0; i < _curves.size(); ++i)
+            _curves[i].deleteAllKeys();
+          return kOfxStatOK;
+        }
+      };
+
+      /// integer param that animates
+      class AnimatedIntegerInstance : public AnimatedInstance<IntegerInstance> {
+      public :
+        AnimatedIntegerInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(int &);
+        virtual OfxStatus get(OfxTime time, int &);
+        virtual OfxStatus set(int);
+        virtual OfxStatus set(OfxTime time, int);
+        virtual OfxStatus derive(OfxTime time, int &);
+        virtual OfxStatus integrate(OfxTime time1, OfxTime time2, int &);
+      };
+
+      /// choice param that animates, always with constant interpolation
+      class AnimatedChoiceInstance : public AnimatedInstance<ChoiceInstance> {
+      public :
+        AnimatedChoiceInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(int &);
+        virtual OfxStatus get(OfxTime time, int &);
+        virtual OfxStatus set(int);
+        virtual OfxStatus set(OfxTime time, int);
+      };
+
+      /// boolean param that animates, always with constant interpolation
+      class AnimatedBooleanInstance : public AnimatedInstance<BooleanInstance> {
+      public :
+        AnimatedBooleanInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(bool &);
+        virtual OfxStatus get(OfxTime time, bool &);
+        virtual OfxStatus set(bool);
+        virtual OfxStatus set(OfxTime time, bool);
+      };
+
+      /// double param that animates
+      class AnimatedDoubleInstance : public AnimatedInstance<DoubleInstance> {
+      public :
+        AnimatedDoubleInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(double &);
+        virtual OfxStatus get(OfxTime time, double &);
+        virtual OfxStatus set(double);
+        virtual OfxStatus set(OfxTime time, double);
+        virtual OfxStatus derive(OfxTime time, double &);
+        virtual OfxStatus integrate(OfxTime time1, OfxTime time2, double &);
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
+      };
+
+      /// 2D double param that animates
+      class AnimatedDouble2DInstance : public AnimatedInstance<Double2DInstance> {
+      public :
+        AnimatedDouble2DInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(double &, double &);
+        virtual OfxStatus get(OfxTime time, double &, double &);
+        virtual OfxStatus set(double, double);
+        virtual OfxStatus set(OfxTime time, double, double);
+        virtual OfxStatus derive(OfxTime time, double &, double &);
+        virtual OfxStatus integrate(OfxTime time1, OfxTime time2, double &, double &);
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
+      };
+
+      /// 2D integer param that animates
+      class AnimatedInteger2DInstance : public AnimatedInstance<Integer2DInstance> {
+      public :
+        AnimatedInteger2DInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(int &, int &);
+        virtual OfxStatus get(OfxTime time, int &, int &);
+        virtual OfxStatus set(int, int);
+        virtual OfxStatus set(OfxTime time, int, int);
+        virtual OfxStatus derive(OfxTime time, int &, int &);
+        virtual OfxStatus integrate(OfxTime time1, OfxTime time2, int &, int &);
+      };
+
+      /// 3D double param that animates
+      class AnimatedDouble3DInstance : public AnimatedInstance<Double3DInstance> {
+      public :
+        AnimatedDouble3DInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(double &, double &, double &);
+        virtual OfxStatus get(OfxTime time, double &, double &, double &);
+        virtual OfxStatus set(double, double, double);
+        virtual OfxStatus set(OfxTime time, double, double, double);
+        virtual OfxStatus derive(OfxTime time, double &, double &, double &);
+        virtual OfxStatus integrate(OfxTime time1, OfxTime time2, double &, double &, double &);
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
+      };
+
+      /// 3D integer param that animates
+      class AnimatedInteger3DInstance : public AnimatedInstance<Integer3DInstance> {
+      public :
+        AnimatedInteger3DInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(int &, int &, int &);
+        virtual OfxStatus get(OfxTime time, int &, int &, int &);
+        virtual OfxStatus set(int, int, int);
+        virtual OfxStatus set(OfxTime time, int, int, int);
+        virtual OfxStatus derive(OfxTime time, int &, int &, int &);
+        virtual OfxStatus integrate(OfxTime time1, OfxTime time2, int &, int &, int &);
+      };
+
+      /// RGB param that animates
+      class AnimatedRGBInstance : public AnimatedInstance<RGBInstance> {
+      public :
+        AnimatedRGBInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(double &, double &, double &);
+        virtual OfxStatus get(OfxTime time, double &, double &, double &);
+        virtual OfxStatus set(double, double, double);
+        virtual OfxStatus set(OfxTime time, double, double, double);
+        virtual OfxStatus derive(OfxTime time, double &, double &, double &);
+        virtual OfxStatus integrate(OfxTime time1, OfxTime time2, double &, double &, double &);
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
+      };
+
+      /// RGBA param that animates
+      class AnimatedRGBAInstance : public AnimatedInstance<RGBAInstance> {
+      public :
+        AnimatedRGBAInstance(Descriptor &descriptor, SetInstance *instance = 0);
+        virtual OfxStatus get(double &, double &, double &, double &);
+        virtual OfxStatus get(OfxTime time, double &, double &, double &, double &);
+        virtual OfxStatus set(double, double, double, double);
+        virtual OfxStatus set(OfxTime time, double, double, double, double);
+        virtual OfxStatus derive(OfxTime time, double &, double &, double &, double &);
+        virtual OfxStatus integrate(OfxTime time1, OfxTime time2, double &, double &, double &, double &);
+        virtual OfxStatus getValuesAtTimes(const OfxTime *times, int nTimes, double *values);
+      };
+
+    } // namespace Param
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_PARAM_ANIMATION_H
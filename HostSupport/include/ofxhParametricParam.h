@@ -0,0 +1,138 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_PARAMETRIC_PARAM_H
+#define OFXH_PARAMETRIC_PARAM_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "ofxCore.h"
+#include "ofxParametricParam.h"
+
+#include "ofxhParam.h"
+#include "ofxhParamAnimation.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ParametricParam {
+
+      /// number of intervals in the lookup table of a curve
+      static const int kLUTSize = 1024;
+
+      /// The control points of one curve of a parametric param.
+      ///
+      /// The control points are held as keys on a Param::Curve, keyed on their
+      /// parametric position, and are joined by its smooth interpolation.
+      /// Over the parametric range the curve is evaluated from a densely
+      /// sampled lookup table, built on the first evaluation after an edit,
+      /// outside the range it is evaluated directly.
+      ///
+      /// Edits are not thread safe with respect to evaluations, evaluations are
+      /// safe to make from several threads at once.
+      class ControlPointCurve {
+      protected :
+        Param::Curve _curve;
+        double _min, _max;                      ///< parametric range the table covers
+        mutable std::vector<double> _lut;       ///< kLUTSize + 1 samples across the range
+        mutable std::atomic<bool> _lutValid;
+        mutable std::mutex _lutMutex;
+
+        /// sample the curve into the table
+        void buildLUT() const;
+
+        /// the table is out of date
+        void invalidate() {_lutValid.store(false, std::memory_order_release);}
+
+      public :
+        ControlPointCurve();
+        ControlPointCurve(const ControlPointCurve &other);
+        ControlPointCurve &operator=(const ControlPointCurve &other);
+
+        /// set the parametric range covered by the table
+        void setRange(double min, double max);
+
+        /// number of control points
+        int getNControlPoints() const {return (int)_curve.getNumKeys();}
+
+        /// get the nth control point
+        OfxStatus getNthControlPoint(int nth, double &key, double &value) const;
+
+        /// move the nth control point, which may change its order
+        OfxStatus setNthControlPoint(int nth, double key, double value);
+
+        /// add a control point, replacing any at the same key
+        OfxStatus addControlPoint(double key, double value);
+
+        /// delete the nth control point
+        OfxStatus deleteControlPoint(int nth);
+
+        /// delete all the control points
+        void deleteAllControlPoints();
+
+        /// the value at the given parametric position, from the table when within range
+        double getValue(double position) const;
+
+        /// the value at the given parametric position, evaluated from the control points
+        double evaluate(double position) const {return _curve.getValue(position);}
+      };
+
+      /// the descriptor of a parametric param, which holds the default control points set in describe
+      class ParametricDescriptor : public Param::Descriptor {
+      protected :
+        std::vector<ControlPointCurve> _curves;
+
+      public :
+        ParametricDescriptor(const std::string &type, const std::string &name);
+
+        /// the default control points of a curve, null if the index is out of range
+        ControlPointCurve *getCurve(int curveIndex);
+      };
+
+      /// A parametric param instance.
+      ///
+      /// The default implementations hold the control points themselves, and
+      /// ignore time, as kOfxParamHostPropSupportsParametricAnimation is off.
+      /// Hosts can override the virtuals to animate the curves or keep them
+      /// elsewhere.
+      class ParametricInstance : public Param::Instance {
+      protected :
+        std::vector<ControlPointCurve> _curves;
+
+        /// the curve at the given index, null if the index is out of range
+        ControlPointCurve *getCurve(int curveIndex);
+
+        /// copy the parametric range property onto the curves
+        void updateRange();
+
+      public :
+        ParametricInstance(Param::Descriptor &descriptor, Param::SetInstance *instance = 0);
+
+        /// overridden from Param::Instance
+        virtual OfxStatus copyFrom(const Param::Instance &instance, OfxTime offset, const OfxRangeD *range);
+
+        /// overridden from Param::Instance
+        virtual void notify(const std::string &name, bool single, int num);
+
+        virtual OfxStatus getValue(int curveIndex, OfxTime time, double parametricPosition, double *returnValue);
+        virtual OfxStatus getNControlPoints(int curveIndex, double time, int *returnValue);
+        virtual OfxStatus getNthControlPoint(int curveIndex, double time, int nthCtl, double *key, double *value);
+        virtual OfxStatus setNthControlPoint(int curveIndex, double time, int nthCtl, double key, double value, bool addAnimationKey);
+        virtual OfxStatus addControlPoint(int curveIndex, double time, double key, double value, bool addAnimationKey);
+        virtual OfxStatus deleteControlPoint(int curveIndex, int nthCtl);
+        virtual OfxStatus deleteAllControlPoints(int curveIndex);
+      };
+
+      /// fetch the parametric param suite
+      const void *GetSuite(int version);
+
+    } // namespace ParametricParam
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_PARAMETRIC_PARAM_H
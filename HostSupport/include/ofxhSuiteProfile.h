@@ -0,0 +1,184 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef OFXH_SUITE_PROFILE_H
+#define OFXH_SUITE_PROFILE_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace OFX {
+
+  namespace Host {
+
+    /// Counting of the suite calls plugins make, to find the calls that are
+    /// worth hoisting out of their inner loops.
+    ///
+    /// A host turns profiling on by pointing gProfiler at a profiler. The
+    /// property, param, image effect and memory suites then count every call
+    /// made to them and the time it took, put down to the plugin and action
+    /// it was made from, by suite function and, for the property suite, by
+    /// property name. Calls made from the threads of the multi thread suite
+    /// are put down to the action that started them. Calls made outside of
+    /// any action, say from a plugin's own threads, are put down to an action
+    /// with an empty name and plugin.
+    ///
+    /// Each thread counts into a table of its own, so profiling does not make
+    /// render threads contend with each other. The tables are merged when a
+    /// report is made.
+    namespace SuiteProfile {
+
+      class Profiler;
+
+      /// a number of calls and the time they took
+      struct Counter {
+        unsigned long long calls;
+        double seconds;
+
+        Counter() : calls(0), seconds(0) {}
+
+        void add(double s) {++calls; seconds += s;}
+        void add(const Counter &c) {calls += c.calls; seconds += c.seconds;}
+      };
+
+      /// an action of a plugin that calls are put down to, made by the profiler
+      struct Action {
+        Profiler *profiler;
+        std::string pluginId;
+        std::string name;
+      };
+
+      /// what was counted over every call of an action of a plugin
+      struct ActionProfile {
+        std::string pluginId;
+        std::string action;
+        Counter actions;                            ///< the calls of the action itself
+        std::map<std::string, Counter> functions;   ///< suite calls made from it, by suite function
+        std::map<std::string, Counter> properties;  ///< property suite calls made from it, by property name
+      };
+
+      /// Counts suite calls. All functions are thread safe.
+      class Profiler {
+      protected :
+        struct ThreadTable;
+
+        const unsigned long long _id;   ///< tells the tables threads keep for this profiler from those of one gone before
+        mutable std::mutex _mutex;
+        std::map<std::pair<std::string, std::string>, std::unique_ptr<Action> > _actions;
+        std::vector<std::unique_ptr<ThreadTable> > _tables;
+        Action *_unattributed;
+
+        /// the calling thread's table, made on its first call
+        ThreadTable &getThreadTable();
+
+      public :
+        Profiler();
+        virtual ~Profiler();
+
+        /// the action of a plugin, made on first use
+        Action *getAction(const std::string &pluginId, const char *action);
+
+        /// the action calls made outside of any are put down to
+        Action *getUnattributed() const {return _unattributed;}
+
+        /// count a call of an action
+        void recordAction(const Action *action, double seconds);
+
+        /// count a suite call made from an action, property is null for calls not to the property suite
+        void recordCall(const Action *action, const char *function, const char *property, double seconds);
+
+        /// zero all the counts
+        void reset();
+
+        /// the counts so far, in order of plugin then action
+        std::vector<ActionProfile> getProfiles() const;
+
+        /// Write the counts as JSON, an object with a "plugins" array, each
+        /// entry of which has the plugin's "id" and an "actions" array, each
+        /// entry of which has the action's "name", "calls" and "seconds" and
+        /// "functions" and "properties" objects mapping names to objects with
+        /// "calls" and "seconds".
+        void writeJSON(std::ostream &os) const;
+
+        /// write a table per plugin of the properties and suite functions called most
+        void report(std::ostream &os, int maxRows = 10) const;
+      };
+
+      /// the global profiler, null unless the host is profiling
+      extern Profiler *gProfiler;
+
+      /// the action calls on the calling thread are put down to, if any
+      Action *getCurrentAction();
+
+      /// Puts calls on the calling thread down to an action of a plugin for
+      /// its lifetime, and counts the action itself, restoring the previous
+      /// action after. Does nothing unless profiling.
+      class ActionScope {
+        Action *_previous;
+        Action *_action;
+        std::chrono::steady_clock::time_point _start;
+
+        ActionScope(const ActionScope &);
+        ActionScope &operator=(const ActionScope &);
+
+      public :
+        ActionScope(const std::string &pluginId, const char *action);
+        ~ActionScope();
+      };
+
+      /// Puts calls on the calling thread down to an action already being
+      /// counted elsewhere, for the threads of the multi thread suite.
+      class ThreadScope {
+        Action *_previous;
+
+        ThreadScope(const ThreadScope &);
+        ThreadScope &operator=(const ThreadScope &);
+
+      public :
+        explicit ThreadScope(Action *action);
+        ~ThreadScope();
+      };
+
+      /// Counts a suite call for its lifetime, put at the top of a suite
+      /// function. Costs a test of gProfiler unless profiling.
+      class Call {
+        Profiler *_profiler;
+        const char *_function;
+        const char *_property;
+        std::chrono::steady_clock::time_point _start;
+
+        Call(const Call &);
+        Call &operator=(const Call &);
+
+      public :
+        explicit Call(const char *function, const char *property = 0)
+          : _profiler(gProfiler)
+          , _function(function)
+          , _property(property)
+        {
+          if(_profiler)
+            _start = std::chrono::steady_clock::now();
+        }
+
+        ~Call()
+        {
+          if(_profiler)
+            finish();
+        }
+
+        /// count the call
+        void finish();
+      };
+
+    } // namespace SuiteProfile
+
+  } // namespace Host
+
+} // namespace OFX
+
+#endif // OFXH_SUITE_PROFILE_H
@@ -110,6 +110,25 @@ namespace OFX {
     return r;
   }
 
+  /// the starting value of a hash made with HashBytes
+  static const unsigned long long kHashInit = 14695981039346656037ULL;
+
+  /// fold some bytes into an FNV-1a hash
+  inline void HashBytes(unsigned long long &hash, const void *data, size_t n)
+  {
+    const unsigned char *bytes = (const unsigned char *) data;
+    for(size_t i = 0; i < n; ++i) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+  }
+
+  /// fold a value into an FNV-1a hash
+  template<class T> inline void HashValue(unsigned long long &hash, const T &value)
+  {
+    HashBytes(hash, &value, sizeof(T));
+  }
+
     inline const char* StatStr(OfxStatus stat) {
         switch(stat) {
             case kOfxStatOK:
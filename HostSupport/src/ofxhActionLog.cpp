@@ -0,0 +1,787 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <string.h>
+#include <math.h>
+
+#include <chrono>
+#include <iomanip>
+
+// ofx
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+#include "ofxParam.h"
+
+// ofx host
+#include "ofxhBinary.h"
+#include "ofxhPropertySuite.h"
+#include "ofxhClip.h"
+#include "ofxhParam.h"
+#include "ofxhImageEffect.h"
+#include "ofxhPluginAPICache.h"
+#include "ofxhPluginCache.h"
+#include "ofxhImageEffectAPI.h"
+#include "ofxhActionLog.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ActionLog {
+
+      Recorder *gRecorder = 0;
+
+      typedef std::chrono::steady_clock Clock;
+
+      /// an action in flight on a thread
+      struct OpenAction {
+        unsigned long long serial;
+        Clock::time_point start;
+      };
+
+      /// the actions the current thread is inside, innermost last
+      static thread_local std::vector<OpenAction> tOpenActions;
+
+      /// bytes in a single component of the given depth, 0 if unknown
+      static int BytesPerComponent(const std::string &depth)
+      {
+        if(depth == kOfxBitDepthByte)  return 1;
+        if(depth == kOfxBitDepthShort) return 2;
+        if(depth == kOfxBitDepthHalf)  return 2;
+        if(depth == kOfxBitDepthFloat) return 4;
+        return 0;
+      }
+
+      /// number of components in the given components string, 0 if unknown
+      static int NumComponents(const std::string &components)
+      {
+        if(components == kOfxImageComponentRGBA)  return 4;
+        if(components == kOfxImageComponentRGB)   return 3;
+        if(components == kOfxImageComponentAlpha) return 1;
+        return 0;
+      }
+
+      /// bytes in a pixel, falls back to the row bytes if we don't know the components or depth
+      static int BytesPerPixel(const std::string &components, const std::string &depth, const OfxRectI &bounds, int rowBytes)
+      {
+        int n = NumComponents(components) * BytesPerComponent(depth);
+        if(n == 0 && bounds.x2 > bounds.x1)
+          n = abs(rowBytes) / (bounds.x2 - bounds.x1);
+        return n;
+      }
+
+      unsigned long long ChecksumImage(const ImageEffect::Image &image)
+      {
+        const unsigned char *data = (const unsigned char *) image.getPointerProperty(kOfxImagePropData);
+        OfxRectI bounds = image.getBounds();
+        int rowBytes = image.getIntProperty(kOfxImagePropRowBytes);
+        int pixelBytes = BytesPerPixel(image.getStringProperty(kOfxImageEffectPropComponents),
+                                       image.getStringProperty(kOfxImageEffectPropPixelDepth),
+                                       bounds, rowBytes);
+
+        unsigned long long h = 0xcbf29ce484222325ULL;
+        if(!data || pixelBytes <= 0)
+          return h;
+
+        const unsigned long long prime = 0x100000001b3ULL;
+        size_t lineBytes = size_t(bounds.x2 - bounds.x1) * pixelBytes;
+        for(int y = bounds.y1; y < bounds.y2; ++y) {
+          const unsigned char *row = data + (ptrdiff_t)(y - bounds.y1) * rowBytes;
+          size_t i = 0;
+          // a word at a time, then the tail a byte at a time
+          for(; i + 8 <= lineBytes; i += 8) {
+            unsigned long long w;
+            memcpy(&w, row + i, 8);
+            h = (h ^ w) * prime;
+            h ^= h >> 29;
+          }
+          for(; i < lineBytes; ++i)
+            h = (h ^ row[i]) * prime;
+        }
+        return h;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // Recorder
+
+      Recorder::Recorder()
+        : _fp(0)
+        , _nextSerial(1)
+        , _lastSerial(0)
+        , _checksumImages(true)
+      {
+      }
+
+      Recorder::~Recorder()
+      {
+        close();
+      }
+
+      bool Recorder::open(const std::string &filename)
+      {
+        std::lock_guard<std::mutex> guard(_mutex);
+        if(_fp)
+          fclose(_fp);
+        _instances.clear();
+        _fp = fopen(filename.c_str(), "wb");
+        if(!_fp)
+          return false;
+        _buffer.clear();
+        putVarint(kMagic);
+        putVarint(kVersion);
+        flushRecord();
+        return true;
+      }
+
+      void Recorder::close()
+      {
+        std::lock_guard<std::mutex> guard(_mutex);
+        if(_fp)
+          fclose(_fp);
+        _fp = 0;
+      }
+
+      void Recorder::putByte(unsigned char v)
+      {
+        _buffer.push_back(v);
+      }
+
+      void Recorder::putVarint(unsigned long long v)
+      {
+        while(v >= 0x80) {
+          _buffer.push_back((unsigned char)(v | 0x80));
+          v >>= 7;
+        }
+        _buffer.push_back((unsigned char)v);
+      }
+
+      void Recorder::putInt(int v)
+      {
+        // zig zag so small negative numbers stay small
+        putVarint(((unsigned long long)(long long)v << 1) ^ (unsigned long long)((long long)v >> 63));
+      }
+
+      void Recorder::putDouble(double v)
+      {
+        unsigned long long bits;
+        memcpy(&bits, &v, 8);
+        for(int i = 0; i < 8; ++i)
+          _buffer.push_back((unsigned char)(bits >> (8 * i)));
+      }
+
+      void Recorder::putString(const std::string &s)
+      {
+        putVarint(s.size());
+        _buffer.insert(_buffer.end(), s.begin(), s.end());
+      }
+
+      void Recorder::putProperties(const Property::Set &set, bool withValues)
+      {
+        const Property::PropertyMap &props = set.getProperties();
+        putVarint(props.size());
+        for(Property::PropertyMap::const_iterator i = props.begin(); i != props.end(); ++i) {
+          Property::Property *prop = i->second;
+          putString(i->first);
+          putByte((unsigned char)prop->getType());
+          putVarint(prop->getFixedDimension());
+
+          int n = withValues ? prop->getDimension() : 0;
+          if(prop->getType() == Property::ePointer)
+            n = 0; // pointers mean nothing in another process
+          putVarint(n);
+
+          switch(prop->getType()) {
+          case Property::eInt :
+            for(int j = 0; j < n; ++j)
+              putInt(static_cast<Property::Int *>(prop)->getValue(j));
+            break;
+          case Property::eDouble :
+            for(int j = 0; j < n; ++j)
+              putDouble(static_cast<Property::Double *>(prop)->getValue(j));
+            break;
+          case Property::eString :
+            for(int j = 0; j < n; ++j)
+              putString(static_cast<Property::String *>(prop)->getValue(j));
+            break;
+          default :
+            break;
+          }
+        }
+      }
+
+      void Recorder::flushRecord()
+      {
+        if(_fp && !_buffer.empty())
+          fwrite(&_buffer[0], 1, _buffer.size(), _fp);
+        _buffer.clear();
+      }
+
+      unsigned long long Recorder::currentSerial() const
+      {
+        if(!tOpenActions.empty())
+          return tOpenActions.back().serial;
+        // a thread spawned by multiThread, attribute it to the last action started
+        return _lastSerial;
+      }
+
+      unsigned long long Recorder::beginAction(ImageEffect::Instance &instance,
+                                               const char *action,
+                                               const Property::Set *inArgs,
+                                               const Property::Set *outArgs)
+      {
+        std::lock_guard<std::mutex> guard(_mutex);
+        if(!_fp)
+          return 0;
+
+        const void *id = instance.getHandle();
+        if(_instances.find(id) == _instances.end()) {
+          _instances.insert(id);
+          ImageEffect::ImageEffectPlugin *plugin = instance.getPlugin();
+          putByte(eRecordInstance);
+          putVarint((unsigned long long)(size_t)id);
+          putString(plugin ? plugin->getIdentifier() : std::string());
+          putVarint(plugin ? plugin->getVersionMajor() : 0);
+          putVarint(plugin ? plugin->getVersionMinor() : 0);
+          putString(instance.getContext());
+          flushRecord();
+        }
+
+        unsigned long long serial = _nextSerial++;
+        _lastSerial = serial;
+
+        putByte(eRecordAction);
+        putVarint(serial);
+        putVarint((unsigned long long)(size_t)id);
+        putString(action);
+        putByte((inArgs ? 1 : 0) | (outArgs ? 2 : 0));
+        if(inArgs)
+          putProperties(*inArgs, true);
+        if(outArgs)
+          putProperties(*outArgs, false);
+        flushRecord();
+
+        OpenAction open = {serial, Clock::now()};
+        tOpenActions.push_back(open);
+        return serial;
+      }
+
+      void Recorder::endAction(unsigned long long serial, OfxStatus stat)
+      {
+        Clock::time_point end = Clock::now();
+        double seconds = 0;
+        while(!tOpenActions.empty()) {
+          OpenAction open = tOpenActions.back();
+          tOpenActions.pop_back();
+          if(open.serial == serial) {
+            seconds = std::chrono::duration<double>(end - open.start).count();
+            break;
+          }
+        }
+
+        std::lock_guard<std::mutex> guard(_mutex);
+        if(!_fp || serial == 0)
+          return;
+        putByte(eRecordActionEnd);
+        putVarint(serial);
+        putInt(stat);
+        putDouble(seconds);
+        flushRecord();
+      }
+
+      void Recorder::recordParamValue(Param::Instance &param, bool atTime, OfxTime time, va_list ap)
+      {
+        const std::string &type = param.getType();
+        std::vector<double> values;
+        std::string stringValue;
+
+        int nInts = 0, nDoubles = 0;
+        if(type == kOfxParamTypeInteger || type == kOfxParamTypeChoice || type == kOfxParamTypeBoolean)
+          nInts = 1;
+        else if(type == kOfxParamTypeInteger2D)
+          nInts = 2;
+        else if(type == kOfxParamTypeInteger3D)
+          nInts = 3;
+        else if(type == kOfxParamTypeDouble)
+          nDoubles = 1;
+        else if(type == kOfxParamTypeDouble2D)
+          nDoubles = 2;
+        else if(type == kOfxParamTypeDouble3D || type == kOfxParamTypeRGB)
+          nDoubles = 3;
+        else if(type == kOfxParamTypeRGBA)
+          nDoubles = 4;
+        else if(type == kOfxParamTypeString || type == kOfxParamTypeCustom || type == kOfxParamTypeStrChoice) {
+          const char **value = va_arg(ap, const char **);
+          if(value && *value)
+            stringValue = *value;
+        }
+        else
+          return;
+
+        for(int i = 0; i < nInts; ++i) {
+          int *value = va_arg(ap, int *);
+          values.push_back(value ? *value : 0);
+        }
+        for(int i = 0; i < nDoubles; ++i) {
+          double *value = va_arg(ap, double *);
+          values.push_back(value ? *value : 0);
+        }
+
+        std::lock_guard<std::mutex> guard(_mutex);
+        if(!_fp)
+          return;
+        putByte(eRecordParamValue);
+        putVarint(currentSerial());
+        putString(param.getName());
+        putString(type);
+        putByte(atTime ? 1 : 0);
+        putDouble(time);
+        putVarint(values.size());
+        for(size_t i = 0; i < values.size(); ++i)
+          putDouble(values[i]);
+        putString(stringValue);
+        flushRecord();
+      }
+
+      void Recorder::recordImage(ImageEffect::ClipInstance &clip, OfxTime time, const ImageEffect::Image &image)
+      {
+        // checksum outside the lock, it is the expensive bit
+        unsigned long long checksum = _checksumImages ? ChecksumImage(image) : 0;
+        OfxRectI bounds = image.getBounds();
+
+        std::lock_guard<std::mutex> guard(_mutex);
+        if(!_fp)
+          return;
+        putByte(eRecordImage);
+        putVarint(currentSerial());
+        putString(clip.getName());
+        putDouble(time);
+        putInt(bounds.x1);
+        putInt(bounds.y1);
+        putInt(bounds.x2);
+        putInt(bounds.y2);
+        putInt(image.getIntProperty(kOfxImagePropRowBytes));
+        putString(image.getStringProperty(kOfxImageEffectPropComponents));
+        putString(image.getStringProperty(kOfxImageEffectPropPixelDepth));
+        putVarint(checksum);
+        flushRecord();
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // Replayer
+
+      /// cursor over a log loaded into memory
+      class Reader {
+        const std::vector<unsigned char> &_data;
+        size_t _pos;
+        bool _ok;
+
+      public :
+        explicit Reader(const std::vector<unsigned char> &data) : _data(data), _pos(0), _ok(true) {}
+
+        bool ok() const {return _ok;}
+        bool atEnd() const {return _pos >= _data.size();}
+
+        unsigned char getByte()
+        {
+          if(_pos >= _data.size()) {
+            _ok = false;
+            return 0;
+          }
+          return _data[_pos++];
+        }
+
+        unsigned long long getVarint()
+        {
+          unsigned long long v = 0;
+          for(int shift = 0; shift < 64; shift += 7) {
+            unsigned char b = getByte();
+            v |= (unsigned long long)(b & 0x7f) << shift;
+            if(!(b & 0x80) || !_ok)
+              return v;
+          }
+          _ok = false;
+          return v;
+        }
+
+        int getInt()
+        {
+          unsigned long long v = getVarint();
+          return (int)(long long)((v >> 1) ^ (~(v & 1) + 1));
+        }
+
+        double getDouble()
+        {
+          unsigned long long bits = 0;
+          for(int i = 0; i < 8; ++i)
+            bits |= (unsigned long long)getByte() << (8 * i);
+          double v;
+          memcpy(&v, &bits, 8);
+          return v;
+        }
+
+        std::string getString()
+        {
+          unsigned long long n = getVarint();
+          if(!_ok || n > _data.size() - _pos) {
+            _ok = false;
+            return std::string();
+          }
+          std::string s((const char *)&_data[_pos], (size_t)n);
+          _pos += (size_t)n;
+          return s;
+        }
+
+        void getProperties(std::vector<PropertyRecord> &props)
+        {
+          unsigned long long n = getVarint();
+          for(unsigned long long i = 0; i < n && _ok; ++i) {
+            PropertyRecord p;
+            p.name = getString();
+            p.type = (Property::TypeEnum)getByte();
+            p.dimension = (int)getVarint();
+            unsigned long long count = getVarint();
+            for(unsigned long long j = 0; j < count && _ok; ++j) {
+              switch(p.type) {
+              case Property::eInt :    p.intValues.push_back(getInt()); break;
+              case Property::eDouble : p.doubleValues.push_back(getDouble()); break;
+              case Property::eString : p.stringValues.push_back(getString()); break;
+              default : break;
+              }
+            }
+            props.push_back(p);
+          }
+        }
+      };
+
+      Replayer::Replayer()
+        : _syntheticImages(false)
+        , _current(0)
+      {
+      }
+
+      Replayer::~Replayer()
+      {
+      }
+
+      bool Replayer::load(const std::string &filename)
+      {
+        _actions.clear();
+        _instanceIds.clear();
+        _pluginIds.clear();
+
+        FILE *fp = fopen(filename.c_str(), "rb");
+        if(!fp)
+          return false;
+        std::vector<unsigned char> data;
+        unsigned char chunk[65536];
+        size_t n;
+        while((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+          data.insert(data.end(), chunk, chunk + n);
+        fclose(fp);
+
+        Reader in(data);
+        if(in.getVarint() != kMagic || in.getVarint() != kVersion)
+          return false;
+
+        std::map<unsigned long long, size_t> bySerial;
+        while(in.ok() && !in.atEnd()) {
+          switch(in.getByte()) {
+          case eRecordInstance : {
+            unsigned long long id = in.getVarint();
+            _instanceIds.push_back(id);
+            _pluginIds[id] = in.getString();
+            in.getVarint(); // major version
+            in.getVarint(); // minor version
+            in.getString(); // context
+            break;
+          }
+          case eRecordAction : {
+            ActionRecord a;
+            a.serial = in.getVarint();
+            a.instance = in.getVarint();
+            a.action = in.getString();
+            unsigned char flags = in.getByte();
+            a.hasInArgs = (flags & 1) != 0;
+            a.hasOutArgs = (flags & 2) != 0;
+            if(a.hasInArgs)
+              in.getProperties(a.inArgs);
+            if(a.hasOutArgs)
+              in.getProperties(a.outArgs);
+            a.status = kOfxStatOK;
+            a.seconds = 0;
+            bySerial[a.serial] = _actions.size();
+            _actions.push_back(a);
+            break;
+          }
+          case eRecordActionEnd : {
+            unsigned long long serial = in.getVarint();
+            OfxStatus stat = in.getInt();
+            double seconds = in.getDouble();
+            std::map<unsigned long long, size_t>::iterator i = bySerial.find(serial);
+            if(i != bySerial.end()) {
+              _actions[i->second].status = stat;
+              _actions[i->second].seconds = seconds;
+            }
+            break;
+          }
+          case eRecordParamValue : {
+            unsigned long long serial = in.getVarint();
+            ParamValueRecord p;
+            p.name = in.getString();
+            p.type = in.getString();
+            p.atTime = in.getByte() != 0;
+            p.time = in.getDouble();
+            unsigned long long count = in.getVarint();
+            for(unsigned long long j = 0; j < count && in.ok(); ++j)
+              p.values.push_back(in.getDouble());
+            p.stringValue = in.getString();
+            std::map<unsigned long long, size_t>::iterator i = bySerial.find(serial);
+            if(i != bySerial.end())
+              _actions[i->second].params.push_back(p);
+            break;
+          }
+          case eRecordImage : {
+            unsigned long long serial = in.getVarint();
+            ImageRecord r;
+            r.clip = in.getString();
+            r.time = in.getDouble();
+            r.bounds.x1 = in.getInt();
+            r.bounds.y1 = in.getInt();
+            r.bounds.x2 = in.getInt();
+            r.bounds.y2 = in.getInt();
+            r.rowBytes = in.getInt();
+            r.components = in.getString();
+            r.depth = in.getString();
+            r.checksum = in.getVarint();
+            std::map<unsigned long long, size_t>::iterator i = bySerial.find(serial);
+            if(i != bySerial.end())
+              _actions[i->second].images.push_back(r);
+            break;
+          }
+          default :
+            // unknown record, we can't know its length so stop here
+            return false;
+          }
+        }
+        return in.ok();
+      }
+
+      const std::string &Replayer::getPluginIdentifier(unsigned long long instanceId) const
+      {
+        static const std::string none;
+        std::map<unsigned long long, std::string>::const_iterator i = _pluginIds.find(instanceId);
+        return i != _pluginIds.end() ? i->second : none;
+      }
+
+      void Replayer::buildPropertySet(const std::vector<PropertyRecord> &props, Property::Set &set)
+      {
+        for(size_t i = 0; i < props.size(); ++i) {
+          const PropertyRecord &p = props[i];
+          Property::PropSpec spec = {p.name.c_str(), p.type, p.dimension, false, 0};
+          set.createProperty(spec);
+          switch(p.type) {
+          case Property::eInt :
+            for(size_t j = 0; j < p.intValues.size(); ++j)
+              set.setIntProperty(p.name, p.intValues[j], (int)j);
+            break;
+          case Property::eDouble :
+            for(size_t j = 0; j < p.doubleValues.size(); ++j)
+              set.setDoubleProperty(p.name, p.doubleValues[j], (int)j);
+            break;
+          case Property::eString :
+            for(size_t j = 0; j < p.stringValues.size(); ++j)
+              set.setStringProperty(p.name, p.stringValues[j], (int)j);
+            break;
+          default :
+            break;
+          }
+        }
+      }
+
+      void Replayer::prepareAction(ImageEffect::Instance &instance, const ActionRecord &action)
+      {
+        for(size_t i = 0; i < action.params.size(); ++i) {
+          const ParamValueRecord &p = action.params[i];
+          Param::Instance *param = instance.getParam(p.name);
+          if(!param || param->getType() != p.type)
+            continue;
+
+          const std::vector<double> &v = p.values;
+          OfxTime t = p.time;
+          if(Param::IntegerInstance *ip = dynamic_cast<Param::IntegerInstance *>(param)) {
+            if(v.size() == 1) p.atTime ? ip->set(t, (int)v[0]) : ip->set((int)v[0]);
+          }
+          else if(Param::ChoiceInstance *cp = dynamic_cast<Param::ChoiceInstance *>(param)) {
+            if(v.size() == 1) p.atTime ? cp->set(t, (int)v[0]) : cp->set((int)v[0]);
+          }
+          else if(Param::BooleanInstance *bp = dynamic_cast<Param::BooleanInstance *>(param)) {
+            if(v.size() == 1) p.atTime ? bp->set(t, v[0] != 0) : bp->set(v[0] != 0);
+          }
+          else if(Param::DoubleInstance *dp = dynamic_cast<Param::DoubleInstance *>(param)) {
+            if(v.size() == 1) p.atTime ? dp->set(t, v[0]) : dp->set(v[0]);
+          }
+          else if(Param::Double2DInstance *d2 = dynamic_cast<Param::Double2DInstance *>(param)) {
+            if(v.size() == 2) p.atTime ? d2->set(t, v[0], v[1]) : d2->set(v[0], v[1]);
+          }
+          else if(Param::Integer2DInstance *i2 = dynamic_cast<Param::Integer2DInstance *>(param)) {
+            if(v.size() == 2) p.atTime ? i2->set(t, (int)v[0], (int)v[1]) : i2->set((int)v[0], (int)v[1]);
+          }
+          else if(Param::Double3DInstance *d3 = dynamic_cast<Param::Double3DInstance *>(param)) {
+            if(v.size() == 3) p.atTime ? d3->set(t, v[0], v[1], v[2]) : d3->set(v[0], v[1], v[2]);
+          }
+          else if(Param::Integer3DInstance *i3 = dynamic_cast<Param::Integer3DInstance *>(param)) {
+            if(v.size() == 3) p.atTime ? i3->set(t, (int)v[0], (int)v[1], (int)v[2]) : i3->set((int)v[0], (int)v[1], (int)v[2]);
+          }
+          else if(Param::RGBInstance *rgb = dynamic_cast<Param::RGBInstance *>(param)) {
+            if(v.size() == 3) p.atTime ? rgb->set(t, v[0], v[1], v[2]) : rgb->set(v[0], v[1], v[2]);
+          }
+          else if(Param::RGBAInstance *rgba = dynamic_cast<Param::RGBAInstance *>(param)) {
+            if(v.size() == 4) p.atTime ? rgba->set(t, v[0], v[1], v[2], v[3]) : rgba->set(v[0], v[1], v[2], v[3]);
+          }
+          else if(Param::StringInstance *sp = dynamic_cast<Param::StringInstance *>(param)) {
+            p.atTime ? sp->set(t, p.stringValue.c_str()) : sp->set(p.stringValue.c_str());
+          }
+        }
+      }
+
+      /// actions the host performs itself when making the instance being replayed against
+      static bool IsSkippedOnReplay(const std::string &action)
+      {
+        return action == kOfxActionLoad ||
+               action == kOfxActionUnload ||
+               action == kOfxActionDescribe ||
+               action == kOfxImageEffectActionDescribeInContext ||
+               action == kOfxActionCreateInstance ||
+               action == kOfxActionDestroyInstance;
+      }
+
+      OfxStatus Replayer::replay(ImageEffect::Instance &instance, unsigned long long instanceId, int repeat)
+      {
+        if(instanceId == 0) {
+          if(_instanceIds.empty())
+            return kOfxStatFailed;
+          instanceId = _instanceIds.front();
+        }
+        else if(_pluginIds.find(instanceId) == _pluginIds.end()) {
+          return kOfxStatFailed;
+        }
+
+        _timings.clear();
+        for(int pass = 0; pass < repeat; ++pass) {
+          for(size_t i = 0; i < _actions.size(); ++i) {
+            const ActionRecord &action = _actions[i];
+            if(action.instance != instanceId || IsSkippedOnReplay(action.action))
+              continue;
+
+            Property::Set inArgs;
+            Property::Set outArgs;
+            buildPropertySet(action.inArgs, inArgs);
+            buildPropertySet(action.outArgs, outArgs);
+
+            prepareAction(instance, action);
+
+            _current = &action;
+            Clock::time_point start = Clock::now();
+            instance.mainEntry(action.action.c_str(), instance.getHandle(),
+                               action.hasInArgs ? &inArgs : 0,
+                               action.hasOutArgs ? &outArgs : 0);
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            _current = 0;
+
+            ActionTiming &t = _timings[action.action];
+            if(t.count == 0 || seconds < t.minimum) t.minimum = seconds;
+            if(t.count == 0 || seconds > t.maximum) t.maximum = seconds;
+            t.total += seconds;
+            t.recordedTotal += action.seconds;
+            ++t.count;
+          }
+        }
+        return kOfxStatOK;
+      }
+
+      const ImageRecord *Replayer::findImage(const std::string &clip, OfxTime time) const
+      {
+        if(!_current)
+          return 0;
+        for(size_t i = 0; i < _current->images.size(); ++i) {
+          const ImageRecord &r = _current->images[i];
+          if(r.clip == clip && r.time == time)
+            return &r;
+        }
+        return 0;
+      }
+
+      /// float to half, good enough for the [0..1] values of synthetic images
+      static unsigned short FloatToHalf(float f)
+      {
+        unsigned int bits;
+        memcpy(&bits, &f, 4);
+        unsigned int sign = (bits >> 16) & 0x8000;
+        int exponent = int((bits >> 23) & 0xff) - 127 + 15;
+        unsigned int mantissa = bits & 0x7fffff;
+        if(exponent <= 0)
+          return (unsigned short)sign;
+        if(exponent >= 31)
+          return (unsigned short)(sign | 0x7c00);
+        return (unsigned short)(sign | (exponent << 10) | (mantissa >> 13));
+      }
+
+      void Replayer::fillSyntheticImage(const ImageRecord &image, void *data, int rowBytes)
+      {
+        int nComps = NumComponents(image.components);
+        int compBytes = BytesPerComponent(image.depth);
+        if(!data || nComps == 0 || compBytes == 0)
+          return;
+
+        for(int y = image.bounds.y1; y < image.bounds.y2; ++y) {
+          unsigned char *row = (unsigned char *) data + (ptrdiff_t)(y - image.bounds.y1) * rowBytes;
+          for(int x = image.bounds.x1; x < image.bounds.x2; ++x) {
+            for(int c = 0; c < nComps; ++c) {
+              // a cheap diagonal ramp, different on each channel
+              unsigned int v = (unsigned int)(x * 7 + y * 13 + c * 61) & 0xff;
+              unsigned char *dst = row + (size_t)((x - image.bounds.x1) * nComps + c) * compBytes;
+              if(image.depth == kOfxBitDepthByte) {
+                *dst = (unsigned char)v;
+              }
+              else if(image.depth == kOfxBitDepthShort) {
+                unsigned short s = (unsigned short)(v * 257);
+                memcpy(dst, &s, 2);
+              }
+              else if(image.depth == kOfxBitDepthHalf) {
+                unsigned short h = FloatToHalf(v / 255.0f);
+                memcpy(dst, &h, 2);
+              }
+              else {
+                float f = v / 255.0f;
+                memcpy(dst, &f, 4);
+              }
+            }
+          }
+        }
+      }
+
+      void Replayer::report(std::ostream &os) const
+      {
+        os << std::left << std::setw(48) << "action"
+           << std::right << std::setw(8) << "calls"
+           << std::setw(14) << "total ms"
+           << std::setw(12) << "min ms"
+           << std::setw(12) << "max ms"
+           << std::setw(14) << "recorded ms" << std::endl;
+        for(std::map<std::string, ActionTiming>::const_iterator i = _timings.begin(); i != _timings.end(); ++i) {
+          const ActionTiming &t = i->second;
+          os << std::left << std::setw(48) << i->first
+             << std::right << std::setw(8) << t.count
+             << std::fixed << std::setprecision(3)
+             << std::setw(14) << t.total * 1000.0
+             << std::setw(12) << t.minimum * 1000.0
+             << std::setw(12) << t.maximum * 1000.0
+             << std::setw(14) << t.recordedTotal * 1000.0 << std::endl;
+        }
+      }
+
+    } // namespace ActionLog
+
+  } // namespace Host
+
+} // namespace OFX
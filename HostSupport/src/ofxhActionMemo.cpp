@@ -0,0 +1,125 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// ofx
+#include "ofxCore.h"
+
+// ofx host
+#include "ofxhActionMemo.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ImageEffect {
+
+      bool IdentityKey::operator<(const IdentityKey &other) const
+      {
+        if(paramsHash != other.paramsHash) return paramsHash < other.paramsHash;
+        if(time != other.time) return time < other.time;
+        if(renderRoI.x1 != other.renderRoI.x1) return renderRoI.x1 < other.renderRoI.x1;
+        if(renderRoI.y1 != other.renderRoI.y1) return renderRoI.y1 < other.renderRoI.y1;
+        if(renderRoI.x2 != other.renderRoI.x2) return renderRoI.x2 < other.renderRoI.x2;
+        if(renderRoI.y2 != other.renderRoI.y2) return renderRoI.y2 < other.renderRoI.y2;
+        if(renderScale.x != other.renderScale.x) return renderScale.x < other.renderScale.x;
+        if(renderScale.y != other.renderScale.y) return renderScale.y < other.renderScale.y;
+        return field < other.field;
+      }
+
+      bool RegionKey::operator<(const RegionKey &other) const
+      {
+        if(paramsHash != other.paramsHash) return paramsHash < other.paramsHash;
+        if(inputsHash != other.inputsHash) return inputsHash < other.inputsHash;
+        if(time != other.time) return time < other.time;
+        if(renderScale.x != other.renderScale.x) return renderScale.x < other.renderScale.x;
+        if(renderScale.y != other.renderScale.y) return renderScale.y < other.renderScale.y;
+        if(roi.x1 != other.roi.x1) return roi.x1 < other.roi.x1;
+        if(roi.y1 != other.roi.y1) return roi.y1 < other.roi.y1;
+        if(roi.x2 != other.roi.x2) return roi.x2 < other.roi.x2;
+        return roi.y2 < other.roi.y2;
+      }
+
+      /// look a key up in one of the tables, counting the hit or miss
+      template<class K, class R> static bool Find(const std::map<K, R> &table, const K &key, R &result, std::atomic<int> &nHits, std::atomic<int> &nMisses)
+      {
+        typename std::map<K, R>::const_iterator i = table.find(key);
+        if(i == table.end()) {
+          ++nMisses;
+          return false;
+        }
+        result = i->second;
+        ++nHits;
+        return true;
+      }
+
+      /// add to one of the tables, emptying it first if it is full
+      template<class K, class R> static void Add(std::map<K, R> &table, const K &key, const R &result, size_t maxEntries)
+      {
+        if(table.size() >= maxEntries)
+          table.clear();
+        table[key] = result;
+      }
+
+      ActionMemo::ActionMemo(size_t maxEntries)
+        : _maxEntries(maxEntries)
+        , _nHits(0)
+        , _nMisses(0)
+      {
+      }
+
+      bool ActionMemo::findIdentity(const IdentityKey &key, IdentityResult &result)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return Find(_identity, key, result, _nHits, _nMisses);
+      }
+
+      void ActionMemo::addIdentity(const IdentityKey &key, const IdentityResult &result)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Add(_identity, key, result, _maxEntries);
+      }
+
+      bool ActionMemo::findRoD(const RegionKey &key, RoDResult &result)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return Find(_rods, key, result, _nHits, _nMisses);
+      }
+
+      void ActionMemo::addRoD(const RegionKey &key, const RoDResult &result)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Add(_rods, key, result, _maxEntries);
+      }
+
+      bool ActionMemo::findRoI(const RegionKey &key, RoIResult &result)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return Find(_rois, key, result, _nHits, _nMisses);
+      }
+
+      void ActionMemo::addRoI(const RegionKey &key, const RoIResult &result)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Add(_rois, key, result, _maxEntries);
+      }
+
+      void ActionMemo::clearRegions()
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _rods.clear();
+        _rois.clear();
+      }
+
+      void ActionMemo::clear()
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _identity.clear();
+        _rods.clear();
+        _rois.clear();
+      }
+
+    } // namespace ImageEffect
+
+  } // namespace Host
+
+} // namespace OFX
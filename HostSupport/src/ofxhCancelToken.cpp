@@ -0,0 +1,48 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// ofx
+#include "ofxCore.h"
+
+// ofx host
+#include "ofxhCancelToken.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ImageEffect {
+
+      // plugins read the flag as a plain int
+      static_assert(sizeof(std::atomic<int>) == sizeof(int) && ATOMIC_INT_LOCK_FREE == 2,
+                    "the cancel flag must be readable as an int");
+
+      /// the token installed on each thread
+      static thread_local CancelToken *gCurrentToken = 0;
+
+      const int *CancelToken::getFlag() const
+      {
+        return reinterpret_cast<const int *>(&_cancelled);
+      }
+
+      CancelToken *CancelToken::getCurrent()
+      {
+        return gCurrentToken;
+      }
+
+      CancelScope::CancelScope(CancelToken *token)
+        : _previous(gCurrentToken)
+      {
+        gCurrentToken = token;
+      }
+
+      CancelScope::~CancelScope()
+      {
+        gCurrentToken = _previous;
+      }
+
+    } // namespace ImageEffect
+
+  } // namespace Host
+
+} // namespace OFX
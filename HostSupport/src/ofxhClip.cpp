@@ -2,12 +2,17 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include <assert.h>
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
 
 // ofx
 #include "ofxCore.h"
+#include "ofxImageAlignment.h"
 
 // ofx host
 #include "ofxhBinary.h"
+#include "ofxhMemory.h"
 #include "ofxhPropertySuite.h"
 #include "ofxhClip.h"
 #include "ofxhImageEffect.h"
@@ -558,8 +563,7 @@ namespace OFX {
       // release the reference 
       void ImageBase::releaseReference()
       {
-        _referenceCount -= 1;
-        if(_referenceCount <= 0)
+        if(--_referenceCount <= 0)
           delete this;
       }
 
@@ -603,6 +607,137 @@ namespace OFX {
       Image::~Image() {
         //assert(_referenceCount <= 0);
       }
+
+      /// bytes in a pixel of the given depth and components, 0 if they are unknown
+      static int BytesPerPixel(const std::string &depth, const std::string &components)
+      {
+        int bytes = 0;
+        if(depth == kOfxBitDepthByte)
+          bytes = 1;
+        else if(depth == kOfxBitDepthShort || depth == kOfxBitDepthHalf)
+          bytes = 2;
+        else if(depth == kOfxBitDepthFloat)
+          bytes = 4;
+
+        if(components == kOfxImageComponentRGBA)
+          return bytes * 4;
+        else if(components == kOfxImageComponentRGB)
+          return bytes * 3;
+        else if(components == kOfxImageComponentAlpha)
+          return bytes;
+        return 0;
+      }
+
+      /// the row alignment the host promises plugins, 0 if none
+      static int HostRowAlignment()
+      {
+        if(!gImageEffectHost)
+          return 0;
+        return gImageEffectHost->getProperties().getIntProperty(kOfxImageEffectHostPropRowAlignment);
+      }
+
+      ImageView::ImageView(Image &parent, const OfxRectI &bounds, int bytesPerPixel)
+        : Image()
+        , _parent(&parent)
+        , _copy(0)
+      {
+        _parent->addReference();
+
+        // everything bar the bounds and data is the parent's
+        setStringProperty(kOfxImageEffectPropPixelDepth, parent.getStringProperty(kOfxImageEffectPropPixelDepth));
+        setStringProperty(kOfxImageEffectPropComponents, parent.getStringProperty(kOfxImageEffectPropComponents));
+        setStringProperty(kOfxImageEffectPropPreMultiplication, parent.getStringProperty(kOfxImageEffectPropPreMultiplication));
+        setDoubleProperty(kOfxImageEffectPropRenderScale, parent.getDoubleProperty(kOfxImageEffectPropRenderScale, 0), 0);
+        setDoubleProperty(kOfxImageEffectPropRenderScale, parent.getDoubleProperty(kOfxImageEffectPropRenderScale, 1), 1);
+        setDoubleProperty(kOfxImagePropPixelAspectRatio, parent.getDoubleProperty(kOfxImagePropPixelAspectRatio));
+        OfxRectI rod = parent.getROD();
+        setIntPropertyN(kOfxImagePropRegionOfDefinition, &rod.x1, 4);
+        setStringProperty(kOfxImagePropField, parent.getStringProperty(kOfxImagePropField));
+        setStringProperty(kOfxImagePropUniqueIdentifier, parent.getStringProperty(kOfxImagePropUniqueIdentifier));
+
+        // and the pixels start at the bottom left of our bounds in the parent's buffer, a row apart as they are there
+        int rowBytes = parent.getIntProperty(kOfxImagePropRowBytes);
+        OfxRectI parentBounds = parent.getBounds();
+        char *data = (char *) parent.getPointerProperty(kOfxImagePropData);
+        if(data)
+          data += (ptrdiff_t)(bounds.y1 - parentBounds.y1) * rowBytes + (ptrdiff_t)(bounds.x1 - parentBounds.x1) * bytesPerPixel;
+
+        // create has moved our left edge to an aligned pixel, so only a parent whose own rows
+        // do not start where the host promises plugins they do needs copying
+        int alignment = HostRowAlignment();
+        char *parentData = (char *) parent.getPointerProperty(kOfxImagePropData);
+        if(data && alignment > 0 && ((size_t) parentData % alignment != 0 || rowBytes % alignment != 0)) {
+          int nRows = bounds.y2 - bounds.y1;
+          size_t copyRowBytes = Memory::getRowBytes(bounds.x2 - bounds.x1, bytesPerPixel);
+          _copy = (char *) Memory::allocAligned(copyRowBytes * nRows);
+          for(int y = 0; y < nRows; ++y)
+            memcpy(_copy + y * copyRowBytes, data + (ptrdiff_t) y * rowBytes, (size_t)(bounds.x2 - bounds.x1) * bytesPerPixel);
+          data = _copy;
+          rowBytes = (int) copyRowBytes;
+        }
+
+        setIntPropertyN(kOfxImagePropBounds, &bounds.x1, 4);
+        setIntProperty(kOfxImagePropRowBytes, rowBytes);
+        setPointerProperty(kOfxImagePropData, data);
+      }
+
+      ImageView::~ImageView()
+      {
+        if(_copy)
+          Memory::freeAligned(_copy);
+        _parent->releaseReference();
+      }
+
+      ImageView *ImageView::create(Image &parent, const OfxRectI &bounds)
+      {
+        int bytesPerPixel = BytesPerPixel(parent.getStringProperty(kOfxImageEffectPropPixelDepth),
+                                          parent.getStringProperty(kOfxImageEffectPropComponents));
+        if(bytesPerPixel == 0)
+          return NULL;
+
+        OfxRectI parentBounds = parent.getBounds();
+        OfxRectI clipped;
+        clipped.x1 = Maximum(bounds.x1, parentBounds.x1);
+        clipped.y1 = Maximum(bounds.y1, parentBounds.y1);
+        clipped.x2 = Minimum(bounds.x2, parentBounds.x2);
+        clipped.y2 = Minimum(bounds.y2, parentBounds.y2);
+        if(clipped.x1 >= clipped.x2 || clipped.y1 >= clipped.y2)
+          return NULL;
+
+        // move the left edge out to the nearest pixel whose rows start on the host's alignment,
+        // which are every alignment / gcd(alignment, bytesPerPixel) pixels from the parent's
+        int alignment = HostRowAlignment();
+        if(alignment > 0) {
+          int a = alignment, b = bytesPerPixel;
+          while(b != 0) {
+            int r = a % b;
+            a = b;
+            b = r;
+          }
+          int step = alignment / a;
+          clipped.x1 = parentBounds.x1 + (clipped.x1 - parentBounds.x1) / step * step;
+        }
+
+        return new ImageView(parent, clipped, bytesPerPixel);
+      }
+
+      ImageView *ImageView::create(Image &parent, const OfxRectD &canonicalBounds)
+      {
+        double renderScaleX = parent.getDoubleProperty(kOfxImageEffectPropRenderScale, 0);
+        double renderScaleY = parent.getDoubleProperty(kOfxImageEffectPropRenderScale, 1);
+        double par = parent.getDoubleProperty(kOfxImagePropPixelAspectRatio);
+        if(par <= 0)
+          par = 1;
+
+        // take every pixel the region touches, clamping before the cast as the region may be infinite
+        OfxRectI parentBounds = parent.getBounds();
+        OfxRectI bounds;
+        bounds.x1 = (int) Maximum(floor(canonicalBounds.x1 * renderScaleX / par), (double) parentBounds.x1);
+        bounds.y1 = (int) Maximum(floor(canonicalBounds.y1 * renderScaleY), (double) parentBounds.y1);
+        bounds.x2 = (int) Minimum(ceil(canonicalBounds.x2 * renderScaleX / par), (double) parentBounds.x2);
+        bounds.y2 = (int) Minimum(ceil(canonicalBounds.y2 * renderScaleY), (double) parentBounds.y2);
+        return create(parent, bounds);
+      }
 #   ifdef OFX_SUPPORTS_OPENGLRENDER
       static const Property::PropSpec textureStuffs[] = {
         { kOfxImageEffectPropOpenGLTextureIndex, Property::eInt, 1, true, "-1" },
@@ -0,0 +1,582 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+
+// ofx
+#include "ofxCore.h"
+#include "ofxPixels.h"
+#include "ofxDrawSuite.h"
+
+// ofx host
+#include "ofxhDraw.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace Draw {
+
+      //
+      // Context
+      //
+
+      Context::Context()
+        : _lineWidth(0)
+        , _stipple(kOfxDrawLineStipplePatternSolid)
+        , _drawing(false)
+      {
+        static const OfxRGBAColourF standardColours[kOfxStandardColourOverlayText + 1] = {
+          {0.0f, 0.0f, 0.0f, 1.0f}, // kOfxStandardColourOverlayBackground
+          {1.0f, 0.8f, 0.0f, 1.0f}, // kOfxStandardColourOverlayActive
+          {1.0f, 1.0f, 1.0f, 1.0f}, // kOfxStandardColourOverlaySelected
+          {0.7f, 0.7f, 0.7f, 1.0f}, // kOfxStandardColourOverlayDeselected
+          {1.0f, 1.0f, 1.0f, 1.0f}, // kOfxStandardColourOverlayMarqueeFG
+          {0.0f, 0.0f, 0.0f, 1.0f}, // kOfxStandardColourOverlayMarqueeBG
+          {1.0f, 1.0f, 1.0f, 1.0f}  // kOfxStandardColourOverlayText
+        };
+        for(int i = 0; i <= kOfxStandardColourOverlayText; ++i)
+          _standardColours[i] = standardColours[i];
+        _colour = standardColours[kOfxStandardColourOverlaySelected];
+      }
+
+      Context::~Context()
+      {
+      }
+
+      void Context::begin()
+      {
+        // clear rather than reallocate, the buffers are reused from one draw to the next
+        _commands.clear();
+        _points.clear();
+        _text.clear();
+        _colour = _standardColours[kOfxStandardColourOverlaySelected];
+        _lineWidth = 0;
+        _stipple = kOfxDrawLineStipplePatternSolid;
+        _drawing = true;
+      }
+
+      void Context::setStandardColour(OfxStandardColour which, const OfxRGBAColourF &colour)
+      {
+        if(which >= 0 && which <= kOfxStandardColourOverlayText)
+          _standardColours[which] = colour;
+      }
+
+      Command &Context::addCommand(int primitive)
+      {
+        Command command;
+        command.primitive = primitive;
+        command.colour = _colour;
+        command.lineWidth = _lineWidth;
+        command.stipple = _stipple;
+        command.first = (int)_points.size();
+        command.count = 0;
+        command.text = 0;
+        command.alignment = 0;
+        _commands.push_back(command);
+        return _commands.back();
+      }
+
+      OfxStatus Context::getColour(OfxStandardColour which, OfxRGBAColourF &colour) const
+      {
+        if(which < 0 || which > kOfxStandardColourOverlayText)
+          return kOfxStatErrValue;
+        colour = _standardColours[which];
+        return kOfxStatOK;
+      }
+
+      OfxStatus Context::setColour(const OfxRGBAColourF &colour)
+      {
+        _colour = colour;
+        return kOfxStatOK;
+      }
+
+      OfxStatus Context::setLineWidth(float width)
+      {
+        _lineWidth = std::max(width, 0.0f);
+        return kOfxStatOK;
+      }
+
+      OfxStatus Context::setLineStipple(OfxDrawLineStipplePattern pattern)
+      {
+        if(pattern < kOfxDrawLineStipplePatternSolid || pattern > kOfxDrawLineStipplePatternDotDash)
+          return kOfxStatErrValue;
+        _stipple = pattern;
+        return kOfxStatOK;
+      }
+
+      OfxStatus Context::draw(OfxDrawPrimitive primitive, const OfxPointD *points, int nPoints)
+      {
+        int minPoints;
+        switch(primitive) {
+        case kOfxDrawPrimitiveLines :
+        case kOfxDrawPrimitiveLineStrip :
+        case kOfxDrawPrimitiveLineLoop :
+        case kOfxDrawPrimitiveRectangle :
+        case kOfxDrawPrimitiveEllipse :
+          minPoints = 2;
+          break;
+        case kOfxDrawPrimitivePolygon :
+          minPoints = 3;
+          break;
+        default :
+          return kOfxStatErrValue;
+        }
+        if(!points || nPoints < minPoints)
+          return kOfxStatErrValue;
+
+        Command &command = addCommand(primitive);
+        command.count = nPoints;
+        _points.insert(_points.end(), points, points + nPoints);
+        return kOfxStatOK;
+      }
+
+      OfxStatus Context::drawText(const char *text, const OfxPointD &pos, int alignment)
+      {
+        Command &command = addCommand(kPrimitiveText);
+        command.count = 1;
+        command.text = (int)_text.size();
+        command.alignment = alignment;
+        _points.push_back(pos);
+        _text.insert(_text.end(), text, text + strlen(text) + 1);
+        return kOfxStatOK;
+      }
+
+      //
+      // Rasteriser
+      //
+
+      /// on and off lengths, in pixels, of a stipple pattern
+      struct StipplePattern {
+        int nLengths;
+        double lengths[4];
+        double phase;     ///< distance into the pattern a line starts at
+      };
+
+      static const StipplePattern gStipplePatterns[] = {
+        {0, {0, 0, 0, 0}, 0}, // kOfxDrawLineStipplePatternSolid
+        {2, {1, 2, 0, 0}, 0}, // kOfxDrawLineStipplePatternDot
+        {2, {6, 4, 0, 0}, 0}, // kOfxDrawLineStipplePatternDash
+        {2, {6, 4, 0, 0}, 6}, // kOfxDrawLineStipplePatternAltDash
+        {4, {1, 3, 6, 3}, 0}  // kOfxDrawLineStipplePatternDotDash
+      };
+
+      Rasteriser::Rasteriser(int width, int height)
+        : _width(std::max(width, 0))
+        , _height(std::max(height, 0))
+        , _pixels(size_t(_width) * _height * 4 + 4, 0.0f)
+        , _coverage(size_t(_width + 2) * _height, 0.0f)
+        , _span(_width + 2, 0.0f)
+        , _scaleX(1)
+        , _scaleY(1)
+        , _offsetX(0)
+        , _offsetY(0)
+        , _minRow(_height)
+        , _maxRow(-1)
+        , _minCols(_height, _width + 2)
+        , _maxCols(_height, -1)
+      {
+      }
+
+      Rasteriser::~Rasteriser()
+      {
+      }
+
+      void Rasteriser::setTransform(double scaleX, double scaleY, double offsetX, double offsetY)
+      {
+        _scaleX = scaleX;
+        _scaleY = scaleY;
+        _offsetX = offsetX;
+        _offsetY = offsetY;
+      }
+
+      void Rasteriser::clear()
+      {
+        std::fill(_pixels.begin(), _pixels.end(), 0.0f);
+      }
+
+      void Rasteriser::addEdge(double x0, double y0, double x1, double y1)
+      {
+        if(y0 == y1)
+          return;
+
+        // always walk down the rows, the direction gives the sign of the area
+        double dir = 1;
+        if(y0 > y1) {
+          std::swap(x0, x1);
+          std::swap(y0, y1);
+          dir = -1;
+        }
+
+        int yStart = (int)std::max(0.0, floor(y0));
+        int yEnd = (int)std::min((double)_height, ceil(y1));
+        if(yStart >= yEnd)
+          return;
+
+        _minRow = std::min(_minRow, yStart);
+        _maxRow = std::max(_maxRow, yEnd - 1);
+
+        int stride = _width + 2;
+        double width = _width;
+        double dxdy = (x1 - x0) / (y1 - y0);
+        double x = x0 + (std::max(y0, (double)yStart) - y0) * dxdy;
+
+        for(int y = yStart; y < yEnd; ++y) {
+          double dy = std::min(y + 1.0, y1) - std::max((double)y, y0);
+          double xNext = x + dxdy * dy;
+          double d = dy * dir;
+
+          // anything left of the buffer covers its first column, anything right of it nothing
+          double xa = std::min(std::max(std::min(x, xNext), 0.0), width);
+          double xb = std::min(std::max(std::max(x, xNext), 0.0), width);
+
+          float *row = &_coverage[size_t(y) * stride];
+          int xai = (int)floor(xa);
+          double xbCeil = ceil(xb);
+          int xbi = (int)xbCeil;
+
+          if(xbi <= xai + 1) {
+            // the edge is within a single pixel on this row
+            double xm = 0.5 * (xa + xb) - xai;
+            row[xai]   += float(d - d * xm);
+            row[xai+1] += float(d * xm);
+            xbi = xai + 1;
+          }
+          else {
+            // spread the area across the pixels the edge crosses
+            double s = 1 / (xb - xa);
+            double xaf = xa - xai;
+            double a0 = 0.5 * s * (1 - xaf) * (1 - xaf);
+            double xbf = xb - xbCeil + 1;
+            double am = 0.5 * s * xbf * xbf;
+            row[xai] += float(d * a0);
+            if(xbi == xai + 2) {
+              row[xai+1] += float(d * (1 - a0 - am));
+            }
+            else {
+              double a1 = s * (1.5 - xaf);
+              row[xai+1] += float(d * (a1 - a0));
+              for(int xi = xai + 2; xi < xbi - 1; ++xi)
+                row[xi] += float(d * s);
+              double a2 = a1 + (xbi - xai - 3) * s;
+              row[xbi-1] += float(d * (1 - a2 - am));
+            }
+            row[xbi] += float(d * am);
+          }
+
+          _minCols[y] = std::min(_minCols[y], xai);
+          _maxCols[y] = std::max(_maxCols[y], xbi);
+          x = xNext;
+        }
+      }
+
+      void Rasteriser::addPolygon(const OfxPointD *points, int nPoints)
+      {
+        for(int i = 0; i < nPoints; ++i) {
+          const OfxPointD &a = points[i];
+          const OfxPointD &b = points[(i + 1) % nPoints];
+          addEdge(a.x, a.y, b.x, b.y);
+        }
+      }
+
+      void Rasteriser::addSegment(const OfxPointD &a, const OfxPointD &b, double halfWidth)
+      {
+        double dx = b.x - a.x;
+        double dy = b.y - a.y;
+        double length = sqrt(dx * dx + dy * dy);
+        if(length <= 0)
+          return;
+        double nx = -dy / length * halfWidth;
+        double ny = dx / length * halfWidth;
+        OfxPointD quad[4] = {
+          {a.x + nx, a.y + ny},
+          {b.x + nx, b.y + ny},
+          {b.x - nx, b.y - ny},
+          {a.x - nx, a.y - ny}
+        };
+        addPolygon(quad, 4);
+      }
+
+      void Rasteriser::addStroke(const OfxPointD *points, int nPoints, bool closed, float lineWidth, OfxDrawLineStipplePattern stipple)
+      {
+        double halfWidth = std::max(lineWidth, 1.0f) * 0.5;
+        const StipplePattern &pattern = gStipplePatterns[stipple];
+        int nSegments = closed ? nPoints : nPoints - 1;
+
+        if(pattern.nLengths == 0) {
+          for(int i = 0; i < nSegments; ++i)
+            addSegment(points[i], points[(i + 1) % nPoints], halfWidth);
+          return;
+        }
+
+        // find where in the pattern the stroke starts
+        int dash = 0;
+        double remaining = pattern.lengths[0];
+        for(double phase = pattern.phase; phase > 0; ) {
+          double step = std::min(phase, remaining);
+          phase -= step;
+          remaining -= step;
+          if(remaining <= 0) {
+            dash = (dash + 1) % pattern.nLengths;
+            remaining = pattern.lengths[dash];
+          }
+        }
+
+        // then walk the segments, the pattern carries on from one segment to the next
+        for(int i = 0; i < nSegments; ++i) {
+          const OfxPointD &a = points[i];
+          const OfxPointD &b = points[(i + 1) % nPoints];
+          double dx = b.x - a.x;
+          double dy = b.y - a.y;
+          double length = sqrt(dx * dx + dy * dy);
+          if(length <= 0)
+            continue;
+          dx /= length;
+          dy /= length;
+
+          for(double t = 0; t < length; ) {
+            double step = std::min(remaining, length - t);
+            if((dash & 1) == 0) {
+              OfxPointD start = {a.x + dx * t, a.y + dy * t};
+              OfxPointD end = {a.x + dx * (t + step), a.y + dy * (t + step)};
+              addSegment(start, end, halfWidth);
+            }
+            t += step;
+            remaining -= step;
+            if(remaining <= 0) {
+              dash = (dash + 1) % pattern.nLengths;
+              remaining = pattern.lengths[dash];
+            }
+          }
+        }
+      }
+
+      void Rasteriser::fillShape(const OfxRGBAColourF &colour)
+      {
+        int stride = _width + 2;
+
+        for(int y = _minRow; y <= _maxRow; ++y) {
+          float *row = &_coverage[size_t(y) * stride];
+          int first = _minCols[y];
+          int last = _maxCols[y];
+          _minCols[y] = _width + 2;
+          _maxCols[y] = -1;
+
+          // a running sum along the row turns the accumulated areas into coverage,
+          // clearing the accumulation buffer for the next shape as it goes
+          float sum = 0;
+          for(int x = first; x <= last; ++x) {
+            sum += row[x];
+            row[x] = 0;
+            _span[x] = std::min(fabsf(sum), 1.0f);
+          }
+
+          // past the last column touched the coverage stays at the running sum,
+          // which is zero for a closed shape, so the span ends there
+          last = std::min(last, _width - 1);
+
+          // composite with no branches, so the compiler can vectorise the loop
+          float *pix = &_pixels[(size_t(y) * _width) * 4];
+          for(int x = first; x <= last; ++x) {
+            float a = colour.a * _span[x];
+            float *p = pix + x * 4;
+            p[0] = colour.r * a + p[0] * (1 - a);
+            p[1] = colour.g * a + p[1] * (1 - a);
+            p[2] = colour.b * a + p[2] * (1 - a);
+            p[3] = a + p[3] * (1 - a);
+          }
+        }
+
+        _minRow = _height;
+        _maxRow = -1;
+      }
+
+      void Rasteriser::render(const Context &context)
+      {
+        if(_width == 0 || _height == 0)
+          return;
+
+        const std::vector<Command> &commands = context.getCommands();
+        const std::vector<OfxPointD> &points = context.getPoints();
+
+        for(size_t i = 0; i < commands.size(); ++i) {
+          const Command &command = commands[i];
+          const OfxPointD *p = command.count ? &points[command.first] : 0;
+
+          if(command.primitive == kPrimitiveText) {
+            renderText(command, context.getText(command), toPixels(p[0]));
+            continue;
+          }
+
+          _path.resize(command.count);
+          for(int j = 0; j < command.count; ++j)
+            _path[j] = toPixels(p[j]);
+
+          switch(command.primitive) {
+          case kOfxDrawPrimitiveLines :
+            for(int j = 0; j + 1 < command.count; j += 2)
+              addStroke(&_path[j], 2, false, command.lineWidth, command.stipple);
+            break;
+          case kOfxDrawPrimitiveLineStrip :
+            addStroke(&_path[0], command.count, false, command.lineWidth, command.stipple);
+            break;
+          case kOfxDrawPrimitiveLineLoop :
+            addStroke(&_path[0], command.count, true, command.lineWidth, command.stipple);
+            break;
+          case kOfxDrawPrimitiveRectangle : {
+            OfxPointD corners[4] = {
+              {_path[0].x, _path[0].y},
+              {_path[1].x, _path[0].y},
+              {_path[1].x, _path[1].y},
+              {_path[0].x, _path[1].y}
+            };
+            addPolygon(corners, 4);
+            break;
+          }
+          case kOfxDrawPrimitivePolygon :
+            addPolygon(&_path[0], command.count);
+            break;
+          case kOfxDrawPrimitiveEllipse : {
+            double cx = (_path[0].x + _path[1].x) * 0.5;
+            double cy = (_path[0].y + _path[1].y) * 0.5;
+            double rx = fabs(_path[1].x - _path[0].x) * 0.5;
+            double ry = fabs(_path[1].y - _path[0].y) * 0.5;
+
+            // segments of about two pixels
+            int n = std::max(16, std::min(1024, (int)ceil(M_PI * (rx + ry) * 0.5)));
+            _path.resize(n);
+            for(int j = 0; j < n; ++j) {
+              double angle = 2 * M_PI * j / n;
+              _path[j].x = cx + rx * cos(angle);
+              _path[j].y = cy + ry * sin(angle);
+            }
+            addStroke(&_path[0], n, true, command.lineWidth, command.stipple);
+            break;
+          }
+          default :
+            break;
+          }
+
+          fillShape(command.colour);
+        }
+      }
+
+      void Rasteriser::renderText(const Command &/*command*/, const char * /*text*/, const OfxPointD &/*pos*/)
+      {
+      }
+
+      void Rasteriser::compositeOver(float *dst, int dstRowBytes) const
+      {
+        for(int y = 0; y < _height; ++y) {
+          const float *src = &_pixels[(size_t(y) * _width) * 4];
+          float *d = (float *)((char *)dst + size_t(y) * dstRowBytes);
+          for(int x = 0; x < _width * 4; x += 4) {
+            float a = 1 - src[x+3];
+            d[x]   = src[x]   + d[x]   * a;
+            d[x+1] = src[x+1] + d[x+1] * a;
+            d[x+2] = src[x+2] + d[x+2] * a;
+            d[x+3] = src[x+3] + d[x+3] * a;
+          }
+        }
+      }
+
+      //
+      // the draw suite
+      //
+
+      /// get the context behind a handle, null if the handle is not in a draw action
+      static Context *GetDrawingContext(OfxDrawContextHandle handle)
+      {
+        Context *context = reinterpret_cast<Context *>(handle);
+        if(!context || !context->isDrawing())
+          return 0;
+        return context;
+      }
+
+      static OfxStatus getColour(OfxDrawContextHandle handle, OfxStandardColour std_colour, OfxRGBAColourF *colour)
+      {
+        Context *context = GetDrawingContext(handle);
+        if(!context)
+          return kOfxStatFailed;
+        if(!colour)
+          return kOfxStatErrValue;
+        return context->getColour(std_colour, *colour);
+      }
+
+      static OfxStatus setColour(OfxDrawContextHandle handle, const OfxRGBAColourF *colour)
+      {
+        Context *context = GetDrawingContext(handle);
+        if(!context)
+          return kOfxStatFailed;
+        if(!colour)
+          return kOfxStatErrValue;
+        return context->setColour(*colour);
+      }
+
+      static OfxStatus setLineWidth(OfxDrawContextHandle handle, float width)
+      {
+        Context *context = GetDrawingContext(handle);
+        if(!context)
+          return kOfxStatFailed;
+        return context->setLineWidth(width);
+      }
+
+      static OfxStatus setLineStipple(OfxDrawContextHandle handle, OfxDrawLineStipplePattern pattern)
+      {
+        Context *context = GetDrawingContext(handle);
+        if(!context)
+          return kOfxStatFailed;
+        return context->setLineStipple(pattern);
+      }
+
+      static OfxStatus draw(OfxDrawContextHandle handle, OfxDrawPrimitive primitive, const OfxPointD *points, int point_count)
+      {
+        Context *context = GetDrawingContext(handle);
+        if(!context)
+          return kOfxStatFailed;
+        try {
+          return context->draw(primitive, points, point_count);
+        }
+        catch(...) {
+          return kOfxStatErrMemory;
+        }
+      }
+
+      static OfxStatus drawText(OfxDrawContextHandle handle, const char *text, const OfxPointD *pos, int alignment)
+      {
+        Context *context = GetDrawingContext(handle);
+        if(!context)
+          return kOfxStatFailed;
+        if(!text || !pos)
+          return kOfxStatErrValue;
+        try {
+          return context->drawText(text, *pos, alignment);
+        }
+        catch(...) {
+          return kOfxStatErrMemory;
+        }
+      }
+
+      static const OfxDrawSuiteV1 gDrawSuiteV1 = {
+        getColour,
+        setColour,
+        setLineWidth,
+        setLineStipple,
+        draw,
+        drawText
+      };
+
+      const void *GetSuite(int version) {
+        if(version == 1)
+          return &gDrawSuiteV1;
+        return NULL;
+      }
+
+    } // namespace Draw
+
+  } // namespace Host
+
+} // namespace OFX
@@ -0,0 +1,297 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <math.h>
+#include <set>
+
+// ofx
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+
+// ofx host
+#include "ofxhPropertySuite.h"
+#include "ofxhClip.h"
+#include "ofxhImageEffect.h"
+#include "ofxhFramePrefetch.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ImageEffect {
+
+      /// ranges of more frames than this are left for the plugin to fetch itself
+      static const int kMaxFramesPerRange = 64;
+
+      FramePrefetcher::FramePrefetcher(Instance &effect, int nThreads, int lookAhead)
+        : _effect(effect)
+        , _nThreads(nThreads > 0 ? nThreads : 1)
+        , _lookAhead(lookAhead > 0 ? lookAhead : 0)
+        , _active(false)
+        , _startFrame(0)
+        , _endFrame(0)
+        , _step(1)
+        , _stopping(false)
+        , _nHits(0)
+        , _nMisses(0)
+      {
+      }
+
+      FramePrefetcher::~FramePrefetcher()
+      {
+        end();
+      }
+
+      void FramePrefetcher::begin(OfxTime startFrame, OfxTime endFrame, OfxTime step, bool sequential)
+      {
+        end();
+
+        if(!sequential || step == 0)
+          return;
+
+        _startFrame = startFrame;
+        _endFrame = endFrame;
+        _step = step;
+        _stopping = false;
+        _cancel.reset();
+        _active = true;
+
+        for(int i = 0; i < _nThreads; ++i)
+          _threads.push_back(std::thread(&FramePrefetcher::threadLoop, this));
+      }
+
+      void FramePrefetcher::end()
+      {
+        if(!_active)
+          return;
+
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _stopping = true;
+          _queue.clear();
+        }
+        _cancel.cancel();
+        _wake.notify_all();
+
+        for(size_t i = 0; i < _threads.size(); ++i)
+          _threads[i].join();
+        _threads.clear();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        for(std::map<Key, Entry>::iterator i = _cache.begin(); i != _cache.end(); ++i) {
+          if(i->second.image)
+            i->second.image->releaseReference();
+        }
+        _cache.clear();
+        _framesNeeded.clear();
+        _active = false;
+
+        // wake anyone still waiting on a fetch, they will find it gone
+        _ready.notify_all();
+      }
+
+      void FramePrefetcher::addFramesNeeded(OfxTime time, std::vector<Key> &window)
+      {
+        RangeMap rangeMap;
+        if(_effect.getFrameNeededAction(time, rangeMap) != kOfxStatOK)
+          return;
+
+        for(RangeMap::iterator i = rangeMap.begin(); i != rangeMap.end(); ++i) {
+          ClipInstance *clip = i->first;
+          if(!clip || clip->isOutput() || !clip->getConnected())
+            continue;
+
+          double clipStart, clipEnd;
+          clip->getFrameRange(clipStart, clipEnd);
+
+          for(size_t r = 0; r < i->second.size(); ++r) {
+            const OfxRangeD &range = i->second[r];
+            if(range.max - range.min > kMaxFramesPerRange)
+              continue;
+
+            for(double f = range.min; f <= range.max; f += 1) {
+              if(f < clipStart || f > clipEnd)
+                continue;
+              Key key = {clip, f};
+              window.push_back(key);
+            }
+          }
+        }
+      }
+
+      void FramePrefetcher::advance(OfxTime time)
+      {
+        if(!_active)
+          return;
+
+        // the frames needed from the playhead on, nearest first, asking the
+        // plugin only about the times that have just come into the window
+        std::map<OfxTime, std::vector<Key> > framesNeeded;
+        std::vector<Key> window;
+        for(int k = 0; k <= _lookAhead; ++k) {
+          OfxTime t = time + k * _step;
+          if((_step > 0 && t > _endFrame) || (_step < 0 && t < _startFrame))
+            break;
+          std::vector<Key> &needed = framesNeeded[t];
+          std::map<OfxTime, std::vector<Key> >::iterator cached = _framesNeeded.find(t);
+          if(cached != _framesNeeded.end())
+            needed.swap(cached->second);
+          else
+            addFramesNeeded(t, needed);
+          window.insert(window.end(), needed.begin(), needed.end());
+        }
+        _framesNeeded.swap(framesNeeded);
+        std::set<Key> inWindow(window.begin(), window.end());
+
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+
+          // release what has fallen out of the window, a thread fetching one of
+          // those will find its entry gone and drop the image itself
+          for(std::map<Key, Entry>::iterator i = _cache.begin(); i != _cache.end(); ) {
+            if(inWindow.find(i->first) == inWindow.end()) {
+              if(i->second.image)
+                i->second.image->releaseReference();
+              _cache.erase(i++);
+            }
+            else {
+              ++i;
+            }
+          }
+
+          // and queue up what is new, in order
+          _queue.clear();
+          for(size_t i = 0; i < window.size(); ++i) {
+            std::map<Key, Entry>::iterator found = _cache.find(window[i]);
+            if(found == _cache.end()) {
+              Entry entry = {0, false, false};
+              _cache[window[i]] = entry;
+              _queue.push_back(window[i]);
+            }
+            else if(!found->second.ready && !found->second.fetching) {
+              _queue.push_back(window[i]);
+            }
+          }
+        }
+        _wake.notify_all();
+        _ready.notify_all();
+      }
+
+      Image *FramePrefetcher::fetch(ClipInstance &clip, OfxTime time)
+      {
+        return clip.getImage(time, 0);
+      }
+
+      void FramePrefetcher::threadLoop()
+      {
+        CancelScope scope(&_cancel);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        while(!_stopping) {
+          if(_queue.empty()) {
+            _wake.wait(lock);
+            continue;
+          }
+
+          Key key = _queue.front();
+          _queue.pop_front();
+
+          std::map<Key, Entry>::iterator i = _cache.find(key);
+          if(i == _cache.end() || i->second.ready || i->second.fetching)
+            continue;
+          i->second.fetching = true;
+          fetchEntry(lock, key);
+        }
+      }
+
+      void FramePrefetcher::fetchEntry(std::unique_lock<std::mutex> &lock, const Key &key)
+      {
+        lock.unlock();
+        Image *image = 0;
+        try {
+          image = fetch(*key.clip, key.time);
+        }
+        catch(...) {
+          image = 0;
+        }
+        lock.lock();
+
+        // the frame may have left the window whilst it was fetched
+        std::map<Key, Entry>::iterator i = _cache.find(key);
+        if(i != _cache.end() && !i->second.ready) {
+          i->second.image = image;
+          i->second.fetching = false;
+          i->second.ready = true;
+        }
+        else if(image) {
+          image->releaseReference();
+        }
+        _ready.notify_all();
+      }
+
+      /// do the pixel bounds of an image hold the given canonical bounds
+      static bool ImageCovers(const Image &image, const OfxRectD &bounds)
+      {
+        double renderScaleX = image.getDoubleProperty(kOfxImageEffectPropRenderScale, 0);
+        double renderScaleY = image.getDoubleProperty(kOfxImageEffectPropRenderScale, 1);
+        double par = image.getDoubleProperty(kOfxImagePropPixelAspectRatio, 0);
+        if(par <= 0)
+          par = 1;
+
+        OfxRectI have = image.getBounds();
+        return floor(bounds.x1 * renderScaleX / par) >= have.x1 &&
+               floor(bounds.y1 * renderScaleY) >= have.y1 &&
+               ceil(bounds.x2 * renderScaleX / par) <= have.x2 &&
+               ceil(bounds.y2 * renderScaleY) <= have.y2;
+      }
+
+      Image *FramePrefetcher::getImage(ClipInstance &clip, OfxTime time, const OfxRectD *optionalBounds)
+      {
+        if(!_active)
+          return 0;
+
+        Key key = {&clip, time};
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        for(;;) {
+          std::map<Key, Entry>::iterator i = _cache.find(key);
+          if(i == _cache.end())
+            break;
+
+          // wait on a fetch in flight, but fetch a frame still queued here
+          // rather than wait behind the rest of the queue for it
+          if(!i->second.ready) {
+            if(i->second.fetching) {
+              _ready.wait(lock);
+            }
+            else {
+              i->second.fetching = true;
+              fetchEntry(lock, key);
+            }
+            continue;
+          }
+
+          Image *image = i->second.image;
+          if(!image || (optionalBounds && !ImageCovers(*image, *optionalBounds)))
+            break;
+
+          image->addReference();
+          ++_nHits;
+          return image;
+        }
+
+        ++_nMisses;
+        return 0;
+      }
+
+      int FramePrefetcher::getNumCached()
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return (int)_cache.size();
+      }
+
+    } // namespace ImageEffect
+
+  } // namespace Host
+
+} // namespace OFX
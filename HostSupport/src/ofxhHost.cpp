@@ -13,6 +13,7 @@
 #include "ofxMemory.h"
 
 #include "ofxhHost.h"
+#include "ofxhSuiteProfile.h"
 
 typedef OfxPlugin* (*OfxGetPluginType)(int);
 
@@ -25,6 +26,7 @@ namespace OFX {
     namespace Memory {
       static OfxStatus memoryAlloc(void */*handle*/, size_t bytes, void **data)
       {
+        SuiteProfile::Call profile("memoryAlloc");
         *data = malloc(bytes);
         if (*data) {
           return kOfxStatOK;
@@ -35,6 +37,7 @@ namespace OFX {
       
       static OfxStatus memoryFree(void *data)
       {
+        SuiteProfile::Call profile("memoryFree");
         free(data);
         return kOfxStatOK;
       }
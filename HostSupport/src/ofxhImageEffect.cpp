@@ -6,6 +6,11 @@
 // ofx
 #include "ofxCore.h"
 #include "ofxImageEffect.h"
+#include "ofxParamBatch.h"
+#include "ofxDrawSuite.h"
+#include "ofxRenderAbort.h"
+#include "ofxImageAlignment.h"
+#include "ofxAsyncImageFetch.h"
 
 // ofx host
 #include "ofxhBinary.h"
@@ -19,6 +24,11 @@
 #include "ofxhHost.h"
 #include "ofxhImageEffectAPI.h"
 #include "ofxhUtilities.h"
+#include "ofxhActionLog.h"
+#include "ofxhSuiteProfile.h"
+#include "ofxhDraw.h"
+#include "ofxhCancelToken.h"
+#include "ofxhFramePrefetch.h"
 #ifdef OFX_SUPPORTS_PARAMETRIC
 #include "ofxhParametricParam.h"
 #endif
@@ -29,6 +39,7 @@
 
 #include <string.h>
 #include <stdarg.h>
+#include <future>
 
 namespace OFX {
 
@@ -342,6 +353,7 @@ namespace OFX {
         , _continuousSamples(false)
         , _frameVarying(false)
         , _outputFrameRate(24)
+        , _framePrefetcher(0)
       {
         int i = 0;
         _properties.setChainedSet(&other.getProps());
@@ -592,9 +604,10 @@ namespace OFX {
         return true;
       }
 
-      // override this to make processing abort, return 1 to abort processing
+      // override this to make processing abort, return 1 to abort processing,
+      // by default reports the cancel token installed on the calling thread
       int Instance::abort() { 
-        return 0; 
+        return CancelToken::isCurrentCancelled() ? 1 : 0; 
       }
 
       // override this to use your own memory instance - must inherit from memory::instance
@@ -638,11 +651,21 @@ namespace OFX {
                 outHandle = outArgs->getHandle();
               }
                 
+              SuiteProfile::ActionScope profileScope(_plugin->getIdentifier(), action);
+
+              ActionLog::Recorder *recorder = ActionLog::gRecorder;
+              unsigned long long serial = 0;
+              if(recorder)
+                serial = recorder->beginAction(*this, action, inArgs, outArgs);
+
               OfxStatus stat;
               try {
                  stat = ofxPlugin->mainEntry(action, handle, inHandle, outHandle);
               } CatchAllSetStatus(stat, gImageEffectHost, ofxPlugin, action);
 
+              if(recorder)
+                recorder->endAction(serial, stat);
+
               if(outArgs) 
                 examineOutArgs(action, stat, *outArgs);
 
@@ -746,6 +769,9 @@ namespace OFX {
           std::cout << "OFX: "<<(void*)this<<"->"<<kOfxActionInstanceChanged<<"("<<kOfxTypeParameter<<","<<paramName<<","<<why<<","<<time<<",("<<renderScale.x<<","<<renderScale.y<<"))"<<std::endl;
 #       endif
 
+        // the param's new value may change the regions the plugin replies with
+        _actionMemo.clearRegions();
+
         OfxStatus st = mainEntry(kOfxActionInstanceChanged,this->getHandle(), &inArgs, 0);
 #       ifdef OFX_DEBUG_ACTIONS
           std::cout << "OFX: "<<(void*)this<<"->"<<kOfxActionInstanceChanged<<"("<<kOfxTypeParameter<<","<<paramName<<","<<why<<","<<time<<",("<<renderScale.x<<","<<renderScale.y<<"))->"<<StatStr(st)<<std::endl;
@@ -759,6 +785,10 @@ namespace OFX {
                                                     OfxPointD   renderScale)
       {
         _clipPrefsDirty = true;
+
+        // what the clip is connected to may have changed, which the param state does not capture
+        _actionMemo.clear();
+
         std::map<std::string,ClipInstance*>::iterator it=_clips.find(clipName);
         if(it!=_clips.end())
           return (it->second)->instanceChangedAction(why,time,renderScale);
@@ -907,6 +937,10 @@ namespace OFX {
           <<")"<<std::endl;
 #       endif
 
+        // a sequential render walks forward through time, so its inputs can be fetched ahead
+        if(_framePrefetcher)
+          _framePrefetcher->begin(startFrame, endFrame, step, sequentialRender);
+
         OfxStatus st = mainEntry(kOfxImageEffectActionBeginSequenceRender, this->getHandle(), &inArgs, 0);
 #       ifdef OFX_DEBUG_ACTIONS
           std::cout << "OFX: "<<(void*)this<<"->"<<kOfxImageEffectActionBeginSequenceRender<<"(("<<startFrame<<","<<endFrame<<"),"<<step<<","<<interactive<<",("<<renderScale.x<<","<<renderScale.y<<"),"<<sequentialRender<<","<<interactiveRender
@@ -932,6 +966,7 @@ namespace OFX {
           { kOfxImageEffectPropSequentialRenderStatus, Property::eInt, 1, true, "0" },
           { kOfxImageEffectPropInteractiveRenderStatus, Property::eInt, 1, true, "0" },
           { kOfxImageEffectPropRenderQualityDraft, Property::eInt, 1, true, "0" },
+          { kOfxImageEffectPropRenderAbortFlag, Property::ePointer, 1, true, NULL },
           Property::propSpecEnd
         };
 
@@ -945,11 +980,18 @@ namespace OFX {
         inArgs.setIntProperty(kOfxImageEffectPropInteractiveRenderStatus,interactiveRender);
         inArgs.setIntProperty(kOfxImageEffectPropRenderQualityDraft,draftRender);
 
+        // let the plugin poll the render's cancel token directly
+        if(CancelToken *token = CancelToken::getCurrent())
+          inArgs.setPointerProperty(kOfxImageEffectPropRenderAbortFlag, const_cast<int *>(token->getFlag()));
+
 #       ifdef OFX_DEBUG_ACTIONS
           std::cout << "OFX: "<<(void*)this<<"->"<<kOfxImageEffectActionRender<<"("<<time<<","<<field<<",("<<renderRoI.x1<<","<<renderRoI.y1<<","<<renderRoI.x2<<","<<renderRoI.y2<<"),("<<renderScale.x<<","<<renderScale.y<<"),"<<sequentialRender<<","<<interactiveRender
           <<")"<<std::endl;
 #       endif
 
+        if(_framePrefetcher)
+          _framePrefetcher->advance(time);
+
         OfxStatus st = mainEntry(kOfxImageEffectActionRender,this->getHandle(), &inArgs, 0);
 #       ifdef OFX_DEBUG_ACTIONS
           std::cout << "OFX: "<<(void*)this<<"->"<<kOfxImageEffectActionRender<<"("<<time<<","<<field<<",("<<renderRoI.x1<<","<<renderRoI.y1<<","<<renderRoI.x2<<","<<renderRoI.y2<<"),("<<renderScale.x<<","<<renderScale.y<<"),"<<sequentialRender<<","<<interactiveRender
@@ -993,6 +1035,9 @@ namespace OFX {
 #       endif
 
         OfxStatus st = mainEntry(kOfxImageEffectActionEndSequenceRender,this->getHandle(), &inArgs, 0);
+
+        if(_framePrefetcher)
+          _framePrefetcher->end();
 #       ifdef OFX_DEBUG_ACTIONS
           std::cout << "OFX: "<<(void*)this<<"->"<<kOfxImageEffectActionEndSequenceRender<<"(("<<startFrame<<","<<endFrame<<"),"<<step<<","<<interactive<<",("<<renderScale.x<<","<<renderScale.y<<"),"<<sequentialRender<<","<<interactiveRender
           <<")->"<<StatStr(st)<<std::endl;
@@ -1429,6 +1474,181 @@ namespace OFX {
         return st;
       }
 
+      OfxStatus Instance::isIdentityMemoised(OfxTime     &time,
+                                             const std::string &  field,
+                                             const OfxRectI &renderRoI,
+                                             OfxPointD   renderScale,
+                                             std::string &clip)
+      {
+        IdentityKey key;
+        key.paramsHash = getValuesHash(time);
+        key.time = time;
+        key.field = field;
+        key.renderRoI = renderRoI;
+        key.renderScale = renderScale;
+
+        IdentityResult result;
+        if(_actionMemo.findIdentity(key, result)) {
+          if(result.status == kOfxStatOK) {
+            time = result.time;
+            clip = result.clip;
+          }
+          return result.status;
+        }
+
+        result.time = time;
+        result.status = isIdentityAction(result.time, field, renderRoI, renderScale, result.clip);
+
+        // errors are not remembered, so they are reported again next time
+        if(result.status == kOfxStatOK || result.status == kOfxStatReplyDefault)
+          _actionMemo.addIdentity(key, result);
+
+        if(result.status == kOfxStatOK) {
+          time = result.time;
+          clip = result.clip;
+        }
+        return result.status;
+      }
+
+      unsigned long long Instance::getInputsHash(OfxTime time)
+      {
+        unsigned long long hash = kHashInit;
+
+        // generators and the default RoD depend on the project
+        double w, h;
+        getProjectExtent(w, h);
+        HashValue(hash, w);
+        HashValue(hash, h);
+
+        for(std::map<std::string, ClipInstance*>::iterator it=_clips.begin();
+            it!=_clips.end();
+            ++it) {
+          if(it->second->isOutput())
+            continue;
+
+          HashBytes(hash, it->first.data(), it->first.size());
+          bool connected = it->second->getConnected();
+          HashValue(hash, connected);
+          if(connected) {
+            OfxRectD rod = it->second->getRegionOfDefinition(time);
+            HashValue(hash, rod);
+          }
+        }
+        return hash;
+      }
+
+      OfxStatus Instance::getRegionOfDefinitionMemoised(OfxTime  time,
+                                                        OfxPointD   renderScale,
+                                                        OfxRectD &rod)
+      {
+        RegionKey key;
+        key.paramsHash = getValuesHash(time);
+        key.inputsHash = getInputsHash(time);
+        key.time = time;
+        key.renderScale = renderScale;
+        key.roi.x1 = key.roi.y1 = key.roi.x2 = key.roi.y2 = 0;
+
+        RoDResult result;
+        if(_actionMemo.findRoD(key, result)) {
+          if(result.status == kOfxStatOK || result.status == kOfxStatReplyDefault)
+            rod = result.rod;
+          return result.status;
+        }
+
+        result.status = getRegionOfDefinitionAction(time, renderScale, result.rod);
+
+        // errors are not remembered, so they are reported again next time
+        if(result.status == kOfxStatOK || result.status == kOfxStatReplyDefault) {
+          _actionMemo.addRoD(key, result);
+          rod = result.rod;
+        }
+        return result.status;
+      }
+
+      OfxStatus Instance::getRegionOfInterestMemoised(OfxTime  time,
+                                                      OfxPointD   renderScale,
+                                                      const OfxRectD &roi,
+                                                      std::map<ClipInstance *, OfxRectD> &rois)
+      {
+        RegionKey key;
+        key.paramsHash = getValuesHash(time);
+        key.inputsHash = getInputsHash(time);
+        key.time = time;
+        key.renderScale = renderScale;
+        key.roi = roi;
+
+        RoIResult result;
+        if(_actionMemo.findRoI(key, result)) {
+          rois = result.rois;
+          return result.status;
+        }
+
+        result.status = getRegionOfInterestAction(time, renderScale, roi, result.rois);
+
+        // errors are not remembered, so they are reported again next time
+        if(result.status == kOfxStatOK || result.status == kOfxStatReplyDefault)
+          _actionMemo.addRoI(key, result);
+
+        rois = result.rois;
+        return result.status;
+      }
+
+      static Image *FetchClipImage(ClipInstance *clipInstance, OfxTime time, const OfxRectD *bounds);
+
+      Image *Instance::getPassThroughImage(OfxTime     time,
+                                           const std::string &  field,
+                                           const OfxRectI &renderRoI,
+                                           OfxPointD   renderScale)
+      {
+        std::string clipName;
+        if(isIdentityMemoised(time, field, renderRoI, renderScale, clipName) != kOfxStatOK)
+          return 0;
+
+        ClipInstance *clip = getClip(clipName);
+        if(!clip || !clip->getConnected())
+          return 0;
+
+        // fetch the render window's worth of the identity clip
+        double par = clip->getAspectRatio();
+        if(par <= 0)
+          par = 1;
+        OfxRectD bounds;
+        bounds.x1 = renderRoI.x1 * par / renderScale.x;
+        bounds.y1 = renderRoI.y1 / renderScale.y;
+        bounds.x2 = renderRoI.x2 * par / renderScale.x;
+        bounds.y2 = renderRoI.y2 / renderScale.y;
+
+        Image *image = FetchClipImage(clip, time, &bounds);
+        if(!image)
+          return 0;
+
+        // the image can only stand in for the output if its pixels are laid out the same way,
+        // otherwise the host has to render normally and let the plugin convert
+        ClipInstance *output = getClip(kOfxImageEffectOutputClipName);
+        if(!output ||
+           image->getStringProperty(kOfxImageEffectPropPixelDepth) != output->getPixelDepth() ||
+           image->getStringProperty(kOfxImageEffectPropComponents) != output->getComponents() ||
+           image->getDoubleProperty(kOfxImagePropPixelAspectRatio) != output->getAspectRatio()) {
+          image->releaseReference();
+          return 0;
+        }
+
+        // and don't hand out much more than was asked for, but never copy to trim it,
+        // an image bigger than the render window is still a valid output
+        OfxRectI imageBounds = image->getBounds();
+        if(imageBounds.x1 < renderRoI.x1 || imageBounds.y1 < renderRoI.y1 ||
+           imageBounds.x2 > renderRoI.x2 || imageBounds.y2 > renderRoI.y2) {
+          if(ImageView *view = ImageView::create(*image, renderRoI)) {
+            if(!view->isCopy()) {
+              image->releaseReference();
+              return view;
+            }
+            view->releaseReference();
+          }
+        }
+        return image;
+      }
+
       /// Get whether the component is a supported 'chromatic' component (RGBA or alpha) in
       /// the base API.
       /// Override this if you have extended your chromatic colour types (eg RGB) and want
@@ -1874,6 +2094,7 @@ namespace OFX {
       static OfxStatus getPropertySet(OfxImageEffectHandle h1, 
                                       OfxPropertySetHandle *h2)
       {        
+        SuiteProfile::Call profile("getPropertySet");
         try {
         if (!h2) {
           return kOfxStatErrBadHandle;
@@ -1900,6 +2121,7 @@ namespace OFX {
       static OfxStatus getParamSet(OfxImageEffectHandle h1, 
                                    OfxParamSetHandle *h2)
       {
+        SuiteProfile::Call profile("getParamSet");
         try {
         if (!h2) {
           return kOfxStatErrBadHandle;
@@ -1943,6 +2165,7 @@ namespace OFX {
                                   const char *name, 
                                   OfxPropertySetHandle *h2)
       {
+        SuiteProfile::Call profile("clipDefine");
         try {
         if (!h2) {
           return kOfxStatErrBadHandle;
@@ -1977,6 +2200,7 @@ namespace OFX {
       
       static OfxStatus clipGetPropertySet(OfxImageClipHandle clip,
                                           OfxPropertySetHandle *propHandle){        
+        SuiteProfile::Call profile("clipGetPropertySet");
         try {
         if (!propHandle) {
           return kOfxStatErrBadHandle;
@@ -1999,11 +2223,30 @@ namespace OFX {
         }
       }
       
+      /// fetch an image from a clip, for clipGetImage and the async image fetch suite
+      static Image *FetchClipImage(ClipInstance *clipInstance, OfxTime time, const OfxRectD *bounds)
+      {
+        // don't render upstream for a render that has been cancelled
+        if(CancelToken::isCurrentCancelled())
+          return 0;
+
+        // look in the sequential render's prefetched frames first
+        Image* image = 0;
+        Instance *effectInstance = clipInstance->getEffectInstance();
+        if(effectInstance && effectInstance->getFramePrefetcher())
+          image = effectInstance->getFramePrefetcher()->getImage(*clipInstance, time, bounds);
+
+        if(!image)
+          image = clipInstance->getImage(time, bounds);
+        return image;
+      }
+
       static OfxStatus clipGetImage(OfxImageClipHandle h1, 
                                     OfxTime time, 
                                     const OfxRectD *h2,
                                     OfxPropertySetHandle *h3)
       {
+        SuiteProfile::Call profile("clipGetImage");
         try {
         if (!h3) {
           return kOfxStatErrBadHandle;
@@ -2016,13 +2259,16 @@ namespace OFX {
           return kOfxStatErrBadHandle;
         }
 
-        Image* image = clipInstance->getImage(time,h2);
+        Image* image = FetchClipImage(clipInstance, time, h2);
         if(!image) {
           *h3 = NULL;
 
           return kOfxStatFailed;
         }
 
+        if(ActionLog::gRecorder)
+          ActionLog::gRecorder->recordImage(*clipInstance, time, *image);
+
         *h3 = image->getPropHandle();
 
         return kOfxStatOK;
@@ -2035,6 +2281,7 @@ namespace OFX {
 
       static OfxStatus clipReleaseImage(OfxPropertySetHandle h1)
       {
+        SuiteProfile::Call profile("clipReleaseImage");
         try {
         Property::Set *pset = reinterpret_cast<Property::Set*>(h1);
 
@@ -2062,6 +2309,7 @@ namespace OFX {
                                      OfxImageClipHandle *clip,
                                      OfxPropertySetHandle *propertySet)
       {
+        SuiteProfile::Call profile("clipGetHandle");
         try {
         if (!clip) {
           return kOfxStatErrBadHandle;
@@ -2095,6 +2343,7 @@ namespace OFX {
                                                  OfxTime time,
                                                  OfxRectD *bounds)
       {
+        SuiteProfile::Call profile("clipGetRegionOfDefinition");
         try {
         if (!bounds) {
           return kOfxStatErrBadHandle;
@@ -2124,6 +2373,7 @@ namespace OFX {
       // should processing be aborted?
       static int abort(OfxImageEffectHandle imageEffect)
       {
+        SuiteProfile::Call profile("abort");
         try {
         ImageEffect::Base *effectBase = reinterpret_cast<ImageEffect::Base*>(imageEffect);
 
@@ -2146,6 +2396,7 @@ namespace OFX {
                                         size_t nBytes,
                                         OfxImageMemoryHandle *memoryHandle)
       {
+        SuiteProfile::Call profile("imageMemoryAlloc");
         try {
         if (!memoryHandle) {
           return kOfxStatErrBadHandle;
@@ -2185,6 +2436,7 @@ namespace OFX {
       }
       
       static OfxStatus imageMemoryFree(OfxImageMemoryHandle memoryHandle){
+        SuiteProfile::Call profile("imageMemoryFree");
         try {
         Memory::Instance *memoryInstance = reinterpret_cast<Memory::Instance*>(memoryHandle);
 
@@ -2203,6 +2455,7 @@ namespace OFX {
       static
       OfxStatus imageMemoryLock(OfxImageMemoryHandle memoryHandle,
                                 void **returnedPtr){
+        SuiteProfile::Call profile("imageMemoryLock");
         try {
         if (!returnedPtr) {
           return kOfxStatErrBadHandle;
@@ -2227,6 +2480,7 @@ namespace OFX {
       }
       
       static OfxStatus imageMemoryUnlock(OfxImageMemoryHandle memoryHandle){
+        SuiteProfile::Call profile("imageMemoryUnlock");
         try {
         Memory::Instance *memoryInstance = reinterpret_cast<Memory::Instance*>(memoryHandle);
 
@@ -2242,6 +2496,117 @@ namespace OFX {
         }
       }
 
+      ////////////////////////////////////////////////////////////////////////////////
+      /// The async image fetch suite functions
+
+      /// what an OfxImageFetchHandle points to
+      struct ImageFetch {
+        ClipInstance *clip;
+        OfxTime time;
+        std::future<Image *> image;
+      };
+
+      static OfxStatus clipStartImageFetch(OfxImageClipHandle h1,
+                                           OfxTime time,
+                                           const OfxRectD *h2,
+                                           OfxImageFetchHandle *h3)
+      {
+        SuiteProfile::Call profile("clipStartImageFetch");
+        if (!h3) {
+          return kOfxStatErrBadHandle;
+        }
+        *h3 = NULL;
+
+        ClipInstance *clipInstance = reinterpret_cast<ClipInstance*>(h1);
+
+        if (!clipInstance || !clipInstance->verifyMagic()) {
+          return kOfxStatErrBadHandle;
+        }
+
+        // the fetch runs under the same cancel token as the action that started it
+        CancelToken *token = CancelToken::getCurrent();
+        bool hasBounds = h2 != NULL;
+        OfxRectD bounds = {0, 0, 0, 0};
+        if(hasBounds)
+          bounds = *h2;
+
+        ImageFetch *fetch = new ImageFetch;
+        fetch->clip = clipInstance;
+        fetch->time = time;
+        try {
+          fetch->image = std::async(std::launch::async, [=]() {
+              CancelScope scope(token);
+              return FetchClipImage(clipInstance, time, hasBounds ? &bounds : NULL);
+            });
+        } catch (...) {
+          // no thread to be had
+          delete fetch;
+          return kOfxStatErrMemory;
+        }
+
+        *h3 = reinterpret_cast<OfxImageFetchHandle>(fetch);
+        return kOfxStatOK;
+      }
+
+      static OfxStatus clipFinishImageFetch(OfxImageFetchHandle h1,
+                                            OfxPropertySetHandle *h2)
+      {
+        SuiteProfile::Call profile("clipFinishImageFetch");
+        ImageFetch *fetch = reinterpret_cast<ImageFetch*>(h1);
+
+        if (!fetch || !h2) {
+          return kOfxStatErrBadHandle;
+        }
+        *h2 = NULL;
+
+        Image *image = 0;
+        OfxStatus st = kOfxStatOK;
+        try {
+          image = fetch->image.get();
+        } catch (...) {
+          st = kOfxStatErrBadHandle;
+        }
+
+        if(st == kOfxStatOK && !image)
+          st = kOfxStatFailed;
+
+        if(image) {
+          if(ActionLog::gRecorder)
+            ActionLog::gRecorder->recordImage(*fetch->clip, fetch->time, *image);
+
+          *h2 = image->getPropHandle();
+        }
+
+        delete fetch;
+        return st;
+      }
+
+      static OfxStatus clipAbandonImageFetch(OfxImageFetchHandle h1)
+      {
+        SuiteProfile::Call profile("clipAbandonImageFetch");
+        ImageFetch *fetch = reinterpret_cast<ImageFetch*>(h1);
+
+        if (!fetch) {
+          return kOfxStatErrBadHandle;
+        }
+
+        try {
+          Image *image = fetch->image.get();
+          if(image)
+            image->releaseReference();
+        } catch (...) {
+        }
+
+        delete fetch;
+        return kOfxStatOK;
+      }
+
+      static const struct OfxAsyncImageFetchSuiteV1 gAsyncImageFetchSuite = {
+        clipStartImageFetch,
+        clipFinishImageFetch,
+        clipAbandonImageFetch
+      };
+
       static const struct OfxImageEffectSuiteV1 gImageEffectSuite = {
         getPropertySet,
         getParamSet,
@@ -2526,12 +2891,34 @@ namespace OFX {
       ////////////////////////////////////////////////////////////////////////////////
 #ifdef OFX_SUPPORTS_MULTITHREAD
       // Forward all multithread suite calls to the host implementation.
+
+      /// what is passed to the host's threads so they run with the caller's cancel token
+      struct ThreadFunctionArgs {
+        OfxThreadFunctionV1 *func;
+        void *customArg;
+        CancelToken *token;
+        SuiteProfile::Action *profileAction;
+      };
+
+      static void threadFunctionWithToken(unsigned int threadIndex, unsigned int threadMax, void *customArg)
+      {
+        ThreadFunctionArgs *args = (ThreadFunctionArgs *) customArg;
+        CancelScope scope(args->token);
+        SuiteProfile::ThreadScope profileScope(args->profileAction);
+        args->func(threadIndex, threadMax, args->customArg);
+      }
  
       static OfxStatus multiThread(OfxThreadFunctionV1 func,
                                    unsigned int nThreads,
                                    void *customArg)
       {
-        return gImageEffectHost->multiThread(func, nThreads, customArg);
+        CancelToken *token = CancelToken::getCurrent();
+        SuiteProfile::Action *profileAction = SuiteProfile::getCurrentAction();
+        if((!token && !profileAction) || !func)
+          return gImageEffectHost->multiThread(func, nThreads, customArg);
+
+        ThreadFunctionArgs args = {func, customArg, token, profileAction};
+        return gImageEffectHost->multiThread(threadFunctionWithToken, nThreads, &args);
       }
 
       static OfxStatus multiThreadNumCPUs(unsigned int *nCPUs)
@@ -2701,6 +3088,7 @@ namespace OFX {
 #endif
         { kOfxImageEffectPropRenderQualityDraft, Property::eInt, 1, true, "0" }, // OFX 1.4
         { kOfxImageEffectHostPropNativeOrigin, Property::eString, 0, true, kOfxHostNativeOriginBottomLeft }, // OFX 1.4
+        { kOfxImageEffectHostPropRowAlignment, Property::eInt, 1, true, "0" },
         Property::propSpecEnd
       };
 
@@ -2726,6 +3114,12 @@ namespace OFX {
         return true;
       }
 
+      // override this to return true if ClipInstance::getImage can be called from several threads at once
+      bool Host::supportsAsyncImageFetch() const
+      {
+        return false;
+      }
+
       // override this to use your own memory instance - must inherit from memory::instance
       Memory::Instance* Host::newMemoryInstance(size_t /*nBytes*/) {
         return 0;
@@ -2752,9 +3146,18 @@ namespace OFX {
           else
             return NULL;
         }
+        else if (strcmp(suiteName, kOfxAsyncImageFetchSuite)==0) {
+          if(suiteVersion==1 && supportsAsyncImageFetch())
+            return (void *)&gAsyncImageFetchSuite;
+          else
+            return NULL;
+        }
         else if (strcmp(suiteName, kOfxParameterSuite)==0) {
           return Param::GetSuite(suiteVersion);
         }
+        else if (strcmp(suiteName, kOfxParameterBatchSuite)==0) {
+          return Param::GetBatchSuite(suiteVersion);
+        }
         else if (strcmp(suiteName, kOfxMessageSuite)==0) {
           // version 2 is backward-compatible
           if(suiteVersion==1 || suiteVersion==2)
@@ -2765,6 +3168,9 @@ namespace OFX {
         else if (strcmp(suiteName, kOfxInteractSuite)==0) {
           return Interact::GetSuite(suiteVersion);
         }
+        else if (strcmp(suiteName, kOfxDrawSuite)==0) {
+          return Draw::GetSuite(suiteVersion);
+        }
         else if (strcmp(suiteName, kOfxProgressSuite)==0) {
           if(suiteVersion==1) 
             return (void*)&gProgressSuiteV1;
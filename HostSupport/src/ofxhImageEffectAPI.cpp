@@ -22,6 +22,7 @@
 #include "ofxhHost.h"
 #include "ofxhImageEffectAPI.h"
 #include "ofxhXml.h"
+#include "ofxhSuiteProfile.h"
 
 // Disable the "this pointer used in base member initialiser list" warning in Windows
 namespace OFX {
@@ -74,6 +75,7 @@ namespace OFX {
           OfxPlugin *op = _pluginHandle->getOfxPlugin();
           OfxStatus stat;
           try {
+            SuiteProfile::ActionScope profileScope(getIdentifier(), kOfxActionUnload);
 #           ifdef OFX_DEBUG_ACTIONS
               std::cout << "OFX: "<<(void*)op<<"->"<<kOfxActionUnload<<"()"<<std::endl;
 #           endif
@@ -156,6 +158,7 @@ namespace OFX {
 
           OfxStatus stat;
           try {
+            SuiteProfile::ActionScope profileScope(getIdentifier(), kOfxActionLoad);
 #           ifdef OFX_DEBUG_ACTIONS
               std::cout << "OFX: "<<(void*)op<<"->"<<kOfxActionLoad<<"()"<<std::endl;
 #           endif
@@ -171,6 +174,7 @@ namespace OFX {
           }
           
           try {
+            SuiteProfile::ActionScope profileScope(getIdentifier(), kOfxActionDescribe);
 #           ifdef OFX_DEBUG_ACTIONS
               std::cout << "OFX: "<<(void*)op<<"->"<<kOfxActionDescribe<<"()"<<std::endl;
 #           endif
@@ -216,6 +220,7 @@ namespace OFX {
 
         OfxStatus stat;
         try {
+          SuiteProfile::ActionScope profileScope(getIdentifier(), kOfxImageEffectActionDescribeInContext);
 #         ifdef OFX_DEBUG_ACTIONS
             std::cout << "OFX: "<<(void*)ph->getOfxPlugin()<<"->"<<kOfxImageEffectActionDescribeInContext<<"("<<context<<")"<<std::endl;
 #         endif
@@ -258,6 +263,7 @@ namespace OFX {
         if (_pluginHandle) {
           OfxStatus stat;
           try {
+            SuiteProfile::ActionScope profileScope(getIdentifier(), kOfxActionUnload);
 #           ifdef OFX_DEBUG_ACTIONS
               std::cout << "OFX: "<<(void*)_pluginHandle->getOfxPlugin()<<"->"<<kOfxActionUnload<<"()"<<std::endl;
 #           endif
@@ -380,6 +386,7 @@ namespace OFX {
 
         OfxStatus stat;
         try {
+          SuiteProfile::ActionScope profileScope(op->getIdentifier(), kOfxActionLoad);
 #         ifdef OFX_DEBUG_ACTIONS
             std::cout << "OFX: "<<(void*)plug.getOfxPlugin()<<"->"<<kOfxActionLoad<<"()"<<std::endl;
 #         endif
@@ -395,6 +402,7 @@ namespace OFX {
         }
 
         try {
+          SuiteProfile::ActionScope profileScope(op->getIdentifier(), kOfxActionDescribe);
 #         ifdef OFX_DEBUG_ACTIONS
             std::cout << "OFX: "<<(void*)plug.getOfxPlugin()<<"->"<<kOfxActionDescribe<<"()"<<std::endl;
 #         endif
@@ -420,6 +428,7 @@ namespace OFX {
         }
 
         try {
+          SuiteProfile::ActionScope profileScope(op->getIdentifier(), kOfxActionUnload);
 #         ifdef OFX_DEBUG_ACTIONS
             std::cout << "OFX: "<<(void*)plug.getOfxPlugin()<<"->"<<kOfxActionUnload<<"()"<<std::endl;
 #         endif
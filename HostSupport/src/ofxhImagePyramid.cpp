@@ -0,0 +1,422 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <math.h>
+#include <stddef.h>
+
+// ofx
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+
+// ofx host
+#include "ofxhUtilities.h"
+#include "ofxhMemory.h"
+#include "ofxhPropertySuite.h"
+#include "ofxhClip.h"
+#include "ofxhImagePyramid.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ImageEffect {
+
+      /// round down, rather than towards zero, when halving a coordinate
+      static int HalfFloor(int v)
+      {
+        return v >= 0 ? v / 2 : -((1 - v) / 2);
+      }
+
+      /// round up when halving a coordinate
+      static int HalfCeil(int v)
+      {
+        return -HalfFloor(-v);
+      }
+
+      PyramidLevel::PyramidLevel(const Image &source, int bytesPerPixel)
+        : Image()
+        , _pixels(0)
+      {
+        // everything bar the bounds, scale and pixels is the source's
+        setStringProperty(kOfxImageEffectPropPixelDepth, source.getStringProperty(kOfxImageEffectPropPixelDepth));
+        setStringProperty(kOfxImageEffectPropComponents, source.getStringProperty(kOfxImageEffectPropComponents));
+        setStringProperty(kOfxImageEffectPropPreMultiplication, source.getStringProperty(kOfxImageEffectPropPreMultiplication));
+        setDoubleProperty(kOfxImagePropPixelAspectRatio, source.getDoubleProperty(kOfxImagePropPixelAspectRatio));
+        setStringProperty(kOfxImagePropField, source.getStringProperty(kOfxImagePropField));
+        setStringProperty(kOfxImagePropUniqueIdentifier, source.getStringProperty(kOfxImagePropUniqueIdentifier) + "/half");
+
+        setDoubleProperty(kOfxImageEffectPropRenderScale, source.getDoubleProperty(kOfxImageEffectPropRenderScale, 0) / 2, 0);
+        setDoubleProperty(kOfxImageEffectPropRenderScale, source.getDoubleProperty(kOfxImageEffectPropRenderScale, 1) / 2, 1);
+
+        OfxRectI sourceRoD = source.getROD();
+        OfxRectI rod;
+        rod.x1 = HalfFloor(sourceRoD.x1);
+        rod.y1 = HalfFloor(sourceRoD.y1);
+        rod.x2 = HalfCeil(sourceRoD.x2);
+        rod.y2 = HalfCeil(sourceRoD.y2);
+        setIntPropertyN(kOfxImagePropRegionOfDefinition, &rod.x1, 4);
+
+        OfxRectI sourceBounds = source.getBounds();
+        OfxRectI bounds;
+        bounds.x1 = HalfFloor(sourceBounds.x1);
+        bounds.y1 = HalfFloor(sourceBounds.y1);
+        bounds.x2 = HalfCeil(sourceBounds.x2);
+        bounds.y2 = HalfCeil(sourceBounds.y2);
+        setIntPropertyN(kOfxImagePropBounds, &bounds.x1, 4);
+
+        // rows start on cache lines, as the host promises plugins of its own images
+        size_t rowBytes = Memory::getRowBytes(bounds.x2 - bounds.x1, bytesPerPixel);
+        size_t nBytes = rowBytes * (bounds.y2 - bounds.y1);
+        if(nBytes > 0)
+          _pixels = (unsigned char *) Memory::allocAligned(nBytes);
+        setIntProperty(kOfxImagePropRowBytes, (int) rowBytes);
+        setPointerProperty(kOfxImagePropData, getPixels());
+      }
+
+      PyramidLevel::~PyramidLevel()
+      {
+        if(_pixels)
+          Memory::freeAligned(_pixels);
+      }
+
+      /// write a filtered value to a pixel component, rounding and clamping integral ones
+      static inline void Store(unsigned char &p, float v) {p = (unsigned char) Minimum(Maximum(v + 0.5f, 0.f), 255.f);}
+      static inline void Store(unsigned short &p, float v) {p = (unsigned short) Minimum(Maximum(v + 0.5f, 0.f), 65535.f);}
+      static inline void Store(float &p, float v) {p = v;}
+
+      /// the bits of an image the filters need
+      struct PixelBlock {
+        char *data;
+        OfxRectI bounds;
+        int rowBytes;
+
+        explicit PixelBlock(const Image &image)
+          : data((char *) image.getPointerProperty(kOfxImagePropData))
+          , bounds(image.getBounds())
+          , rowBytes(image.getIntProperty(kOfxImagePropRowBytes))
+        {
+        }
+
+        /// the start of the given row, which must be within the bounds
+        template<class PIX> PIX *row(int y) const
+        {
+          return (PIX *) (data + (ptrdiff_t) (y - bounds.y1) * rowBytes);
+        }
+      };
+
+      /// the offsets, in components, into a source row of the source column each destination column samples
+      /// at the given offset from its first, clamped to the source's bounds
+      static void ColumnOffsets(const PixelBlock &src, const PixelBlock &dst, int offset, int nComps, std::vector<int> &offsets)
+      {
+        offsets.resize(dst.bounds.x2 - dst.bounds.x1);
+        for(int x = dst.bounds.x1; x < dst.bounds.x2; ++x) {
+          int sx = Minimum(Maximum(2 * x + offset, src.bounds.x1), src.bounds.x2 - 1);
+          offsets[x - dst.bounds.x1] = (sx - src.bounds.x1) * nComps;
+        }
+      }
+
+      /// the source row a destination row samples at the given offset from its first, clamped to the source's bounds
+      static int SourceRow(const PixelBlock &src, int y, int offset)
+      {
+        return Minimum(Maximum(2 * y + offset, src.bounds.y1), src.bounds.y2 - 1);
+      }
+
+      /// average each 2x2 block of the source into a pixel of the destination
+      template<class PIX> static void DownsampleBox(const PixelBlock &src, const PixelBlock &dst, int nComps)
+      {
+        std::vector<int> left, right;
+        ColumnOffsets(src, dst, 0, nComps, left);
+        ColumnOffsets(src, dst, 1, nComps, right);
+        int width = dst.bounds.x2 - dst.bounds.x1;
+
+        for(int y = dst.bounds.y1; y < dst.bounds.y2; ++y) {
+          const PIX *bottom = src.row<PIX>(SourceRow(src, y, 0));
+          const PIX *top = src.row<PIX>(SourceRow(src, y, 1));
+          PIX *out = dst.row<PIX>(y);
+
+          for(int x = 0; x < width; ++x) {
+            const PIX *b0 = bottom + left[x], *b1 = bottom + right[x];
+            const PIX *t0 = top + left[x], *t1 = top + right[x];
+            for(int c = 0; c < nComps; ++c)
+              Store(out[c], 0.25f * ((float) b0[c] + (float) b1[c] + (float) t0[c] + (float) t1[c]));
+            out += nComps;
+          }
+        }
+      }
+
+      /// taps of the lanczos filter, which spans two destination pixels either side, so four source pixels
+      static const int kLanczosTaps = 8;
+
+      /// the weights of the source pixels 2x-3 to 2x+4 in destination pixel x
+      static void LanczosWeights(float weights[kLanczosTaps])
+      {
+        const double pi = 3.14159265358979323846;
+        double sum = 0;
+        for(int k = 0; k < kLanczosTaps; ++k) {
+          // distance from the destination pixel's centre, in destination pixels
+          double d = (k - 3.5) / 2;
+          double w = 1;
+          if(d != 0)
+            w = 2 * sin(pi * d) * sin(pi * d / 2) / (pi * pi * d * d);
+          weights[k] = (float) w;
+          sum += w;
+        }
+        for(int k = 0; k < kLanczosTaps; ++k)
+          weights[k] = (float) (weights[k] / sum);
+      }
+
+      /// filter the source with a separable lanczos 2 filter, horizontally into a buffer of
+      /// floats holding a row for each source row, then vertically from that into the destination
+      template<class PIX> static void DownsampleLanczos(const PixelBlock &src, const PixelBlock &dst, int nComps)
+      {
+        float weights[kLanczosTaps];
+        LanczosWeights(weights);
+
+        std::vector<int> columns[kLanczosTaps];
+        for(int k = 0; k < kLanczosTaps; ++k)
+          ColumnOffsets(src, dst, k - 3, nComps, columns[k]);
+
+        int width = dst.bounds.x2 - dst.bounds.x1;
+        int rowLength = width * nComps;
+        std::vector<float> horizontal((size_t) rowLength * (src.bounds.y2 - src.bounds.y1));
+
+        for(int y = src.bounds.y1; y < src.bounds.y2; ++y) {
+          const PIX *in = src.row<PIX>(y);
+          float *out = &horizontal[(size_t) (y - src.bounds.y1) * rowLength];
+
+          for(int x = 0; x < width; ++x) {
+            for(int c = 0; c < nComps; ++c) {
+              float v = 0;
+              for(int k = 0; k < kLanczosTaps; ++k)
+                v += weights[k] * (float) in[columns[k][x] + c];
+              out[c] = v;
+            }
+            out += nComps;
+          }
+        }
+
+        for(int y = dst.bounds.y1; y < dst.bounds.y2; ++y) {
+          const float *in[kLanczosTaps];
+          for(int k = 0; k < kLanczosTaps; ++k)
+            in[k] = &horizontal[(size_t) (SourceRow(src, y, k - 3) - src.bounds.y1) * rowLength];
+          PIX *out = dst.row<PIX>(y);
+
+          for(int i = 0; i < rowLength; ++i) {
+            float v = 0;
+            for(int k = 0; k < kLanczosTaps; ++k)
+              v += weights[k] * in[k][i];
+            Store(out[i], v);
+          }
+        }
+      }
+
+      template<class PIX> static void Downsample(ImagePyramid::FilterEnum filter, const PixelBlock &src, const PixelBlock &dst, int nComps)
+      {
+        if(filter == ImagePyramid::eFilterLanczos)
+          DownsampleLanczos<PIX>(src, dst, nComps);
+        else
+          DownsampleBox<PIX>(src, dst, nComps);
+      }
+
+      /// do the pixel bounds of an image hold the given canonical bounds
+      static bool ImageCovers(const Image &image, const OfxRectD &bounds)
+      {
+        double renderScaleX = image.getDoubleProperty(kOfxImageEffectPropRenderScale, 0);
+        double renderScaleY = image.getDoubleProperty(kOfxImageEffectPropRenderScale, 1);
+        double par = image.getDoubleProperty(kOfxImagePropPixelAspectRatio, 0);
+        if(par <= 0)
+          par = 1;
+
+        OfxRectI have = image.getBounds();
+        return floor(bounds.x1 * renderScaleX / par) >= have.x1 &&
+               floor(bounds.y1 * renderScaleY) >= have.y1 &&
+               ceil(bounds.x2 * renderScaleX / par) <= have.x2 &&
+               ceil(bounds.y2 * renderScaleY) <= have.y2;
+      }
+
+      ImagePyramid::ImagePyramid(FilterEnum filter, size_t maxFrames)
+        : _filter(filter)
+        , _maxFrames(maxFrames > 0 ? maxFrames : 1)
+        , _nHits(0)
+        , _nMisses(0)
+      {
+      }
+
+      ImagePyramid::~ImagePyramid()
+      {
+        clear();
+      }
+
+      void ImagePyramid::releaseEntry(Entry &entry)
+      {
+        for(size_t i = 0; i < entry.levels.size(); ++i)
+          entry.levels[i]->releaseReference();
+        entry.levels.clear();
+      }
+
+      Image *ImagePyramid::makeLevel(const Image &source)
+      {
+        const std::string &depth = source.getStringProperty(kOfxImageEffectPropPixelDepth);
+        const std::string &components = source.getStringProperty(kOfxImageEffectPropComponents);
+
+        int nComps = 0;
+        if(components == kOfxImageComponentRGBA)
+          nComps = 4;
+        else if(components == kOfxImageComponentRGB)
+          nComps = 3;
+        else if(components == kOfxImageComponentAlpha)
+          nComps = 1;
+
+        int bytesPerComp = 0;
+        if(depth == kOfxBitDepthByte)
+          bytesPerComp = 1;
+        else if(depth == kOfxBitDepthShort)
+          bytesPerComp = 2;
+        else if(depth == kOfxBitDepthFloat)
+          bytesPerComp = 4;
+
+        PixelBlock src(source);
+        if(nComps == 0 || bytesPerComp == 0 || !src.data ||
+           src.bounds.x1 >= src.bounds.x2 || src.bounds.y1 >= src.bounds.y2)
+          return 0;
+
+        PyramidLevel *level = new PyramidLevel(source, nComps * bytesPerComp);
+        PixelBlock dst(*level);
+
+        if(bytesPerComp == 1)
+          Downsample<unsigned char>(_filter, src, dst, nComps);
+        else if(bytesPerComp == 2)
+          Downsample<unsigned short>(_filter, src, dst, nComps);
+        else
+          Downsample<float>(_filter, src, dst, nComps);
+
+        return level;
+      }
+
+      void ImagePyramid::add(ClipInstance &clip, OfxTime time, Image &image)
+      {
+        Key key = {&clip, time};
+        image.addReference();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::map<Key, Entry>::iterator i = _cache.find(key);
+        if(i != _cache.end()) {
+          releaseEntry(i->second);
+          _uses.splice(_uses.begin(), _uses, i->second.use);
+        }
+        else {
+          _uses.push_front(key);
+          i = _cache.insert(std::make_pair(key, Entry())).first;
+          i->second.use = _uses.begin();
+        }
+        i->second.levels.push_back(&image);
+
+        while(_cache.size() > _maxFrames) {
+          std::map<Key, Entry>::iterator oldest = _cache.find(_uses.back());
+          releaseEntry(oldest->second);
+          _cache.erase(oldest);
+          _uses.pop_back();
+        }
+      }
+
+      Image *ImagePyramid::getImage(ClipInstance &clip, OfxTime time, OfxPointD renderScale, const OfxRectD *optionalBounds)
+      {
+        Key key = {&clip, time};
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        std::map<Key, Entry>::iterator i = _cache.find(key);
+        if(i == _cache.end() || renderScale.x <= 0 || renderScale.y <= 0) {
+          ++_nMisses;
+          return 0;
+        }
+        _uses.splice(_uses.begin(), _uses, i->second.use);
+
+        // which level has the scale asked for, each being half the one above
+        Image *full = i->second.levels[0];
+        double fullScaleX = full->getDoubleProperty(kOfxImageEffectPropRenderScale, 0);
+        double fullScaleY = full->getDoubleProperty(kOfxImageEffectPropRenderScale, 1);
+        int n = (int) floor(log(fullScaleX / renderScale.x) / log(2.0) + 0.5);
+        double levelScale = ldexp(1.0, -n);
+        if(n < 0 ||
+           fabs(fullScaleX * levelScale - renderScale.x) > 1e-6 * renderScale.x ||
+           fabs(fullScaleY * levelScale - renderScale.y) > 1e-6 * renderScale.y) {
+          ++_nMisses;
+          return 0;
+        }
+
+        // make any levels missing down to it, without holding the lock
+        std::vector<Image *> made;
+        size_t have = i->second.levels.size();
+        if(have <= (size_t) n) {
+          Image *above = i->second.levels[have - 1];
+          above->addReference();
+          lock.unlock();
+
+          for(size_t l = have; l <= (size_t) n; ++l) {
+            Image *level = makeLevel(made.empty() ? *above : *made.back());
+            if(!level)
+              break;
+            made.push_back(level);
+          }
+
+          lock.lock();
+          above->releaseReference();
+
+          // the frame may have been replaced or dropped meanwhile, or another thread made the levels first
+          i = _cache.find(key);
+          if(i != _cache.end() && i->second.levels.size() == have && i->second.levels[have - 1] == above) {
+            i->second.levels.insert(i->second.levels.end(), made.begin(), made.end());
+            made.clear();
+          }
+        }
+
+        Image *image = 0;
+        if(i != _cache.end() && i->second.levels.size() > (size_t) n) {
+          image = i->second.levels[n];
+          if(optionalBounds && !ImageCovers(*image, *optionalBounds))
+            image = 0;
+        }
+
+        if(image) {
+          image->addReference();
+          ++_nHits;
+        }
+        else {
+          ++_nMisses;
+        }
+        lock.unlock();
+
+        for(size_t l = 0; l < made.size(); ++l)
+          made[l]->releaseReference();
+        return image;
+      }
+
+      void ImagePyramid::remove(ClipInstance &clip)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for(std::map<Key, Entry>::iterator i = _cache.begin(); i != _cache.end(); ) {
+          if(i->first.clip == &clip) {
+            releaseEntry(i->second);
+            _uses.erase(i->second.use);
+            _cache.erase(i++);
+          }
+          else {
+            ++i;
+          }
+        }
+      }
+
+      void ImagePyramid::clear()
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for(std::map<Key, Entry>::iterator i = _cache.begin(); i != _cache.end(); ++i)
+          releaseEntry(i->second);
+        _cache.clear();
+        _uses.clear();
+      }
+
+    } // namespace ImageEffect
+
+  } // namespace Host
+
+} // namespace OFX
@@ -5,6 +5,7 @@
 #include "ofxKeySyms.h"
 #include "ofxCore.h"
 #include "ofxImageEffect.h"
+#include "ofxDrawSuite.h"
 
 // ofx host
 #include "ofxhBinary.h"
@@ -14,6 +15,7 @@
 #include "ofxhMemory.h"
 #include "ofxhImageEffect.h"
 #include "ofxhInteract.h"
+#include "ofxhDraw.h"
 #include "ofxOld.h" // old plugins may rely on deprecated properties being present
 
 namespace OFX {
@@ -104,6 +106,7 @@ namespace OFX {
         { kOfxInteractPropPenPressure, Property::eDouble, 1, false, "0.0" },
         { kOfxPropKeyString, Property::eString, 1, false, "" },
         { kOfxPropKeySym, Property::eInt, 1, false, "0" },
+        { kOfxInteractPropDrawContext, Property::ePointer, 1, false, NULL }, // new in OFX 1.5
         Property::propSpecEnd
       };
 
@@ -115,6 +118,7 @@ namespace OFX {
         , _state(desc.getState())
         , _effectInstance(effectInstance)
         , _argProperties(interactArgsStuffs)
+        , _drawContext(0)
       {
         _properties.setPointerProperty(kOfxPropEffectInstance, effectInstance);
         _properties.setChainedSet(&desc.getProperties()); /// chain it into the descriptor props
@@ -291,7 +295,16 @@ namespace OFX {
                                      const OfxPointD &renderScale)
       {        
         initArgProp(time, renderScale);
-        return callEntry(kOfxInteractActionDraw, &_argProperties);
+        if(!_drawContext)
+          return callEntry(kOfxInteractActionDraw, &_argProperties);
+
+        // record the draw suite calls the plugin makes into the context
+        _drawContext->begin();
+        _argProperties.setPointerProperty(kOfxInteractPropDrawContext, _drawContext->getHandle());
+        OfxStatus stat = callEntry(kOfxInteractActionDraw, &_argProperties);
+        _argProperties.setPointerProperty(kOfxInteractPropDrawContext, 0);
+        _drawContext->end();
+        return stat;
       }
 
       OfxStatus Instance::penMotionAction(OfxTime time, 
@@ -0,0 +1,369 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <algorithm>
+#include <chrono>
+
+// ofx
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+
+// ofx host
+#include "ofxhPropertySuite.h"
+#include "ofxhInteract.h"
+#include "ofxhInteractDispatcher.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace Interact {
+
+      //
+      // LatencyStats
+      //
+
+      void LatencyStats::reset()
+      {
+        count = 0;
+        total = 0;
+        maximum = 0;
+        std::fill(buckets, buckets + kNumBuckets, 0);
+      }
+
+      void LatencyStats::add(double seconds)
+      {
+        ++count;
+        total += seconds;
+        maximum = std::max(maximum, seconds);
+        int bucket = std::min(std::max((int)(seconds * 1000), 0), kNumBuckets - 1);
+        ++buckets[bucket];
+      }
+
+      double LatencyStats::getPercentile(double fraction) const
+      {
+        if(count == 0)
+          return 0;
+        int wanted = std::max(1, (int)(fraction * count + 0.5));
+        int seen = 0;
+        for(int i = 0; i < kNumBuckets; ++i) {
+          seen += buckets[i];
+          if(seen >= wanted)
+            return (i + 1) / 1000.0;
+        }
+        return maximum;
+      }
+
+      //
+      // Dispatcher
+      //
+
+      Dispatcher::Dispatcher(double refreshRate)
+        : _refreshRate(refreshRate)
+        , _nCoalesced(0)
+      {
+      }
+
+      Dispatcher::~Dispatcher()
+      {
+      }
+
+      void Dispatcher::setRefreshRate(double refreshRate)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _refreshRate = refreshRate;
+      }
+
+      double Dispatcher::now() const
+      {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+      }
+
+      Dispatcher::DrawState &Dispatcher::getDrawState(Instance *interact)
+      {
+        std::map<Instance *, DrawState>::iterator i = _drawStates.find(interact);
+        if(i != _drawStates.end())
+          return i->second;
+
+        DrawState state;
+        state.pending = false;
+        state.inputAt = -1;
+        state.lastDraw = -1;
+        state.time = 0;
+        state.renderScale.x = state.renderScale.y = 1;
+        return _drawStates[interact] = state;
+      }
+
+      void Dispatcher::post(Event &event)
+      {
+        event.posted = now();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // look back for the last event queued for the same interact, if that is a motion
+        // too the plugin has not seen it yet, so move it on rather than queue another
+        if(event.type == ePenMotion) {
+          for(std::deque<Event>::reverse_iterator i = _events.rbegin(); i != _events.rend(); ++i) {
+            if(i->interact != event.interact)
+              continue;
+            if(i->type == ePenMotion) {
+              event.posted = i->posted;
+              *i = event;
+              ++_nCoalesced;
+              return;
+            }
+            break;
+          }
+        }
+
+        _events.push_back(event);
+      }
+
+      /// fill in the common fields of an event
+      static void InitEvent(Dispatcher::Event &event, Dispatcher::EventType type, Instance &interact, OfxTime time, const OfxPointD &renderScale)
+      {
+        event.type = type;
+        event.interact = &interact;
+        event.time = time;
+        event.renderScale = renderScale;
+        event.penPos.x = event.penPos.y = 0;
+        event.penPosViewport.x = event.penPosViewport.y = 0;
+        event.pressure = 0;
+        event.key = 0;
+        event.posted = 0;
+      }
+
+      void Dispatcher::postPenMotion(Instance &interact, OfxTime time, const OfxPointD &renderScale,
+                                     const OfxPointD &penPos, const OfxPointI &penPosViewport, double pressure)
+      {
+        Event event;
+        InitEvent(event, ePenMotion, interact, time, renderScale);
+        event.penPos = penPos;
+        event.penPosViewport = penPosViewport;
+        event.pressure = pressure;
+        post(event);
+      }
+
+      void Dispatcher::postPenDown(Instance &interact, OfxTime time, const OfxPointD &renderScale,
+                                   const OfxPointD &penPos, const OfxPointI &penPosViewport, double pressure)
+      {
+        Event event;
+        InitEvent(event, ePenDown, interact, time, renderScale);
+        event.penPos = penPos;
+        event.penPosViewport = penPosViewport;
+        event.pressure = pressure;
+        post(event);
+      }
+
+      void Dispatcher::postPenUp(Instance &interact, OfxTime time, const OfxPointD &renderScale,
+                                 const OfxPointD &penPos, const OfxPointI &penPosViewport, double pressure)
+      {
+        Event event;
+        InitEvent(event, ePenUp, interact, time, renderScale);
+        event.penPos = penPos;
+        event.penPosViewport = penPosViewport;
+        event.pressure = pressure;
+        post(event);
+      }
+
+      void Dispatcher::postKeyDown(Instance &interact, OfxTime time, const OfxPointD &renderScale, int key, const std::string &keyString)
+      {
+        Event event;
+        InitEvent(event, eKeyDown, interact, time, renderScale);
+        event.key = key;
+        event.keyString = keyString;
+        post(event);
+      }
+
+      void Dispatcher::postKeyUp(Instance &interact, OfxTime time, const OfxPointD &renderScale, int key, const std::string &keyString)
+      {
+        Event event;
+        InitEvent(event, eKeyUp, interact, time, renderScale);
+        event.key = key;
+        event.keyString = keyString;
+        post(event);
+      }
+
+      void Dispatcher::postKeyRepeat(Instance &interact, OfxTime time, const OfxPointD &renderScale, int key, const std::string &keyString)
+      {
+        Event event;
+        InitEvent(event, eKeyRepeat, interact, time, renderScale);
+        event.key = key;
+        event.keyString = keyString;
+        post(event);
+      }
+
+      void Dispatcher::postGainFocus(Instance &interact, OfxTime time, const OfxPointD &renderScale)
+      {
+        Event event;
+        InitEvent(event, eGainFocus, interact, time, renderScale);
+        post(event);
+      }
+
+      void Dispatcher::postLoseFocus(Instance &interact, OfxTime time, const OfxPointD &renderScale)
+      {
+        Event event;
+        InitEvent(event, eLoseFocus, interact, time, renderScale);
+        post(event);
+      }
+
+      void Dispatcher::requestRedraw(Instance &interact, OfxTime time, const OfxPointD &renderScale)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        DrawState &state = getDrawState(&interact);
+        state.pending = true;
+        state.time = time;
+        state.renderScale = renderScale;
+      }
+
+      void Dispatcher::requestRedraw(Instance &interact)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        getDrawState(&interact).pending = true;
+      }
+
+      /// drop the events queued for an interact
+      static void EraseEvents(std::deque<Dispatcher::Event> &events, Instance *interact)
+      {
+        for(std::deque<Dispatcher::Event>::iterator i = events.begin(); i != events.end(); ) {
+          if(i->interact == interact)
+            i = events.erase(i);
+          else
+            ++i;
+        }
+      }
+
+      void Dispatcher::removeInteract(Instance &interact)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        EraseEvents(_events, &interact);
+        EraseEvents(_delivering, &interact);
+        _drawStates.erase(&interact);
+      }
+
+      OfxStatus Dispatcher::deliver(Event &event)
+      {
+        Instance *interact = event.interact;
+        switch(event.type) {
+        case ePenMotion :
+          return interact->penMotionAction(event.time, event.renderScale, event.penPos, event.penPosViewport, event.pressure);
+        case ePenDown :
+          return interact->penDownAction(event.time, event.renderScale, event.penPos, event.penPosViewport, event.pressure);
+        case ePenUp :
+          return interact->penUpAction(event.time, event.renderScale, event.penPos, event.penPosViewport, event.pressure);
+        case eKeyDown :
+          return interact->keyDownAction(event.time, event.renderScale, event.key, &event.keyString[0]);
+        case eKeyUp :
+          return interact->keyUpAction(event.time, event.renderScale, event.key, &event.keyString[0]);
+        case eKeyRepeat :
+          return interact->keyRepeatAction(event.time, event.renderScale, event.key, &event.keyString[0]);
+        case eGainFocus :
+          return interact->gainFocusAction(event.time, event.renderScale);
+        case eLoseFocus :
+          return interact->loseFocusAction(event.time, event.renderScale);
+        }
+        return kOfxStatErrUnsupported;
+      }
+
+      double Dispatcher::process()
+      {
+        // take the queue, so events posted while the plugin runs wait for the next call
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _delivering.swap(_events);
+          _events.clear();
+        }
+
+        // take the events one at a time, so those of an interact removed by an earlier
+        // action are gone from the batch before they can be sent
+        for(;;) {
+          Event event;
+          {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(_delivering.empty())
+              break;
+            event = _delivering.front();
+            _delivering.pop_front();
+
+            DrawState &state = getDrawState(event.interact);
+            if(state.inputAt < 0 || event.posted < state.inputAt)
+              state.inputAt = event.posted;
+            state.time = event.time;
+            state.renderScale = event.renderScale;
+          }
+          deliver(event);
+        }
+
+        // find the interacts due a draw, and when the next held back one is due
+        struct DueDraw {
+          Instance *interact;
+          OfxTime time;
+          OfxPointD renderScale;
+          double inputAt;
+        };
+        std::vector<DueDraw> draws;
+        double wait = -1;
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          double t = now();
+          double period = _refreshRate > 0 ? 1 / _refreshRate : 0;
+          for(std::map<Instance *, DrawState>::iterator i = _drawStates.begin(); i != _drawStates.end(); ++i) {
+            DrawState &state = i->second;
+            if(!state.pending)
+              continue;
+            double due = state.lastDraw < 0 ? t : state.lastDraw + period;
+            if(t >= due) {
+              DueDraw draw = {i->first, state.time, state.renderScale, state.inputAt};
+              draws.push_back(draw);
+              state.pending = false;
+              state.inputAt = -1;
+              state.lastDraw = t;
+            }
+            else if(wait < 0 || due - t < wait) {
+              wait = due - t;
+            }
+          }
+        }
+
+        for(size_t i = 0; i < draws.size(); ++i) {
+          {
+            // skip an interact removed by an earlier draw
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(_drawStates.find(draws[i].interact) == _drawStates.end())
+              continue;
+          }
+          draws[i].interact->drawAction(draws[i].time, draws[i].renderScale);
+          if(draws[i].inputAt >= 0) {
+            double latency = now() - draws[i].inputAt;
+            std::lock_guard<std::mutex> lock(_mutex);
+            _latency.add(latency);
+          }
+        }
+
+        return wait;
+      }
+
+      int Dispatcher::getNumQueued()
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return (int)_events.size();
+      }
+
+      LatencyStats Dispatcher::getLatency()
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _latency;
+      }
+
+      void Dispatcher::resetStats()
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _latency.reset();
+        _nCoalesced = 0;
+      }
+
+    } // namespace Interact
+
+  } // namespace Host
+
+} // namespace OFX
@@ -1,7 +1,11 @@
 // Copyright OpenFX and contributors to the OpenFX project.
 // SPDX-License-Identifier: BSD-3-Clause
 
-// ofx host
+#include <stdlib.h>
+#include <new>
+#ifdef WINDOWS
+#include <malloc.h>
+#endif
 
 // ofx
 #include "ofxCore.h"
@@ -16,17 +20,46 @@ namespace OFX {
 
     namespace Memory {
 
+      size_t getRowBytes(int nPixels, int pixelBytes) {
+        size_t rowBytes = (size_t) nPixels * pixelBytes;
+        rowBytes = (rowBytes + kRowAlignment - 1) / kRowAlignment * kRowAlignment;
+        if(rowBytes > 0 && rowBytes % kCriticalStride == 0)
+          rowBytes += kRowAlignment;
+        return rowBytes;
+      }
+
+      void *allocAligned(size_t nBytes) {
+        void *ptr = 0;
+#ifdef WINDOWS
+        ptr = _aligned_malloc(nBytes > 0 ? nBytes : 1, kRowAlignment);
+#else
+        if(posix_memalign(&ptr, kRowAlignment, nBytes > 0 ? nBytes : 1) != 0)
+          ptr = 0;
+#endif
+        if(!ptr)
+          throw std::bad_alloc();
+        return ptr;
+      }
+
+      void freeAligned(void *ptr) {
+#ifdef WINDOWS
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+      }
+
       Instance::Instance() : _ptr(0), _locked(0) {}
 
       Instance::~Instance() {
-        delete [] _ptr;
+        freeAligned(_ptr);
       }
 
       bool Instance::alloc(size_t nBytes) {
         if(!_locked){
           if(_ptr)
             freeMem();
-          _ptr = new char[nBytes];
+          _ptr = static_cast<char*>(allocAligned(nBytes));
           return true;
         }
         else
@@ -38,7 +71,7 @@ namespace OFX {
       }
 
       void Instance::freeMem(){
-        delete [] _ptr;
+        freeAligned(_ptr);
         _ptr = 0;
         _locked = 0;
       }
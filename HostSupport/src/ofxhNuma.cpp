@@ -0,0 +1,436 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+// ofx
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+
+// ofx host
+#include "ofxhNuma.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace Numa {
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // topology
+
+      Topology::Topology()
+      {
+        unsigned int n = std::max(std::thread::hardware_concurrency(), 1u);
+        _nodes.resize(1);
+        for(unsigned int i = 0; i < n; ++i)
+          _nodes[0].push_back((int) i);
+      }
+
+#ifdef __linux__
+      /// parse a cpulist from /sys, eg: "0-3,8-11"
+      static std::vector<int> ParseCPUList(const char *list)
+      {
+        std::vector<int> cpus;
+        const char *p = list;
+        while(*p) {
+          char *end;
+          long first = strtol(p, &end, 10);
+          if(end == p)
+            break;
+          long last = first;
+          p = end;
+          if(*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            p = end;
+          }
+          for(long cpu = first; cpu <= last; ++cpu)
+            cpus.push_back((int) cpu);
+          if(*p == ',')
+            ++p;
+          else
+            break;
+        }
+        return cpus;
+      }
+
+      /// read the nodes that have CPUs from /sys, leaves the topology alone if there are none
+      static void ReadTopology(std::vector<std::vector<int> > &nodes)
+      {
+        DIR *dir = opendir("/sys/devices/system/node");
+        if(!dir)
+          return;
+
+        // node directories may be listed in any order, and their numbers may have gaps
+        std::vector<int> ids;
+        while(struct dirent *entry = readdir(dir)) {
+          int id;
+          char tail;
+          if(sscanf(entry->d_name, "node%d%c", &id, &tail) == 1)
+            ids.push_back(id);
+        }
+        closedir(dir);
+        std::sort(ids.begin(), ids.end());
+
+        std::vector<std::vector<int> > found;
+        for(size_t i = 0; i < ids.size(); ++i) {
+          char path[128];
+          snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", ids[i]);
+          FILE *fp = fopen(path, "r");
+          if(!fp)
+            continue;
+          char list[4096];
+          if(fgets(list, sizeof(list), fp)) {
+            std::vector<int> cpus = ParseCPUList(list);
+            // nodes of memory alone have no CPUs to run on
+            if(!cpus.empty())
+              found.push_back(cpus);
+          }
+          fclose(fp);
+        }
+
+        if(!found.empty())
+          nodes.swap(found);
+      }
+#endif
+
+      const Topology &Topology::get()
+      {
+        static const Topology topology = []() {
+          Topology t;
+#ifdef __linux__
+          ReadTopology(t._nodes);
+#endif
+          return t;
+        }();
+        return topology;
+      }
+
+      int Topology::getNumCPUs() const
+      {
+        int n = 0;
+        for(size_t i = 0; i < _nodes.size(); ++i)
+          n += (int) _nodes[i].size();
+        return n;
+      }
+
+      int Topology::getNodeOfThread(unsigned int threadIndex, unsigned int nThreads) const
+      {
+        if(_nodes.size() <= 1 || nThreads == 0)
+          return 0;
+
+        // the middle of the thread's share of the CPUs, and the node it lands in
+        double position = (threadIndex + 0.5) * getNumCPUs() / nThreads;
+        double first = 0;
+        for(size_t node = 0; node < _nodes.size(); ++node) {
+          first += _nodes[node].size();
+          if(position < first)
+            return (int) node;
+        }
+        return (int) _nodes.size() - 1;
+      }
+
+      bool pinThreadToNode(int node)
+      {
+#ifdef __linux__
+        const Topology &topology = Topology::get();
+        if(node < 0 || node >= topology.getNumNodes())
+          return false;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        const std::vector<int> &cpus = topology.getCPUs(node);
+        for(size_t i = 0; i < cpus.size(); ++i)
+          if(cpus[i] < CPU_SETSIZE)
+            CPU_SET(cpus[i], &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void) node;
+        return false;
+#endif
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // statistics
+
+      static std::mutex gStatisticsMutex;
+
+      /// the counters, which callers must hold gStatisticsMutex to get at
+      static std::vector<NodeStatistics> &Statistics()
+      {
+        static std::vector<NodeStatistics> statistics(Topology::get().getNumNodes());
+        return statistics;
+      }
+
+      std::vector<NodeStatistics> getStatistics()
+      {
+        std::lock_guard<std::mutex> lock(gStatisticsMutex);
+        return Statistics();
+      }
+
+      void resetStatistics()
+      {
+        std::lock_guard<std::mutex> lock(gStatisticsMutex);
+        std::vector<NodeStatistics> &statistics = Statistics();
+        std::fill(statistics.begin(), statistics.end(), NodeStatistics());
+      }
+
+      void writeStatistics(std::ostream &os)
+      {
+        std::vector<NodeStatistics> statistics = getStatistics();
+        const Topology &topology = Topology::get();
+        for(size_t node = 0; node < statistics.size(); ++node) {
+          const NodeStatistics &s = statistics[node];
+          os << "node " << node
+             << " cpus " << topology.getCPUs((int) node).size()
+             << " placed " << s.bytesPlaced << " bytes in " << s.placeSeconds << " s"
+             << " tasks " << s.nTasks << " busy " << s.busySeconds << " s"
+             << std::endl;
+        }
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // memory placement
+
+      /// a run of bytes to be placed on a node
+      struct Extent {
+        size_t offset;
+        size_t nBytes;
+      };
+
+      /// the memory of a placeMemory call and the extents of it for each node
+      struct Placement {
+        char *ptr;
+        std::vector<std::vector<Extent> > extents;
+      };
+
+      /// zero a node's extents of a Placement, run on one of the node's workers with the node as the thread index
+      static void TouchExtents(unsigned int node, unsigned int /*nNodes*/, void *customArg)
+      {
+        const Placement &placement = *static_cast<const Placement *>(customArg);
+        const std::vector<Extent> &extents = placement.extents[node];
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        size_t nBytes = 0;
+        for(size_t i = 0; i < extents.size(); ++i) {
+          memset(placement.ptr + extents[i].offset, 0, extents[i].nBytes);
+          nBytes += extents[i].nBytes;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::lock_guard<std::mutex> lock(gStatisticsMutex);
+        Statistics()[node].bytesPlaced += nBytes;
+        Statistics()[node].placeSeconds += seconds;
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // thread pool
+
+      /// the thread of a multiThread call the calling thread is running, if any
+      static thread_local bool tSpawned = false;
+      static thread_local unsigned int tThreadIndex = 0;
+
+      ThreadPool::ThreadPool()
+        : _stopping(false)
+      {
+        const Topology &topology = Topology::get();
+        _queues.resize(topology.getNumNodes());
+        for(int node = 0; node < topology.getNumNodes(); ++node)
+          for(size_t i = 0; i < topology.getCPUs(node).size(); ++i)
+            _workers.push_back(std::thread(&ThreadPool::workerLoop, this, node));
+      }
+
+      ThreadPool::~ThreadPool()
+      {
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          _stopping = true;
+        }
+        _wake.notify_all();
+        for(size_t i = 0; i < _workers.size(); ++i)
+          _workers[i].join();
+      }
+
+      void ThreadPool::workerLoop(int node)
+      {
+        if(Topology::get().getNumNodes() > 1)
+          pinThreadToNode(node);
+        tSpawned = true;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        for(;;) {
+          NodeQueue &queue = _queues[node];
+          _wake.wait(lock, [&]() {return _stopping || !queue.tasks.empty();});
+          // calls in progress are finished before stopping
+          if(queue.tasks.empty())
+            return;
+
+          Task task = queue.tasks.front();
+          queue.tasks.pop_front();
+          lock.unlock();
+
+          std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+          tThreadIndex = task.threadIndex;
+          task.func(task.threadIndex, task.nThreads, task.customArg);
+          tThreadIndex = 0;
+          double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+          if(!task.placing) {
+            std::lock_guard<std::mutex> statisticsLock(gStatisticsMutex);
+            Statistics()[node].nTasks += 1;
+            Statistics()[node].busySeconds += seconds;
+          }
+
+          lock.lock();
+          if(--task.call->nRemaining == 0)
+            _done.notify_all();
+        }
+      }
+
+      OfxStatus ThreadPool::multiThread(OfxThreadFunctionV1 func, unsigned int nThreads, void *customArg)
+      {
+        if(!func)
+          return kOfxStatFailed;
+        if(nThreads == 0)
+          nThreads = 1;
+
+        // the workers may all be waiting on the caller's call, so nested calls run here
+        if(tSpawned || _workers.empty()) {
+          bool spawned = tSpawned;
+          unsigned int threadIndex = tThreadIndex;
+          tSpawned = true;
+          for(unsigned int i = 0; i < nThreads; ++i) {
+            tThreadIndex = i;
+            func(i, nThreads, customArg);
+          }
+          tSpawned = spawned;
+          tThreadIndex = threadIndex;
+          return kOfxStatOK;
+        }
+
+        const Topology &topology = Topology::get();
+        Call call = {nThreads};
+        std::unique_lock<std::mutex> lock(_mutex);
+        for(unsigned int i = 0; i < nThreads; ++i) {
+          Task task = {func, customArg, i, nThreads, &call, false};
+          _queues[topology.getNodeOfThread(i, nThreads)].tasks.push_back(task);
+        }
+        _wake.notify_all();
+        _done.wait(lock, [&]() {return call.nRemaining == 0;});
+        return kOfxStatOK;
+      }
+
+      unsigned int ThreadPool::getThreadIndex()
+      {
+        return tThreadIndex;
+      }
+
+      bool ThreadPool::isSpawnedThread()
+      {
+        return tSpawned;
+      }
+
+      void ThreadPool::placeMemory(void *ptr, size_t nBytes, PlacementEnum placement, size_t rowBytes, unsigned int nThreads)
+      {
+        const Topology &topology = Topology::get();
+        int nNodes = topology.getNumNodes();
+        if(!ptr || nBytes == 0 || placement == ePlacementDefault || nNodes <= 1)
+          return;
+
+        // the workers may all be waiting on the caller, as in multiThread, so leave it to the OS
+        if(tSpawned || _workers.empty())
+          return;
+
+        Placement job = {(char *) ptr, std::vector<std::vector<Extent> >(nNodes)};
+        std::vector<std::vector<Extent> > &extents = job.extents;
+
+        if(placement == ePlacementBands && rowBytes > 0) {
+          // band the rows as ImageProcessor::multiThreadFunction does, anything after the last row goes with it
+          if(nThreads == 0)
+            nThreads = (unsigned int) topology.getNumCPUs();
+          size_t nRows = nBytes / rowBytes;
+          size_t h = std::max<size_t>((nRows + nThreads - 1) / nThreads, 1);
+          for(unsigned int t = 0; t < nThreads && t * h < nRows; ++t) {
+            size_t y1 = t * h;
+            size_t y2 = std::min(y1 + h, nRows);
+            Extent extent = {y1 * rowBytes, (y2 - y1) * rowBytes};
+            if(y2 == nRows)
+              extent.nBytes = nBytes - extent.offset;
+            extents[topology.getNodeOfThread(t, nThreads)].push_back(extent);
+          }
+          if(nRows == 0) {
+            Extent extent = {0, nBytes};
+            extents[0].push_back(extent);
+          }
+        }
+        else {
+          // round robin a page at a time
+          size_t pageBytes = 4096;
+#ifdef __linux__
+          long pageSize = sysconf(_SC_PAGESIZE);
+          if(pageSize > 0)
+            pageBytes = (size_t) pageSize;
+#endif
+          // the first page may start part way in
+          size_t offset = 0;
+          size_t misalign = (size_t) ptr % pageBytes;
+          for(size_t page = 0; offset < nBytes; ++page) {
+            size_t n = std::min(pageBytes - (page == 0 ? misalign : 0), nBytes - offset);
+            Extent extent = {offset, n};
+            extents[page % nNodes].push_back(extent);
+            offset += n;
+          }
+        }
+
+        // each node's share goes to its own queue, for one of its workers, which are pinned to it
+        Call call = {0};
+        std::unique_lock<std::mutex> lock(_mutex);
+        for(int node = 0; node < nNodes; ++node) {
+          if(!extents[node].empty()) {
+            Task task = {TouchExtents, &job, (unsigned int) node, (unsigned int) nNodes, &call, true};
+            _queues[node].tasks.push_back(task);
+            ++call.nRemaining;
+          }
+        }
+        _wake.notify_all();
+        _done.wait(lock, [&]() {return call.nRemaining == 0;});
+      }
+
+      ////////////////////////////////////////////////////////////////////////////////
+      // memory instance
+
+      MemoryInstance::MemoryInstance(ThreadPool &pool, PlacementEnum placement)
+        : _pool(pool)
+        , _placement(placement)
+        , _rowBytes(0)
+        , _nThreads(0)
+      {
+      }
+
+      bool MemoryInstance::alloc(size_t nBytes)
+      {
+        if(!Memory::Instance::alloc(nBytes))
+          return false;
+        PlacementEnum placement = _placement;
+        if(placement == ePlacementBands && _rowBytes == 0)
+          placement = ePlacementInterleave;
+        _pool.placeMemory(_ptr, nBytes, placement, _rowBytes, _nThreads);
+        return true;
+      }
+
+    } // namespace Numa
+
+  } // namespace Host
+
+} // namespace OFX
@@ -4,6 +4,7 @@
 // ofx
 #include "ofxCore.h"
 #include "ofxImageEffect.h"
+#include "ofxParamBatch.h"
 #ifdef OFX_SUPPORTS_PARAMETRIC
 #include "ofxParametricParam.h"
 #endif
@@ -13,6 +14,11 @@
 #include "ofxhPropertySuite.h"
 #include "ofxhParam.h"
 #include "ofxhImageEffect.h"
+#include "ofxhActionLog.h"
+#include "ofxhSuiteProfile.h"
+#ifdef OFX_SUPPORTS_PARAMETRIC
+#include "ofxhParametricParam.h"
+#endif
 #include "ofxOld.h" // old plugins may rely on deprecated properties being present
 
 
@@ -20,6 +26,7 @@
 #include <float.h>
 #include <limits.h>
 #include <stdarg.h>
+#include <string.h>
 
 namespace OFX {
 
@@ -527,7 +534,14 @@ namespace OFX {
         if(!isStandardType(paramType)) 
           return NULL; /// << EEK! This is bad.
 
-        Descriptor *desc = new Descriptor(paramType, name); 
+        Descriptor *desc;
+#ifdef OFX_SUPPORTS_PARAMETRIC
+        // parametric params hold their default control points on the descriptor
+        if(strcmp(paramType, kOfxParamTypeParametric) == 0)
+          desc = new ParametricParam::ParametricDescriptor(paramType, name);
+        else
+#endif
+          desc = new Descriptor(paramType, name);
         desc->addStandardParamProps(paramType);
         addParam(name, desc);
         return desc;
@@ -623,6 +637,12 @@ namespace OFX {
         return kOfxStatErrUnsupported;
       }
 
+      /// get the values at many times into an interleaved buffer, implemented by double valued instances
+      OfxStatus Instance::getValuesAtTimes(const OfxTime * /*times*/, int /*nTimes*/, double * /*values*/)
+      {
+        return kOfxStatErrUnsupported;
+      }
+
       /// overridden from Property::NotifyHook
       void Instance::notify(const std::string &name, bool /*single*/, int /*num*/)
       {
@@ -948,6 +968,19 @@ namespace OFX {
         return stat;
       }
 
+      /// implementation of the batch get
+      OfxStatus DoubleInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        double v;
+        for(int i = 0; i < nTimes; ++i) {
+          OfxStatus stat = get(times[i], v);
+          if(stat != kOfxStatOK)
+            return stat;
+          *values++ = v;
+        }
+        return kOfxStatOK;
+      }
+
       //
       // BooleanInstance
       //
@@ -1106,6 +1139,22 @@ namespace OFX {
         return stat;
       }
 
+      /// implementation of the batch get
+      OfxStatus RGBAInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        double r, g, b, a;
+        for(int i = 0; i < nTimes; ++i) {
+          OfxStatus stat = get(times[i], r, g, b, a);
+          if(stat != kOfxStatOK)
+            return stat;
+          *values++ = r;
+          *values++ = g;
+          *values++ = b;
+          *values++ = a;
+        }
+        return kOfxStatOK;
+      }
+
       //
       // RGBInstance
       //
@@ -1201,6 +1250,21 @@ namespace OFX {
         return stat;
       }
 
+      /// implementation of the batch get
+      OfxStatus RGBInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        double r, g, b;
+        for(int i = 0; i < nTimes; ++i) {
+          OfxStatus stat = get(times[i], r, g, b);
+          if(stat != kOfxStatOK)
+            return stat;
+          *values++ = r;
+          *values++ = g;
+          *values++ = b;
+        }
+        return kOfxStatOK;
+      }
+
       //
       // Double2DInstance
       //
@@ -1290,6 +1354,20 @@ namespace OFX {
         return stat;
       }
 
+      /// implementation of the batch get
+      OfxStatus Double2DInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        double x, y;
+        for(int i = 0; i < nTimes; ++i) {
+          OfxStatus stat = get(times[i], x, y);
+          if(stat != kOfxStatOK)
+            return stat;
+          *values++ = x;
+          *values++ = y;
+        }
+        return kOfxStatOK;
+      }
+
       //
       // Integer2DInstance
       //
@@ -1474,6 +1552,21 @@ namespace OFX {
         return stat;
       }
 
+      /// implementation of the batch get
+      OfxStatus Double3DInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        double x, y, z;
+        for(int i = 0; i < nTimes; ++i) {
+          OfxStatus stat = get(times[i], x, y, z);
+          if(stat != kOfxStatOK)
+            return stat;
+          *values++ = x;
+          *values++ = y;
+          *values++ = z;
+        }
+        return kOfxStatOK;
+      }
+
       //
       // Integer3DInstance
       //
@@ -1648,6 +1741,91 @@ namespace OFX {
         return _paramList;
       }
 
+      unsigned long long SetInstance::getValuesHash(OfxTime time)
+      {
+        unsigned long long hash = kHashInit;
+
+        for(std::list<Instance *>::iterator i = _paramList.begin(); i != _paramList.end(); ++i) {
+          Instance *param = *i;
+          const std::string &name = param->getName();
+          HashBytes(hash, name.data(), name.size());
+
+          if(IntegerInstance *p = dynamic_cast<IntegerInstance *>(param)) {
+            int v = 0;
+            p->get(time, v);
+            HashValue(hash, v);
+          }
+          else if(ChoiceInstance *p = dynamic_cast<ChoiceInstance *>(param)) {
+            int v = 0;
+            p->get(time, v);
+            HashValue(hash, v);
+          }
+          else if(DoubleInstance *p = dynamic_cast<DoubleInstance *>(param)) {
+            double v = 0;
+            p->get(time, v);
+            HashValue(hash, v);
+          }
+          else if(BooleanInstance *p = dynamic_cast<BooleanInstance *>(param)) {
+            bool v = false;
+            p->get(time, v);
+            HashValue(hash, v);
+          }
+          else if(RGBAInstance *p = dynamic_cast<RGBAInstance *>(param)) {
+            double v[4] = {0, 0, 0, 0};
+            p->get(time, v[0], v[1], v[2], v[3]);
+            HashValue(hash, v);
+          }
+          else if(RGBInstance *p = dynamic_cast<RGBInstance *>(param)) {
+            double v[3] = {0, 0, 0};
+            p->get(time, v[0], v[1], v[2]);
+            HashValue(hash, v);
+          }
+          else if(Double2DInstance *p = dynamic_cast<Double2DInstance *>(param)) {
+            double v[2] = {0, 0};
+            p->get(time, v[0], v[1]);
+            HashValue(hash, v);
+          }
+          else if(Integer2DInstance *p = dynamic_cast<Integer2DInstance *>(param)) {
+            int v[2] = {0, 0};
+            p->get(time, v[0], v[1]);
+            HashValue(hash, v);
+          }
+          else if(Double3DInstance *p = dynamic_cast<Double3DInstance *>(param)) {
+            double v[3] = {0, 0, 0};
+            p->get(time, v[0], v[1], v[2]);
+            HashValue(hash, v);
+          }
+          else if(Integer3DInstance *p = dynamic_cast<Integer3DInstance *>(param)) {
+            int v[3] = {0, 0, 0};
+            p->get(time, v[0], v[1], v[2]);
+            HashValue(hash, v);
+          }
+          else if(StringInstance *p = dynamic_cast<StringInstance *>(param)) {
+            // includes custom params
+            std::string v;
+            p->get(time, v);
+            HashBytes(hash, v.data(), v.size());
+          }
+#ifdef OFX_SUPPORTS_PARAMETRIC
+          else if(ParametricParam::ParametricInstance *p = dynamic_cast<ParametricParam::ParametricInstance *>(param)) {
+            int nCurves = p->getProperties().getIntProperty(kOfxParamPropParametricDimension);
+            for(int c = 0; c < nCurves; ++c) {
+              int nPoints = 0;
+              p->getNControlPoints(c, time, &nPoints);
+              for(int n = 0; n < nPoints; ++n) {
+                double point[2] = {0, 0};
+                p->getNthControlPoint(c, time, n, &point[0], &point[1]);
+                HashValue(hash, point);
+              }
+            }
+          }
+#endif
+          // groups, pages and push buttons have no value
+        }
+
+        return hash;
+      }
+
       OfxStatus SetInstance::addParam(const std::string& name, Instance* instance)
       {
         if(_params.find(name)==_params.end()){
@@ -1668,6 +1846,7 @@ namespace OFX {
                                    const char *name,
                                    OfxPropertySetHandle *propertySet)
       {
+        SuiteProfile::Call profile("paramDefine");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramDefine - " << paramSet << ' ' << paramType << ' ' << name << ' ' << propertySet << " ...";
 #       endif
@@ -1703,6 +1882,7 @@ namespace OFX {
                                       OfxParamHandle *param,
                                       OfxPropertySetHandle *propertySet)
       {
+        SuiteProfile::Call profile("paramGetHandle");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramGetHandle - " << paramSet << ' ' << name << ' ' << param << ' ' << propertySet << " ...";
 #       endif
@@ -1796,6 +1976,7 @@ namespace OFX {
       static OfxStatus paramSetGetPropertySet(OfxParamSetHandle paramSet,
                                               OfxPropertySetHandle *propHandle)
       {
+        SuiteProfile::Call profile("paramSetGetPropertySet");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramSetGetPropertySet - " << paramSet << ' ' << propHandle << " ...";
 #       endif
@@ -1822,6 +2003,7 @@ namespace OFX {
       static OfxStatus paramGetPropertySet(OfxParamHandle param,
                                            OfxPropertySetHandle *propHandle)
       {
+        SuiteProfile::Call profile("paramGetPropertySet");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramGetPropertySet - " << param << ' ' << propHandle << " ...";
 #       endif
@@ -1852,6 +2034,7 @@ namespace OFX {
       static OfxStatus paramGetValue(OfxParamHandle  paramHandle,
                                      ...)
       {
+        SuiteProfile::Call profile("paramGetValue");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramGetValue - " << paramHandle << " ...";
 #       endif
@@ -1874,6 +2057,12 @@ namespace OFX {
 
         va_end(ap);
 
+        if(stat == kOfxStatOK && ActionLog::gRecorder) {
+          va_start(ap, paramHandle);
+          ActionLog::gRecorder->recordParamValue(*paramInstance, false, 0, ap);
+          va_end(ap);
+        }
+
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << ' ' << StatStr(stat) << std::endl;
 #       endif
@@ -1885,6 +2074,7 @@ namespace OFX {
                                            OfxTime time,
                                            ...)
       {
+        SuiteProfile::Call profile("paramGetValueAtTime");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramGetValueAtTime - " << paramHandle << ' ' << time << " ...";
 #       endif
@@ -1908,6 +2098,12 @@ namespace OFX {
 
         va_end(ap);
 
+        if(stat == kOfxStatOK && ActionLog::gRecorder) {
+          va_start(ap, time);
+          ActionLog::gRecorder->recordParamValue(*paramInstance, true, time, ap);
+          va_end(ap);
+        }
+
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << ' ' << StatStr(stat) << std::endl;
 #       endif
@@ -1919,6 +2115,7 @@ namespace OFX {
                                           OfxTime time,
                                           ...)
       {
+        SuiteProfile::Call profile("paramGetDerivative");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramGetDerivative - " << paramHandle << ' ' << time << " ...";
 #       endif
@@ -1951,6 +2148,7 @@ namespace OFX {
                                         OfxTime time1, OfxTime time2,
                                         ...)
       {
+        SuiteProfile::Call profile("paramGetIntegral");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramGetIntegral - " << paramHandle << ' ' << time1 << ' ' << time2 << " ...";
 #       endif
@@ -1983,6 +2181,7 @@ namespace OFX {
       static OfxStatus paramSetValue(OfxParamHandle  paramHandle,
                                      ...) 
       {
+        SuiteProfile::Call profile("paramSetValue");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramSetValue - " << paramHandle << ' ';
 #       endif
@@ -2021,6 +2220,7 @@ namespace OFX {
                                            OfxTime time,  // time in frames
                                            ...)
       {
+        SuiteProfile::Call profile("paramSetValueAtTime");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramSetValueAtTime - " << paramHandle << ' ' << time << ' ';
 #       endif
@@ -2056,6 +2256,7 @@ namespace OFX {
       static OfxStatus paramGetNumKeys(OfxParamHandle  paramHandle,
                                        unsigned int  *numberOfKeys)
       {
+        SuiteProfile::Call profile("paramGetNumKeys");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramGetNumKeys - " << paramHandle << " ...";
 #       endif
@@ -2089,6 +2290,7 @@ namespace OFX {
                                        unsigned int nthKey,
                                        OfxTime *time)
       {
+        SuiteProfile::Call profile("paramGetKeyTime");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramGetKeyTime - " << paramHandle << " ...";
 #       endif
@@ -2120,6 +2322,7 @@ namespace OFX {
                                         int     direction,
                                         int    *index) 
       {
+        SuiteProfile::Call profile("paramGetKeyIndex");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramGetKeyIndex - " << paramHandle << " ...";
 #       endif
@@ -2149,6 +2352,7 @@ namespace OFX {
       static OfxStatus paramDeleteKey(OfxParamHandle  paramHandle,
                                       OfxTime time)
       {
+        SuiteProfile::Call profile("paramDeleteKey");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramDeleteKey - " << paramHandle << " ...";
 #       endif
@@ -2177,6 +2381,7 @@ namespace OFX {
       
       static OfxStatus paramDeleteAllKeys(OfxParamHandle  paramHandle) 
       {
+        SuiteProfile::Call profile("paramDeleteAllKeys");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramDeleteAllKeys - " << paramHandle << " ...";
 #       endif
@@ -2207,6 +2412,7 @@ namespace OFX {
                                  OfxParamHandle  paramFrom, 
                                  OfxTime dstOffset, const OfxRangeD *frameRange)
       {
+        SuiteProfile::Call profile("paramCopy");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramCopy - " << paramTo << " ...";
 #       endif
@@ -2230,6 +2436,7 @@ namespace OFX {
       
       static OfxStatus paramEditBegin(OfxParamSetHandle paramSet, const char *name)
       {
+        SuiteProfile::Call profile("paramEditBegin");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramEditBegin - " << paramSet << ' ' << name << " ...";
 #       endif
@@ -2249,6 +2456,7 @@ namespace OFX {
 
       
       static OfxStatus paramEditEnd(OfxParamSetHandle paramSet) {
+        SuiteProfile::Call profile("paramEditEnd");
 #       ifdef OFX_DEBUG_PARAMETERS
         std::cout << "OFX: paramEditEnd - " << paramSet << " ...";
 #       endif
@@ -2294,6 +2502,101 @@ namespace OFX {
         return NULL;
       }
 
+      /// get a param's values at an array of times, the body shared by both batch functions, which do their own profiling
+      static OfxStatus GetValuesAtTimes(Instance *paramInstance,
+                                        const OfxTime *times,
+                                        int nTimes,
+                                        double *values)
+      {
+        if(nTimes <= 0)
+          return kOfxStatOK;
+        if(!times || !values)
+          return kOfxStatErrValue;
+        try {
+          return paramInstance->getValuesAtTimes(times, nTimes, values);
+        }
+        catch(...) {
+          return kOfxStatErrUnknown;
+        }
+      }
+
+      /// get the param's values at an array of times
+      static OfxStatus paramGetValuesAtTimes(OfxParamHandle  paramHandle,
+                                             const OfxTime *times,
+                                             int nTimes,
+                                             double *values)
+      {
+        SuiteProfile::Call profile("paramGetValuesAtTimes");
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << "OFX: paramGetValuesAtTimes - " << paramHandle << ' ' << nTimes << " ...";
+#       endif
+        Instance *paramInstance = reinterpret_cast<Instance*>(paramHandle);
+        if(!paramInstance || !paramInstance->verifyMagic()) {
+#         ifdef OFX_DEBUG_PARAMETERS
+          std::cout << ' ' << StatStr(kOfxStatErrBadHandle) << std::endl;
+#         endif
+          return kOfxStatErrBadHandle;
+        }
+
+        OfxStatus stat = GetValuesAtTimes(paramInstance, times, nTimes, values);
+
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << ' ' << StatStr(stat) << std::endl;
+#       endif
+        return stat;
+      }
+
+      /// how many times paramGetValuesOverRange evaluates at once, from a buffer on the stack
+      static const int kRangeBlockSize = 64;
+
+      /// get the param's values at evenly spaced times
+      static OfxStatus paramGetValuesOverRange(OfxParamHandle  paramHandle,
+                                               OfxTime start,
+                                               OfxTime step,
+                                               int nTimes,
+                                               double *values)
+      {
+        SuiteProfile::Call profile("paramGetValuesOverRange");
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << "OFX: paramGetValuesOverRange - " << paramHandle << ' ' << nTimes << " ...";
+#       endif
+        Instance *paramInstance = reinterpret_cast<Instance*>(paramHandle);
+        if(!paramInstance || !paramInstance->verifyMagic()) {
+#         ifdef OFX_DEBUG_PARAMETERS
+          std::cout << ' ' << StatStr(kOfxStatErrBadHandle) << std::endl;
+#         endif
+          return kOfxStatErrBadHandle;
+        }
+
+        // each time fills as many values as the param's default has
+        int nDims = paramInstance->getProperties().getDimension(kOfxParamPropDefault);
+
+        OfxStatus stat = kOfxStatOK;
+        OfxTime times[kRangeBlockSize];
+        for(int first = 0; first < nTimes && stat == kOfxStatOK; first += kRangeBlockSize) {
+          int n = nTimes - first < kRangeBlockSize ? nTimes - first : kRangeBlockSize;
+          for(int i = 0; i < n; ++i)
+            times[i] = start + (first + i) * step;
+          stat = GetValuesAtTimes(paramInstance, times, n, values ? values + first * nDims : 0);
+        }
+
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << ' ' << StatStr(stat) << std::endl;
+#       endif
+        return stat;
+      }
+
+      static const OfxParameterBatchSuiteV1 gParamBatchSuiteV1 = {
+        paramGetValuesAtTimes,
+        paramGetValuesOverRange
+      };
+
+      const void *GetBatchSuite(int version) {
+        if(version ==1)
+          return &gParamBatchSuiteV1;
+        return NULL;
+      }
+
     } // Param
 
   } // Host
@@ -0,0 +1,860 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <math.h>
+
+#include <algorithm>
+
+// ofx
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+
+// ofx host
+#include "ofxhPropertySuite.h"
+#include "ofxhParam.h"
+#include "ofxhImageEffect.h"
+#include "ofxhParamAnimation.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace Param {
+
+      /// keys closer together than this are at the same time
+      static const double kKeyTimeTolerance = 1e-6;
+
+      /// orders keys on time
+      static bool KeyBefore(const Keyframe &key, OfxTime time)
+      {
+        return key.time < time;
+      }
+
+      /// orders keys on time
+      static bool TimeBefore(OfxTime time, const Keyframe &key)
+      {
+        return time < key.time;
+      }
+
+      //
+      // Curve
+      //
+
+      Curve::Curve(double value, InterpolationEnum interpolation)
+        : _value(value)
+        , _defaultInterpolation(interpolation)
+        , _lastSegment(0)
+      {
+      }
+
+      Curve::Curve(const Curve &other)
+        : _keys(other._keys)
+        , _segments(other._segments)
+        , _integrals(other._integrals)
+        , _value(other._value)
+        , _defaultInterpolation(other._defaultInterpolation)
+        , _lastSegment(0)
+      {
+      }
+
+      Curve &Curve::operator=(const Curve &other)
+      {
+        _keys = other._keys;
+        _segments = other._segments;
+        _integrals = other._integrals;
+        _value = other._value;
+        _defaultInterpolation = other._defaultInterpolation;
+        _lastSegment = 0;
+        return *this;
+      }
+
+      void Curve::getSlopes(int nth, double &in, double &out) const
+      {
+        const Keyframe &key = _keys[nth];
+        int nKeys = (int)_keys.size();
+        bool first = nth == 0;
+        bool last = nth == nKeys - 1;
+
+        // slopes of the straight lines to the neighbouring keys
+        double before = first ? 0 : (key.value - _keys[nth-1].value) / (key.time - _keys[nth-1].time);
+        double after  = last  ? 0 : (_keys[nth+1].value - key.value) / (_keys[nth+1].time - key.time);
+
+        switch(key.interpolation) {
+        case eInterpolationConstant :
+          in = out = 0;
+          break;
+        case eInterpolationLinear :
+          in = first ? after : before;
+          out = last ? before : after;
+          break;
+        case eInterpolationSmooth :
+          if(first || last || (before > 0) != (after > 0) || before == 0 || after == 0)
+            in = out = 0; // flatten the ends and local extremes so we never overshoot
+          else
+            in = out = (_keys[nth+1].value - _keys[nth-1].value) / (_keys[nth+1].time - _keys[nth-1].time);
+          break;
+        case eInterpolationCatmullRom :
+          if(first)
+            in = out = after;
+          else if(last)
+            in = out = before;
+          else
+            in = out = (_keys[nth+1].value - _keys[nth-1].value) / (_keys[nth+1].time - _keys[nth-1].time);
+          break;
+        case eInterpolationBezier :
+          in = key.inSlope;
+          out = key.outSlope;
+          break;
+        }
+      }
+
+      void Curve::rebuild()
+      {
+        int nKeys = (int)_keys.size();
+        _segments.resize(nKeys > 1 ? nKeys - 1 : 0);
+        _integrals.resize(nKeys);
+        _lastSegment = 0;
+        if(nKeys == 0)
+          return;
+
+        _integrals[0] = 0;
+        for(int i = 0; i < nKeys - 1; ++i) {
+          const Keyframe &k0 = _keys[i];
+          const Keyframe &k1 = _keys[i+1];
+          double duration = k1.time - k0.time;
+          Segment &s = _segments[i];
+          s.invDuration = 1.0 / duration;
+          s.a = k0.value;
+
+          if(k0.interpolation == eInterpolationConstant) {
+            s.b = s.c = s.d = 0;
+          }
+          else if(k0.interpolation == eInterpolationLinear) {
+            s.b = k1.value - k0.value;
+            s.c = s.d = 0;
+          }
+          else {
+            // hermite cubic, with the slopes scaled to the segment
+            double in0, out0, in1, out1;
+            getSlopes(i, in0, out0);
+            getSlopes(i + 1, in1, out1);
+            double m0 = out0 * duration;
+            double m1 = in1 * duration;
+            double dv = k1.value - k0.value;
+            s.b = m0;
+            s.c = 3 * dv - 2 * m0 - m1;
+            s.d = -2 * dv + m0 + m1;
+          }
+
+          // integral of the segment over the whole of u, scaled back to time
+          _integrals[i+1] = _integrals[i] + duration * (s.a + s.b / 2 + s.c / 3 + s.d / 4);
+        }
+      }
+
+      int Curve::findSegment(OfxTime time) const
+      {
+        int nSegments = (int)_segments.size();
+
+        // sequential evaluations usually land in the same or the next segment
+        int last = _lastSegment.load(std::memory_order_relaxed);
+        if(last < nSegments && _keys[last].time <= time) {
+          if(time < _keys[last+1].time)
+            return last;
+          if(last + 1 < nSegments && time < _keys[last+2].time) {
+            _lastSegment.store(last + 1, std::memory_order_relaxed);
+            return last + 1;
+          }
+        }
+
+        std::vector<Keyframe>::const_iterator i = std::upper_bound(_keys.begin(), _keys.end(), time, TimeBefore);
+        int segment = int(i - _keys.begin()) - 1;
+        segment = std::max(0, std::min(segment, nSegments - 1));
+        _lastSegment.store(segment, std::memory_order_relaxed);
+        return segment;
+      }
+
+      void Curve::setKey(OfxTime time, double value)
+      {
+        Keyframe key;
+        key.time = time;
+        key.value = value;
+        key.interpolation = _defaultInterpolation;
+        key.inSlope = key.outSlope = 0;
+
+        // keep the interpolation of a key being replaced
+        std::vector<Keyframe>::iterator i = std::lower_bound(_keys.begin(), _keys.end(), time - kKeyTimeTolerance, KeyBefore);
+        if(i != _keys.end() && fabs(i->time - time) <= kKeyTimeTolerance) {
+          key.interpolation = i->interpolation;
+          key.inSlope = i->inSlope;
+          key.outSlope = i->outSlope;
+        }
+        setKey(key);
+      }
+
+      void Curve::setKey(const Keyframe &key)
+      {
+        std::vector<Keyframe>::iterator i = std::lower_bound(_keys.begin(), _keys.end(), key.time - kKeyTimeTolerance, KeyBefore);
+        if(i != _keys.end() && fabs(i->time - key.time) <= kKeyTimeTolerance)
+          *i = key;
+        else
+          _keys.insert(i, key);
+        rebuild();
+      }
+
+      double Curve::getValue(OfxTime time) const
+      {
+        size_t nKeys = _keys.size();
+        if(nKeys == 0)
+          return _value;
+        if(time <= _keys.front().time)
+          return _keys.front().value;
+        if(time >= _keys.back().time)
+          return _keys.back().value;
+
+        int i = findSegment(time);
+        const Segment &s = _segments[i];
+        double u = (time - _keys[i].time) * s.invDuration;
+        return s.a + u * (s.b + u * (s.c + u * s.d));
+      }
+
+      void Curve::getValues(const OfxTime *times, int nTimes, double *values, int stride) const
+      {
+        if(_keys.empty()) {
+          for(int i = 0; i < nTimes; ++i)
+            values[i * stride] = _value;
+          return;
+        }
+
+        const Keyframe &first = _keys.front();
+        const Keyframe &last = _keys.back();
+        int i = 0;
+        while(i < nTimes) {
+          OfxTime time = times[i];
+          if(time <= first.time) {
+            values[i++ * stride] = first.value;
+            continue;
+          }
+          if(time >= last.time) {
+            values[i++ * stride] = last.value;
+            continue;
+          }
+
+          // gather the run of times that fall in the same segment, then evaluate
+          // it in a branch free loop, sorted times make runs as long as they can be
+          int n = findSegment(time);
+          const Segment &s = _segments[n];
+          OfxTime start = _keys[n].time;
+          OfxTime end = _keys[n+1].time;
+          int runEnd = i + 1;
+          while(runEnd < nTimes && times[runEnd] >= start && times[runEnd] < end)
+            ++runEnd;
+
+          for(int j = i; j < runEnd; ++j) {
+            double u = (times[j] - start) * s.invDuration;
+            values[j * stride] = s.a + u * (s.b + u * (s.c + u * s.d));
+          }
+          i = runEnd;
+        }
+      }
+
+      double Curve::getDerivative(OfxTime time) const
+      {
+        size_t nKeys = _keys.size();
+        if(nKeys < 2 || time < _keys.front().time || time >= _keys.back().time)
+          return 0;
+
+        int i = findSegment(time);
+        const Segment &s = _segments[i];
+        double u = (time - _keys[i].time) * s.invDuration;
+        return (s.b + u * (2 * s.c + u * 3 * s.d)) * s.invDuration;
+      }
+
+      double Curve::getIntegral(OfxTime time1, OfxTime time2) const
+      {
+        if(_keys.empty())
+          return _value * (time2 - time1);
+
+        return getPrimitive(time2) - getPrimitive(time1);
+      }
+
+      double Curve::getPrimitive(OfxTime time) const
+      {
+        const Keyframe &first = _keys.front();
+        const Keyframe &last = _keys.back();
+        if(time <= first.time)
+          return (time - first.time) * first.value;
+        if(time >= last.time)
+          return _integrals.back() + (time - last.time) * last.value;
+
+        int i = findSegment(time);
+        const Segment &s = _segments[i];
+        double u = (time - _keys[i].time) * s.invDuration;
+        return _integrals[i] + u * (s.a + u * (s.b / 2 + u * (s.c / 3 + u * s.d / 4))) / s.invDuration;
+      }
+
+      OfxStatus Curve::getKeyTime(int nth, OfxTime &time) const
+      {
+        if(nth < 0 || nth >= (int)_keys.size())
+          return kOfxStatErrBadIndex;
+        time = _keys[nth].time;
+        return kOfxStatOK;
+      }
+
+      OfxStatus Curve::getKeyIndex(OfxTime time, int direction, int &index) const
+      {
+        index = -1;
+        if(direction == 0) {
+          std::vector<Keyframe>::const_iterator i = std::lower_bound(_keys.begin(), _keys.end(), time - kKeyTimeTolerance, KeyBefore);
+          if(i != _keys.end() && fabs(i->time - time) <= kKeyTimeTolerance)
+            index = int(i - _keys.begin());
+        }
+        else if(direction < 0) {
+          // last key strictly before the time
+          std::vector<Keyframe>::const_iterator i = std::lower_bound(_keys.begin(), _keys.end(), time - kKeyTimeTolerance, KeyBefore);
+          index = int(i - _keys.begin()) - 1;
+        }
+        else {
+          // first key strictly after the time
+          std::vector<Keyframe>::const_iterator i = std::upper_bound(_keys.begin(), _keys.end(), time + kKeyTimeTolerance, TimeBefore);
+          if(i != _keys.end())
+            index = int(i - _keys.begin());
+        }
+        return index >= 0 ? kOfxStatOK : kOfxStatFailed;
+      }
+
+      OfxStatus Curve::deleteKey(OfxTime time)
+      {
+        int index;
+        if(getKeyIndex(time, 0, index) != kOfxStatOK)
+          return kOfxStatErrBadIndex;
+
+        // the curve holds its last value when it stops animating
+        if(_keys.size() == 1)
+          _value = _keys[0].value;
+        _keys.erase(_keys.begin() + index);
+        rebuild();
+        return kOfxStatOK;
+      }
+
+      OfxStatus Curve::deleteAllKeys()
+      {
+        if(!_keys.empty())
+          _value = getValue(_keys.front().time);
+        _keys.clear();
+        rebuild();
+        return kOfxStatOK;
+      }
+
+      OfxTime GetCurrentTime(Instance &param)
+      {
+        ImageEffect::Instance *effect = dynamic_cast<ImageEffect::Instance *>(param.getParamSetInstance());
+        return effect ? effect->getFrameRecursive() : 0;
+      }
+
+      /// round an animated value to the nearest int
+      static int Round(double v)
+      {
+        return (int)floor(v + 0.5);
+      }
+
+      //
+      // AnimatedIntegerInstance
+      //
+
+      AnimatedIntegerInstance::AnimatedIntegerInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<IntegerInstance>(descriptor, instance, 1, eInterpolationLinear)
+      {
+      }
+
+      OfxStatus AnimatedIntegerInstance::get(int &v)
+      {
+        return get(GetCurrentTime(*this), v);
+      }
+
+      OfxStatus AnimatedIntegerInstance::get(OfxTime time, int &v)
+      {
+        v = Round(_curves[0].getValue(time));
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedIntegerInstance::set(int v)
+      {
+        setCurrent(0, v);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedIntegerInstance::set(OfxTime time, int v)
+      {
+        _curves[0].setKey(time, v);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedIntegerInstance::derive(OfxTime time, int &v)
+      {
+        v = Round(_curves[0].getDerivative(time));
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedIntegerInstance::integrate(OfxTime time1, OfxTime time2, int &v)
+      {
+        v = Round(_curves[0].getIntegral(time1, time2));
+        return kOfxStatOK;
+      }
+
+      //
+      // AnimatedChoiceInstance
+      //
+
+      AnimatedChoiceInstance::AnimatedChoiceInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<ChoiceInstance>(descriptor, instance, 1, eInterpolationConstant)
+      {
+      }
+
+      OfxStatus AnimatedChoiceInstance::get(int &v)
+      {
+        return get(GetCurrentTime(*this), v);
+      }
+
+      OfxStatus AnimatedChoiceInstance::get(OfxTime time, int &v)
+      {
+        v = Round(_curves[0].getValue(time));
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedChoiceInstance::set(int v)
+      {
+        setCurrent(0, v);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedChoiceInstance::set(OfxTime time, int v)
+      {
+        _curves[0].setKey(time, v);
+        return kOfxStatOK;
+      }
+
+      //
+      // AnimatedBooleanInstance
+      //
+
+      AnimatedBooleanInstance::AnimatedBooleanInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<BooleanInstance>(descriptor, instance, 1, eInterpolationConstant)
+      {
+      }
+
+      OfxStatus AnimatedBooleanInstance::get(bool &v)
+      {
+        return get(GetCurrentTime(*this), v);
+      }
+
+      OfxStatus AnimatedBooleanInstance::get(OfxTime time, bool &v)
+      {
+        v = _curves[0].getValue(time) != 0;
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedBooleanInstance::set(bool v)
+      {
+        setCurrent(0, v ? 1 : 0);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedBooleanInstance::set(OfxTime time, bool v)
+      {
+        _curves[0].setKey(time, v ? 1 : 0);
+        return kOfxStatOK;
+      }
+
+      //
+      // AnimatedDoubleInstance
+      //
+
+      AnimatedDoubleInstance::AnimatedDoubleInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<DoubleInstance>(descriptor, instance, 1, eInterpolationSmooth)
+      {
+      }
+
+      OfxStatus AnimatedDoubleInstance::get(double &v)
+      {
+        return get(GetCurrentTime(*this), v);
+      }
+
+      OfxStatus AnimatedDoubleInstance::get(OfxTime time, double &v)
+      {
+        v = _curves[0].getValue(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDoubleInstance::set(double v)
+      {
+        setCurrent(0, v);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDoubleInstance::set(OfxTime time, double v)
+      {
+        _curves[0].setKey(time, v);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDoubleInstance::derive(OfxTime time, double &v)
+      {
+        v = _curves[0].getDerivative(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDoubleInstance::integrate(OfxTime time1, OfxTime time2, double &v)
+      {
+        v = _curves[0].getIntegral(time1, time2);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDoubleInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        return getCurveValues(times, nTimes, values);
+      }
+
+      //
+      // AnimatedDouble2DInstance
+      //
+
+      AnimatedDouble2DInstance::AnimatedDouble2DInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<Double2DInstance>(descriptor, instance, 2, eInterpolationSmooth)
+      {
+      }
+
+      OfxStatus AnimatedDouble2DInstance::get(double &x, double &y)
+      {
+        return get(GetCurrentTime(*this), x, y);
+      }
+
+      OfxStatus AnimatedDouble2DInstance::get(OfxTime time, double &x, double &y)
+      {
+        x = _curves[0].getValue(time);
+        y = _curves[1].getValue(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble2DInstance::set(double x, double y)
+      {
+        setCurrent(0, x);
+        setCurrent(1, y);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble2DInstance::set(OfxTime time, double x, double y)
+      {
+        _curves[0].setKey(time, x);
+        _curves[1].setKey(time, y);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble2DInstance::derive(OfxTime time, double &x, double &y)
+      {
+        x = _curves[0].getDerivative(time);
+        y = _curves[1].getDerivative(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble2DInstance::integrate(OfxTime time1, OfxTime time2, double &x, double &y)
+      {
+        x = _curves[0].getIntegral(time1, time2);
+        y = _curves[1].getIntegral(time1, time2);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble2DInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        return getCurveValues(times, nTimes, values);
+      }
+
+      //
+      // AnimatedInteger2DInstance
+      //
+
+      AnimatedInteger2DInstance::AnimatedInteger2DInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<Integer2DInstance>(descriptor, instance, 2, eInterpolationLinear)
+      {
+      }
+
+      OfxStatus AnimatedInteger2DInstance::get(int &x, int &y)
+      {
+        return get(GetCurrentTime(*this), x, y);
+      }
+
+      OfxStatus AnimatedInteger2DInstance::get(OfxTime time, int &x, int &y)
+      {
+        x = Round(_curves[0].getValue(time));
+        y = Round(_curves[1].getValue(time));
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedInteger2DInstance::set(int x, int y)
+      {
+        setCurrent(0, x);
+        setCurrent(1, y);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedInteger2DInstance::set(OfxTime time, int x, int y)
+      {
+        _curves[0].setKey(time, x);
+        _curves[1].setKey(time, y);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedInteger2DInstance::derive(OfxTime time, int &x, int &y)
+      {
+        x = Round(_curves[0].getDerivative(time));
+        y = Round(_curves[1].getDerivative(time));
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedInteger2DInstance::integrate(OfxTime time1, OfxTime time2, int &x, int &y)
+      {
+        x = Round(_curves[0].getIntegral(time1, time2));
+        y = Round(_curves[1].getIntegral(time1, time2));
+        return kOfxStatOK;
+      }
+
+      //
+      // AnimatedDouble3DInstance
+      //
+
+      AnimatedDouble3DInstance::AnimatedDouble3DInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<Double3DInstance>(descriptor, instance, 3, eInterpolationSmooth)
+      {
+      }
+
+      OfxStatus AnimatedDouble3DInstance::get(double &x, double &y, double &z)
+      {
+        return get(GetCurrentTime(*this), x, y, z);
+      }
+
+      OfxStatus AnimatedDouble3DInstance::get(OfxTime time, double &x, double &y, double &z)
+      {
+        x = _curves[0].getValue(time);
+        y = _curves[1].getValue(time);
+        z = _curves[2].getValue(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble3DInstance::set(double x, double y, double z)
+      {
+        setCurrent(0, x);
+        setCurrent(1, y);
+        setCurrent(2, z);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble3DInstance::set(OfxTime time, double x, double y, double z)
+      {
+        _curves[0].setKey(time, x);
+        _curves[1].setKey(time, y);
+        _curves[2].setKey(time, z);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble3DInstance::derive(OfxTime time, double &x, double &y, double &z)
+      {
+        x = _curves[0].getDerivative(time);
+        y = _curves[1].getDerivative(time);
+        z = _curves[2].getDerivative(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble3DInstance::integrate(OfxTime time1, OfxTime time2, double &x, double &y, double &z)
+      {
+        x = _curves[0].getIntegral(time1, time2);
+        y = _curves[1].getIntegral(time1, time2);
+        z = _curves[2].getIntegral(time1, time2);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedDouble3DInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        return getCurveValues(times, nTimes, values);
+      }
+
+      //
+      // AnimatedInteger3DInstance
+      //
+
+      AnimatedInteger3DInstance::AnimatedInteger3DInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<Integer3DInstance>(descriptor, instance, 3, eInterpolationLinear)
+      {
+      }
+
+      OfxStatus AnimatedInteger3DInstance::get(int &x, int &y, int &z)
+      {
+        return get(GetCurrentTime(*this), x, y, z);
+      }
+
+      OfxStatus AnimatedInteger3DInstance::get(OfxTime time, int &x, int &y, int &z)
+      {
+        x = Round(_curves[0].getValue(time));
+        y = Round(_curves[1].getValue(time));
+        z = Round(_curves[2].getValue(time));
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedInteger3DInstance::set(int x, int y, int z)
+      {
+        setCurrent(0, x);
+        setCurrent(1, y);
+        setCurrent(2, z);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedInteger3DInstance::set(OfxTime time, int x, int y, int z)
+      {
+        _curves[0].setKey(time, x);
+        _curves[1].setKey(time, y);
+        _curves[2].setKey(time, z);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedInteger3DInstance::derive(OfxTime time, int &x, int &y, int &z)
+      {
+        x = Round(_curves[0].getDerivative(time));
+        y = Round(_curves[1].getDerivative(time));
+        z = Round(_curves[2].getDerivative(time));
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedInteger3DInstance::integrate(OfxTime time1, OfxTime time2, int &x, int &y, int &z)
+      {
+        x = Round(_curves[0].getIntegral(time1, time2));
+        y = Round(_curves[1].getIntegral(time1, time2));
+        z = Round(_curves[2].getIntegral(time1, time2));
+        return kOfxStatOK;
+      }
+
+      //
+      // AnimatedRGBInstance
+      //
+
+      AnimatedRGBInstance::AnimatedRGBInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<RGBInstance>(descriptor, instance, 3, eInterpolationSmooth)
+      {
+      }
+
+      OfxStatus AnimatedRGBInstance::get(double &r, double &g, double &b)
+      {
+        return get(GetCurrentTime(*this), r, g, b);
+      }
+
+      OfxStatus AnimatedRGBInstance::get(OfxTime time, double &r, double &g, double &b)
+      {
+        r = _curves[0].getValue(time);
+        g = _curves[1].getValue(time);
+        b = _curves[2].getValue(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBInstance::set(double r, double g, double b)
+      {
+        setCurrent(0, r);
+        setCurrent(1, g);
+        setCurrent(2, b);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBInstance::set(OfxTime time, double r, double g, double b)
+      {
+        _curves[0].setKey(time, r);
+        _curves[1].setKey(time, g);
+        _curves[2].setKey(time, b);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBInstance::derive(OfxTime time, double &r, double &g, double &b)
+      {
+        r = _curves[0].getDerivative(time);
+        g = _curves[1].getDerivative(time);
+        b = _curves[2].getDerivative(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBInstance::integrate(OfxTime time1, OfxTime time2, double &r, double &g, double &b)
+      {
+        r = _curves[0].getIntegral(time1, time2);
+        g = _curves[1].getIntegral(time1, time2);
+        b = _curves[2].getIntegral(time1, time2);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        return getCurveValues(times, nTimes, values);
+      }
+
+      //
+      // AnimatedRGBAInstance
+      //
+
+      AnimatedRGBAInstance::AnimatedRGBAInstance(Descriptor &descriptor, SetInstance *instance)
+        : AnimatedInstance<RGBAInstance>(descriptor, instance, 4, eInterpolationSmooth)
+      {
+      }
+
+      OfxStatus AnimatedRGBAInstance::get(double &r, double &g, double &b, double &a)
+      {
+        return get(GetCurrentTime(*this), r, g, b, a);
+      }
+
+      OfxStatus AnimatedRGBAInstance::get(OfxTime time, double &r, double &g, double &b, double &a)
+      {
+        r = _curves[0].getValue(time);
+        g = _curves[1].getValue(time);
+        b = _curves[2].getValue(time);
+        a = _curves[3].getValue(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBAInstance::set(double r, double g, double b, double a)
+      {
+        setCurrent(0, r);
+        setCurrent(1, g);
+        setCurrent(2, b);
+        setCurrent(3, a);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBAInstance::set(OfxTime time, double r, double g, double b, double a)
+      {
+        _curves[0].setKey(time, r);
+        _curves[1].setKey(time, g);
+        _curves[2].setKey(time, b);
+        _curves[3].setKey(time, a);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBAInstance::derive(OfxTime time, double &r, double &g, double &b, double &a)
+      {
+        r = _curves[0].getDerivative(time);
+        g = _curves[1].getDerivative(time);
+        b = _curves[2].getDerivative(time);
+        a = _curves[3].getDerivative(time);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBAInstance::integrate(OfxTime time1, OfxTime time2, double &r, double &g, double &b, double &a)
+      {
+        r = _curves[0].getIntegral(time1, time2);
+        g = _curves[1].getIntegral(time1, time2);
+        b = _curves[2].getIntegral(time1, time2);
+        a = _curves[3].getIntegral(time1, time2);
+        return kOfxStatOK;
+      }
+
+      OfxStatus AnimatedRGBAInstance::getValuesAtTimes(const OfxTime *times, int nTimes, double *values)
+      {
+        return getCurveValues(times, nTimes, values);
+      }
+
+    } // namespace Param
+
+  } // namespace Host
+
+} // namespace OFX
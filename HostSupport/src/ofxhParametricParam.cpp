@@ -0,0 +1,548 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <algorithm>
+#include <iostream>
+
+// ofx
+#include "ofxCore.h"
+#include "ofxParam.h"
+#include "ofxParametricParam.h"
+
+// ofx host
+#include "ofxhPropertySuite.h"
+#include "ofxhParam.h"
+#include "ofxhParamAnimation.h"
+#include "ofxhParametricParam.h"
+#include "ofxhUtilities.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace ParametricParam {
+
+      //
+      // ControlPointCurve
+      //
+
+      ControlPointCurve::ControlPointCurve()
+        : _min(0)
+        , _max(1)
+        , _lutValid(false)
+      {
+      }
+
+      ControlPointCurve::ControlPointCurve(const ControlPointCurve &other)
+        : _curve(other._curve)
+        , _min(other._min)
+        , _max(other._max)
+        , _lutValid(false)
+      {
+      }
+
+      ControlPointCurve &ControlPointCurve::operator=(const ControlPointCurve &other)
+      {
+        _curve = other._curve;
+        _min = other._min;
+        _max = other._max;
+        invalidate();
+        return *this;
+      }
+
+      void ControlPointCurve::setRange(double min, double max)
+      {
+        if(min != _min || max != _max) {
+          _min = min;
+          _max = max;
+          invalidate();
+        }
+      }
+
+      void ControlPointCurve::buildLUT() const
+      {
+        std::lock_guard<std::mutex> lock(_lutMutex);
+
+        // another thread may have built it while we waited
+        if(_lutValid.load(std::memory_order_acquire))
+          return;
+
+        std::vector<OfxTime> positions(kLUTSize + 1);
+        double step = (_max - _min) / kLUTSize;
+        for(int i = 0; i < kLUTSize; ++i)
+          positions[i] = _min + i * step;
+        positions[kLUTSize] = _max;
+
+        _lut.resize(kLUTSize + 1);
+        _curve.getValues(&positions[0], kLUTSize + 1, &_lut[0]);
+        _lutValid.store(true, std::memory_order_release);
+      }
+
+      double ControlPointCurve::getValue(double position) const
+      {
+        if(!(position >= _min && position <= _max && _max > _min))
+          return _curve.getValue(position);
+
+        if(!_lutValid.load(std::memory_order_acquire))
+          buildLUT();
+
+        double x = (position - _min) * (kLUTSize / (_max - _min));
+        int i = std::min((int)x, kLUTSize - 1);
+        double f = x - i;
+        return _lut[i] + f * (_lut[i+1] - _lut[i]);
+      }
+
+      OfxStatus ControlPointCurve::getNthControlPoint(int nth, double &key, double &value) const
+      {
+        if(nth < 0 || nth >= getNControlPoints())
+          return kOfxStatErrBadIndex;
+        const Param::Keyframe &k = _curve.getKeys()[nth];
+        key = k.time;
+        value = k.value;
+        return kOfxStatOK;
+      }
+
+      OfxStatus ControlPointCurve::setNthControlPoint(int nth, double key, double value)
+      {
+        OfxTime time;
+        OfxStatus stat = _curve.getKeyTime(nth, time);
+        if(stat != kOfxStatOK)
+          return stat;
+        _curve.deleteKey(time);
+        _curve.setKey(key, value);
+        invalidate();
+        return kOfxStatOK;
+      }
+
+      OfxStatus ControlPointCurve::addControlPoint(double key, double value)
+      {
+        _curve.setKey(key, value);
+        invalidate();
+        return kOfxStatOK;
+      }
+
+      OfxStatus ControlPointCurve::deleteControlPoint(int nth)
+      {
+        OfxTime time;
+        OfxStatus stat = _curve.getKeyTime(nth, time);
+        if(stat != kOfxStatOK)
+          return stat;
+        _curve.deleteKey(time);
+        invalidate();
+        return kOfxStatOK;
+      }
+
+      void ControlPointCurve::deleteAllControlPoints()
+      {
+        _curve.deleteAllKeys();
+        invalidate();
+      }
+
+      //
+      // ParametricDescriptor
+      //
+
+      ParametricDescriptor::ParametricDescriptor(const std::string &type, const std::string &name)
+        : Param::Descriptor(type, name)
+      {
+      }
+
+      ControlPointCurve *ParametricDescriptor::getCurve(int curveIndex)
+      {
+        // the plugin may set the dimension after defining the param, so grow to it here
+        int dimension = _properties.getIntProperty(kOfxParamPropParametricDimension);
+        if(curveIndex < 0 || curveIndex >= dimension)
+          return 0;
+        if((int)_curves.size() < dimension)
+          _curves.resize(dimension);
+        return &_curves[curveIndex];
+      }
+
+      //
+      // ParametricInstance
+      //
+
+      ParametricInstance::ParametricInstance(Param::Descriptor &descriptor, Param::SetInstance *instance)
+        : Param::Instance(descriptor, instance)
+      {
+        int dimension = _properties.getIntProperty(kOfxParamPropParametricDimension);
+
+        // start off with the control points set in describe
+        ParametricDescriptor *parametricDescriptor = dynamic_cast<ParametricDescriptor *>(&descriptor);
+        for(int i = 0; i < dimension; ++i) {
+          ControlPointCurve *curve = parametricDescriptor ? parametricDescriptor->getCurve(i) : 0;
+          _curves.push_back(curve ? *curve : ControlPointCurve());
+        }
+
+        updateRange();
+        _properties.addNotifyHook(kOfxParamPropParametricRange, this);
+      }
+
+      ControlPointCurve *ParametricInstance::getCurve(int curveIndex)
+      {
+        if(curveIndex < 0 || curveIndex >= (int)_curves.size())
+          return 0;
+        return &_curves[curveIndex];
+      }
+
+      void ParametricInstance::updateRange()
+      {
+        double min = _properties.getDoubleProperty(kOfxParamPropParametricRange, 0);
+        double max = _properties.getDoubleProperty(kOfxParamPropParametricRange, 1);
+        for(size_t i = 0; i < _curves.size(); ++i)
+          _curves[i].setRange(min, max);
+      }
+
+      OfxStatus ParametricInstance::copyFrom(const Param::Instance &instance, OfxTime offset, const OfxRangeD *range)
+      {
+        const ParametricInstance *other = dynamic_cast<const ParametricInstance *>(&instance);
+        if(!other)
+          return Param::Instance::copyFrom(instance, offset, range);
+
+        // the curves do not animate, so the offset and range do not apply
+        _curves = other->_curves;
+        updateRange();
+        return kOfxStatOK;
+      }
+
+      void ParametricInstance::notify(const std::string &name, bool single, int num)
+      {
+        Param::Instance::notify(name, single, num);
+        if(name == kOfxParamPropParametricRange)
+          updateRange();
+      }
+
+      OfxStatus ParametricInstance::getValue(int curveIndex, OfxTime /*time*/, double parametricPosition, double *returnValue)
+      {
+        ControlPointCurve *curve = getCurve(curveIndex);
+        if(!curve)
+          return kOfxStatErrBadIndex;
+        *returnValue = curve->getValue(parametricPosition);
+        return kOfxStatOK;
+      }
+
+      OfxStatus ParametricInstance::getNControlPoints(int curveIndex, double /*time*/, int *returnValue)
+      {
+        ControlPointCurve *curve = getCurve(curveIndex);
+        if(!curve)
+          return kOfxStatErrBadIndex;
+        *returnValue = curve->getNControlPoints();
+        return kOfxStatOK;
+      }
+
+      OfxStatus ParametricInstance::getNthControlPoint(int curveIndex, double /*time*/, int nthCtl, double *key, double *value)
+      {
+        ControlPointCurve *curve = getCurve(curveIndex);
+        if(!curve)
+          return kOfxStatErrBadIndex;
+        return curve->getNthControlPoint(nthCtl, *key, *value);
+      }
+
+      OfxStatus ParametricInstance::setNthControlPoint(int curveIndex, double /*time*/, int nthCtl, double key, double value, bool /*addAnimationKey*/)
+      {
+        ControlPointCurve *curve = getCurve(curveIndex);
+        if(!curve)
+          return kOfxStatErrBadIndex;
+        return curve->setNthControlPoint(nthCtl, key, value);
+      }
+
+      OfxStatus ParametricInstance::addControlPoint(int curveIndex, double /*time*/, double key, double value, bool /*addAnimationKey*/)
+      {
+        ControlPointCurve *curve = getCurve(curveIndex);
+        if(!curve)
+          return kOfxStatErrBadIndex;
+        return curve->addControlPoint(key, value);
+      }
+
+      OfxStatus ParametricInstance::deleteControlPoint(int curveIndex, int nthCtl)
+      {
+        ControlPointCurve *curve = getCurve(curveIndex);
+        if(!curve)
+          return kOfxStatErrBadIndex;
+        return curve->deleteControlPoint(nthCtl);
+      }
+
+      OfxStatus ParametricInstance::deleteAllControlPoints(int curveIndex)
+      {
+        ControlPointCurve *curve = getCurve(curveIndex);
+        if(!curve)
+          return kOfxStatErrBadIndex;
+        curve->deleteAllControlPoints();
+        return kOfxStatOK;
+      }
+
+      //
+      // the parametric param suite
+      //
+
+      /// the handle passed to the suite is either an instance, or a descriptor while the plugin
+      /// is being described, find the descriptor's curve in the latter case
+      static ControlPointCurve *GetDescriptorCurve(Param::Base *param, int curveIndex, OfxStatus &stat)
+      {
+        ParametricDescriptor *descriptor = dynamic_cast<ParametricDescriptor *>(param);
+        if(!descriptor) {
+          stat = kOfxStatErrBadHandle;
+          return 0;
+        }
+        ControlPointCurve *curve = descriptor->getCurve(curveIndex);
+        stat = curve ? kOfxStatOK : kOfxStatErrBadIndex;
+        return curve;
+      }
+
+      static OfxStatus parametricParamGetValue(OfxParamHandle param,
+                                               int curveIndex,
+                                               OfxTime time,
+                                               double parametricPosition,
+                                               double *returnValue)
+      {
+        // no debug output here, this is called per pixel value by colour curve plugins
+        Param::Base *base = reinterpret_cast<Param::Base*>(param);
+        if(!base || !base->verifyMagic() || !returnValue)
+          return kOfxStatErrBadHandle;
+
+        ParametricInstance *instance = dynamic_cast<ParametricInstance *>(base);
+        if(instance) {
+          try {
+            return instance->getValue(curveIndex, time, parametricPosition, returnValue);
+          }
+          catch(...) {
+            return kOfxStatErrUnknown;
+          }
+        }
+
+        OfxStatus stat;
+        ControlPointCurve *curve = GetDescriptorCurve(base, curveIndex, stat);
+        if(curve)
+          *returnValue = curve->getValue(parametricPosition);
+        return stat;
+      }
+
+      static OfxStatus parametricParamGetNControlPoints(OfxParamHandle param,
+                                                        int curveIndex,
+                                                        double time,
+                                                        int *returnValue)
+      {
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << "OFX: parametricParamGetNControlPoints - " << param << ' ' << curveIndex << ' ' << time << " ...";
+#       endif
+        Param::Base *base = reinterpret_cast<Param::Base*>(param);
+        OfxStatus stat = kOfxStatErrBadHandle;
+
+        if(base && base->verifyMagic() && returnValue) {
+          ParametricInstance *instance = dynamic_cast<ParametricInstance *>(base);
+          if(instance) {
+            try {
+              stat = instance->getNControlPoints(curveIndex, time, returnValue);
+            }
+            catch(...) {
+              stat = kOfxStatErrUnknown;
+            }
+          }
+          else {
+            ControlPointCurve *curve = GetDescriptorCurve(base, curveIndex, stat);
+            if(curve)
+              *returnValue = curve->getNControlPoints();
+          }
+        }
+
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << ' ' << StatStr(stat) << std::endl;
+#       endif
+        return stat;
+      }
+
+      static OfxStatus parametricParamGetNthControlPoint(OfxParamHandle param,
+                                                         int curveIndex,
+                                                         double time,
+                                                         int nthCtl,
+                                                         double *key,
+                                                         double *value)
+      {
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << "OFX: parametricParamGetNthControlPoint - " << param << ' ' << curveIndex << ' ' << time << ' ' << nthCtl << " ...";
+#       endif
+        Param::Base *base = reinterpret_cast<Param::Base*>(param);
+        OfxStatus stat = kOfxStatErrBadHandle;
+
+        if(base && base->verifyMagic() && key && value) {
+          ParametricInstance *instance = dynamic_cast<ParametricInstance *>(base);
+          if(instance) {
+            try {
+              stat = instance->getNthControlPoint(curveIndex, time, nthCtl, key, value);
+            }
+            catch(...) {
+              stat = kOfxStatErrUnknown;
+            }
+          }
+          else {
+            ControlPointCurve *curve = GetDescriptorCurve(base, curveIndex, stat);
+            if(curve)
+              stat = curve->getNthControlPoint(nthCtl, *key, *value);
+          }
+        }
+
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << ' ' << StatStr(stat) << std::endl;
+#       endif
+        return stat;
+      }
+
+      static OfxStatus parametricParamSetNthControlPoint(OfxParamHandle param,
+                                                         int curveIndex,
+                                                         double time,
+                                                         int nthCtl,
+                                                         double key,
+                                                         double value,
+                                                         bool addAnimationKey)
+      {
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << "OFX: parametricParamSetNthControlPoint - " << param << ' ' << curveIndex << ' ' << time << ' ' << nthCtl << ' ' << key << ' ' << value << " ...";
+#       endif
+        Param::Base *base = reinterpret_cast<Param::Base*>(param);
+        OfxStatus stat = kOfxStatErrBadHandle;
+
+        if(base && base->verifyMagic()) {
+          ParametricInstance *instance = dynamic_cast<ParametricInstance *>(base);
+          if(instance) {
+            try {
+              stat = instance->setNthControlPoint(curveIndex, time, nthCtl, key, value, addAnimationKey);
+            }
+            catch(...) {
+              stat = kOfxStatErrUnknown;
+            }
+          }
+          else {
+            ControlPointCurve *curve = GetDescriptorCurve(base, curveIndex, stat);
+            if(curve)
+              stat = curve->setNthControlPoint(nthCtl, key, value);
+          }
+        }
+
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << ' ' << StatStr(stat) << std::endl;
+#       endif
+        return stat;
+      }
+
+      static OfxStatus parametricParamAddControlPoint(OfxParamHandle param,
+                                                      int curveIndex,
+                                                      double time,
+                                                      double key,
+                                                      double value,
+                                                      bool addAnimationKey)
+      {
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << "OFX: parametricParamAddControlPoint - " << param << ' ' << curveIndex << ' ' << time << ' ' << key << ' ' << value << " ...";
+#       endif
+        Param::Base *base = reinterpret_cast<Param::Base*>(param);
+        OfxStatus stat = kOfxStatErrBadHandle;
+
+        if(base && base->verifyMagic()) {
+          ParametricInstance *instance = dynamic_cast<ParametricInstance *>(base);
+          if(instance) {
+            try {
+              stat = instance->addControlPoint(curveIndex, time, key, value, addAnimationKey);
+            }
+            catch(...) {
+              stat = kOfxStatErrUnknown;
+            }
+          }
+          else {
+            ControlPointCurve *curve = GetDescriptorCurve(base, curveIndex, stat);
+            if(curve)
+              stat = curve->addControlPoint(key, value);
+          }
+        }
+
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << ' ' << StatStr(stat) << std::endl;
+#       endif
+        return stat;
+      }
+
+      static OfxStatus parametricParamDeleteControlPoint(OfxParamHandle param,
+                                                         int curveIndex,
+                                                         int nthCtl)
+      {
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << "OFX: parametricParamDeleteControlPoint - " << param << ' ' << curveIndex << ' ' << nthCtl << " ...";
+#       endif
+        Param::Base *base = reinterpret_cast<Param::Base*>(param);
+        OfxStatus stat = kOfxStatErrBadHandle;
+
+        if(base && base->verifyMagic()) {
+          ParametricInstance *instance = dynamic_cast<ParametricInstance *>(base);
+          if(instance) {
+            try {
+              stat = instance->deleteControlPoint(curveIndex, nthCtl);
+            }
+            catch(...) {
+              stat = kOfxStatErrUnknown;
+            }
+          }
+          else {
+            ControlPointCurve *curve = GetDescriptorCurve(base, curveIndex, stat);
+            if(curve)
+              stat = curve->deleteControlPoint(nthCtl);
+          }
+        }
+
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << ' ' << StatStr(stat) << std::endl;
+#       endif
+        return stat;
+      }
+
+      static OfxStatus parametricParamDeleteAllControlPoints(OfxParamHandle param,
+                                                             int curveIndex)
+      {
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << "OFX: parametricParamDeleteAllControlPoints - " << param << ' ' << curveIndex << " ...";
+#       endif
+        Param::Base *base = reinterpret_cast<Param::Base*>(param);
+        OfxStatus stat = kOfxStatErrBadHandle;
+
+        if(base && base->verifyMagic()) {
+          ParametricInstance *instance = dynamic_cast<ParametricInstance *>(base);
+          if(instance) {
+            try {
+              stat = instance->deleteAllControlPoints(curveIndex);
+            }
+            catch(...) {
+              stat = kOfxStatErrUnknown;
+            }
+          }
+          else {
+            ControlPointCurve *curve = GetDescriptorCurve(base, curveIndex, stat);
+            if(curve)
+              curve->deleteAllControlPoints();
+          }
+        }
+
+#       ifdef OFX_DEBUG_PARAMETERS
+        std::cout << ' ' << StatStr(stat) << std::endl;
+#       endif
+        return stat;
+      }
+
+      static const OfxParametricParameterSuiteV1 gParametricParameterSuiteV1 = {
+        parametricParamGetValue,
+        parametricParamGetNControlPoints,
+        parametricParamGetNthControlPoint,
+        parametricParamSetNthControlPoint,
+        parametricParamAddControlPoint,
+        parametricParamDeleteControlPoint,
+        parametricParamDeleteAllControlPoints
+      };
+
+      const void *GetSuite(int version) {
+        if(version == 1)
+          return &gParametricParameterSuiteV1;
+        return NULL;
+      }
+
+    } // namespace ParametricParam
+
+  } // namespace Host
+
+} // namespace OFX
@@ -9,6 +9,7 @@
 #include "ofxhBinary.h"
 #include "ofxhPropertySuite.h"
 #include "ofxhUtilities.h"
+#include "ofxhSuiteProfile.h"
 
 #include <iostream>
 #include <string.h>
@@ -757,11 +758,18 @@ namespace OFX {
         return -1;
       }
       
+      /// names of the suite functions of each type, in order of TypeEnum, for profiling
+      static const char *const gPropSetNames[] = {"propSetInt", "propSetDouble", "propSetString", "propSetPointer"};
+      static const char *const gPropSetNNames[] = {"propSetIntN", "propSetDoubleN", "propSetStringN", "propSetPointerN"};
+      static const char *const gPropGetNames[] = {"propGetInt", "propGetDouble", "propGetString", "propGetPointer"};
+      static const char *const gPropGetNNames[] = {"propGetIntN", "propGetDoubleN", "propGetStringN", "propGetPointerN"};
+
       /// static functions for the suite
       template<class T> static OfxStatus propSet(OfxPropertySetHandle properties,
                                                  const char *property,
                                                  int index,
                                                  typename T::APIType value) {          
+        SuiteProfile::Call profile(gPropSetNames[T::typeCode], property);
 #       ifdef OFX_DEBUG_PROPERTIES
         std::cout << "OFX: propSet - " << properties << ' ' << property << "[" << index << "] = " << value << " ...";
 #       endif
@@ -804,6 +812,7 @@ namespace OFX {
                                                 const char *property,
                                                 int count,
                                                 const typename T::APIType *values) {
+        SuiteProfile::Call profile(gPropSetNNames[T::typeCode], property);
 #       ifdef OFX_DEBUG_PROPERTIES
         std::cout << "OFX: propSetN - " << properties << ' ' << property << "[0.." << count-1 << "] = ";
         for (int i = 0; i < count; ++i) {
@@ -852,6 +861,7 @@ namespace OFX {
                                                const char *property,
                                                int index,
                                                typename T::APITypeConstless *value) {
+        SuiteProfile::Call profile(gPropGetNames[T::typeCode], property);
 #       ifdef OFX_DEBUG_PROPERTIES
         std::cout << "OFX: propGet - " << properties << ' ' << property << "[" << index << "] = ...";
 #       endif
@@ -894,6 +904,7 @@ namespace OFX {
                                             const char *property,
                                             int count,
                                             typename T::APITypeConstless *values) {
+        SuiteProfile::Call profile(gPropGetNNames[T::typeCode], property);
 #       ifdef OFX_DEBUG_PROPERTIES
         std::cout << "OFX: propGetN - " << properties << ' ' << property << "[0.." << count-1 << "] = ...";
 #       endif
@@ -938,6 +949,7 @@ namespace OFX {
       
       /// static functions for the suite
       static OfxStatus propReset(OfxPropertySetHandle properties, const char *property) {
+        SuiteProfile::Call profile("propReset", property);
 #       ifdef OFX_DEBUG_PROPERTIES
         std::cout << "OFX: propReset - " << properties << ' ' << property << " ...";
 #       endif
@@ -976,6 +988,7 @@ namespace OFX {
       
       /// static functions for the suite
       static OfxStatus propGetDimension(OfxPropertySetHandle properties, const char *property, int *count) {
+        SuiteProfile::Call profile("propGetDimension", property);
 #       ifdef OFX_DEBUG_PROPERTIES
         std::cout << "OFX: propGetDimension - " << properties << ' ' << property << " ...";
 #       endif
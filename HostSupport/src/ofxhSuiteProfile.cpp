@@ -0,0 +1,312 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <thread>
+#include <unordered_map>
+
+// ofx host
+#include "ofxhSuiteProfile.h"
+
+namespace OFX {
+
+  namespace Host {
+
+    namespace SuiteProfile {
+
+      Profiler *gProfiler = 0;
+
+      /// the action installed on each thread
+      static thread_local Action *gCurrentAction = 0;
+
+      /// ids handed to profilers
+      static std::atomic<unsigned long long> gNextProfilerId(1);
+
+      /// the counts a thread has made for a profiler, guarded by its own mutex,
+      /// which only a report or reset contends for
+      struct Profiler::ThreadTable {
+        struct Counts {
+          Counter action;
+          std::unordered_map<const char *, Counter> functions;   ///< keyed on the suite's own string literals
+          std::unordered_map<std::string, Counter> properties;
+        };
+
+        std::thread::id thread;
+        std::mutex mutex;
+        std::unordered_map<const Action *, Counts> counts;
+        std::string key;  ///< scratch for looking up property names without allocating
+      };
+
+      static double secondsSince(std::chrono::steady_clock::time_point start)
+      {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      }
+
+      /// write a string as a JSON string
+      static void writeJSONString(std::ostream &os, const std::string &s)
+      {
+        os << '"';
+        for(size_t i = 0; i < s.size(); ++i) {
+          unsigned char c = (unsigned char) s[i];
+          if(c == '"' || c == '\\')
+            os << '\\' << c;
+          else if(c < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            os << buf;
+          }
+          else
+            os << c;
+        }
+        os << '"';
+      }
+
+      /// write a map of names to counters as a JSON object
+      static void writeJSONCounters(std::ostream &os, const std::map<std::string, Counter> &counters, const char *indent)
+      {
+        os << '{';
+        const char *separator = "\n";
+        for(std::map<std::string, Counter>::const_iterator i = counters.begin(); i != counters.end(); ++i) {
+          os << separator << indent << "  ";
+          writeJSONString(os, i->first);
+          os << ": {\"calls\": " << i->second.calls << ", \"seconds\": " << i->second.seconds << '}';
+          separator = ",\n";
+        }
+        if(!counters.empty())
+          os << '\n' << indent;
+        os << '}';
+      }
+
+      /// the counters of a map, most called first
+      static std::vector<std::pair<std::string, Counter> > sortByCalls(const std::map<std::string, Counter> &counters)
+      {
+        std::vector<std::pair<std::string, Counter> > sorted(counters.begin(), counters.end());
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](const std::pair<std::string, Counter> &a, const std::pair<std::string, Counter> &b) {
+                           return a.second.calls > b.second.calls;
+                         });
+        return sorted;
+      }
+
+      /// write the most called of a map of counters as a table
+      static void reportCounters(std::ostream &os, const char *title, const std::map<std::string, Counter> &counters, int maxRows)
+      {
+        os << "  " << std::left << std::setw(48) << title
+           << std::right << std::setw(12) << "calls"
+           << std::setw(14) << "total ms"
+           << std::setw(12) << "mean us" << std::endl;
+        std::vector<std::pair<std::string, Counter> > sorted = sortByCalls(counters);
+        for(size_t i = 0; i < sorted.size() && (int) i < maxRows; ++i) {
+          const Counter &c = sorted[i].second;
+          os << "  " << std::left << std::setw(48) << sorted[i].first
+             << std::right << std::setw(12) << c.calls
+             << std::fixed << std::setprecision(3)
+             << std::setw(14) << c.seconds * 1000.0
+             << std::setw(12) << (c.calls ? c.seconds * 1000000.0 / c.calls : 0.0) << std::endl;
+        }
+      }
+
+      Profiler::Profiler()
+        : _id(gNextProfilerId++)
+        , _unattributed(0)
+      {
+        _unattributed = getAction("", "");
+      }
+
+      Profiler::~Profiler()
+      {
+      }
+
+      Profiler::ThreadTable &Profiler::getThreadTable()
+      {
+        static thread_local unsigned long long tlProfilerId = 0;
+        static thread_local ThreadTable *tlTable = 0;
+        if(tlProfilerId != _id) {
+          std::lock_guard<std::mutex> lock(_mutex);
+          std::thread::id self = std::this_thread::get_id();
+          tlTable = 0;
+          for(size_t i = 0; i < _tables.size() && !tlTable; ++i)
+            if(_tables[i]->thread == self)
+              tlTable = _tables[i].get();
+          if(!tlTable) {
+            _tables.push_back(std::unique_ptr<ThreadTable>(new ThreadTable));
+            tlTable = _tables.back().get();
+            tlTable->thread = self;
+          }
+          tlProfilerId = _id;
+        }
+        return *tlTable;
+      }
+
+      Action *Profiler::getAction(const std::string &pluginId, const char *action)
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::unique_ptr<Action> &slot = _actions[std::make_pair(pluginId, std::string(action ? action : ""))];
+        if(!slot) {
+          slot.reset(new Action);
+          slot->profiler = this;
+          slot->pluginId = pluginId;
+          slot->name = action ? action : "";
+        }
+        return slot.get();
+      }
+
+      void Profiler::recordAction(const Action *action, double seconds)
+      {
+        ThreadTable &table = getThreadTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        table.counts[action].action.add(seconds);
+      }
+
+      void Profiler::recordCall(const Action *action, const char *function, const char *property, double seconds)
+      {
+        ThreadTable &table = getThreadTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        ThreadTable::Counts &counts = table.counts[action];
+        counts.functions[function].add(seconds);
+        if(property) {
+          table.key.assign(property);
+          counts.properties[table.key].add(seconds);
+        }
+      }
+
+      void Profiler::reset()
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for(size_t i = 0; i < _tables.size(); ++i) {
+          std::lock_guard<std::mutex> tableLock(_tables[i]->mutex);
+          _tables[i]->counts.clear();
+        }
+      }
+
+      std::vector<ActionProfile> Profiler::getProfiles() const
+      {
+        std::map<std::pair<std::string, std::string>, ActionProfile> merged;
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          for(size_t i = 0; i < _tables.size(); ++i) {
+            std::lock_guard<std::mutex> tableLock(_tables[i]->mutex);
+            for(std::unordered_map<const Action *, ThreadTable::Counts>::const_iterator c = _tables[i]->counts.begin(); c != _tables[i]->counts.end(); ++c) {
+              ActionProfile &profile = merged[std::make_pair(c->first->pluginId, c->first->name)];
+              profile.pluginId = c->first->pluginId;
+              profile.action = c->first->name;
+              profile.actions.add(c->second.action);
+              for(std::unordered_map<const char *, Counter>::const_iterator f = c->second.functions.begin(); f != c->second.functions.end(); ++f)
+                profile.functions[f->first].add(f->second);
+              for(std::unordered_map<std::string, Counter>::const_iterator p = c->second.properties.begin(); p != c->second.properties.end(); ++p)
+                profile.properties[p->first].add(p->second);
+            }
+          }
+        }
+
+        std::vector<ActionProfile> profiles;
+        for(std::map<std::pair<std::string, std::string>, ActionProfile>::const_iterator i = merged.begin(); i != merged.end(); ++i)
+          profiles.push_back(i->second);
+        return profiles;
+      }
+
+      void Profiler::writeJSON(std::ostream &os) const
+      {
+        std::vector<ActionProfile> profiles = getProfiles();
+        os << "{\n  \"plugins\": [";
+        for(size_t i = 0; i < profiles.size(); ++i) {
+          const ActionProfile &p = profiles[i];
+          bool firstOfPlugin = i == 0 || profiles[i - 1].pluginId != p.pluginId;
+          bool lastOfPlugin = i + 1 == profiles.size() || profiles[i + 1].pluginId != p.pluginId;
+          if(firstOfPlugin) {
+            os << (i == 0 ? "\n" : ",\n") << "    {\n      \"id\": ";
+            writeJSONString(os, p.pluginId);
+            os << ",\n      \"actions\": [\n";
+          }
+          else
+            os << ",\n";
+          os << "        {\n          \"name\": ";
+          writeJSONString(os, p.action);
+          os << ",\n          \"calls\": " << p.actions.calls
+             << ",\n          \"seconds\": " << p.actions.seconds
+             << ",\n          \"functions\": ";
+          writeJSONCounters(os, p.functions, "          ");
+          os << ",\n          \"properties\": ";
+          writeJSONCounters(os, p.properties, "          ");
+          os << "\n        }";
+          if(lastOfPlugin)
+            os << "\n      ]\n    }";
+        }
+        if(!profiles.empty())
+          os << "\n  ";
+        os << "]\n}\n";
+      }
+
+      void Profiler::report(std::ostream &os, int maxRows) const
+      {
+        std::vector<ActionProfile> profiles = getProfiles();
+        size_t i = 0;
+        while(i < profiles.size()) {
+          const std::string &pluginId = profiles[i].pluginId;
+          std::map<std::string, Counter> functions, properties;
+          for(; i < profiles.size() && profiles[i].pluginId == pluginId; ++i) {
+            for(std::map<std::string, Counter>::const_iterator f = profiles[i].functions.begin(); f != profiles[i].functions.end(); ++f)
+              functions[f->first].add(f->second);
+            for(std::map<std::string, Counter>::const_iterator p = profiles[i].properties.begin(); p != profiles[i].properties.end(); ++p)
+              properties[p->first].add(p->second);
+          }
+          os << (pluginId.empty() ? "(outside any action)" : pluginId) << std::endl;
+          reportCounters(os, "property", properties, maxRows);
+          reportCounters(os, "suite function", functions, maxRows);
+        }
+      }
+
+      Action *getCurrentAction()
+      {
+        return gCurrentAction;
+      }
+
+      ActionScope::ActionScope(const std::string &pluginId, const char *action)
+        : _previous(gCurrentAction)
+        , _action(0)
+      {
+        Profiler *profiler = gProfiler;
+        if(profiler) {
+          _action = profiler->getAction(pluginId, action);
+          gCurrentAction = _action;
+          _start = std::chrono::steady_clock::now();
+        }
+      }
+
+      ActionScope::~ActionScope()
+      {
+        if(_action) {
+          _action->profiler->recordAction(_action, secondsSince(_start));
+          gCurrentAction = _previous;
+        }
+      }
+
+      ThreadScope::ThreadScope(Action *action)
+        : _previous(gCurrentAction)
+      {
+        gCurrentAction = action;
+      }
+
+      ThreadScope::~ThreadScope()
+      {
+        gCurrentAction = _previous;
+      }
+
+      void Call::finish()
+      {
+        double seconds = secondsSince(_start);
+        Action *action = gCurrentAction;
+        if(!action || action->profiler != _profiler)
+          action = _profiler->getUnattributed();
+        _profiler->recordCall(action, _function, _property, seconds);
+      }
+
+    } // namespace SuiteProfile
+
+  } // namespace Host
+
+} // namespace OFX
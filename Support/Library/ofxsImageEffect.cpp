@@ -121,6 +121,9 @@ namespace OFX {
     OfxProgressSuiteV2    *gProgressSuiteV2 = 0;
     OfxTimeLineSuiteV1    *gTimeLineSuite = 0;
     OfxParametricParameterSuiteV1 *gParametricParameterSuite = 0;
+    OfxParameterBatchSuiteV1 *gParamBatchSuite = 0;
+    OfxAsyncImageFetchSuiteV1 *gAsyncImageFetchSuite = 0;
+    thread_local const int *gRenderAbortFlag = 0;
 #ifdef OFX_SUPPORTS_OPENGLRENDER
     OfxImageEffectOpenGLRenderSuiteV1 *gOpenGLRenderSuite = 0;
 #endif
@@ -130,19 +133,38 @@ namespace OFX {
     EffectDescriptorMap gEffectDescriptors;
   };
 
-  /** @brief map a std::string to a context */
+  /** @brief does a string of the given length match a property value */
+  static bool matches(const char *str, size_t len, const char *value)
+  {
+    return strlen(value) == len && memcmp(str, value, len) == 0;
+  }
+
+  /** @brief map a string to a context, of the given length */
+  ContextEnum mapToContextEnum(const char *s, size_t len)
+  {
+    if(matches(s, len, kOfxImageEffectContextGenerator)) return eContextGenerator;
+    if(matches(s, len, kOfxImageEffectContextFilter)) return eContextFilter;
+    if(matches(s, len, kOfxImageEffectContextTransition)) return eContextTransition;
+    if(matches(s, len, kOfxImageEffectContextPaint)) return eContextPaint;
+    if(matches(s, len, kOfxImageEffectContextGeneral)) return eContextGeneral;
+    if(matches(s, len, kOfxImageEffectContextRetimer)) return eContextRetimer;
+    OFX::Log::error(true, "Unknown image effect context '%.*s'", (int) len, s);
+    throw std::invalid_argument(std::string(s, len));
+  }
+
+  /** @brief map a string to a context */
   ContextEnum mapToContextEnum(const std::string &s)
   {
-    if(s == kOfxImageEffectContextGenerator) return eContextGenerator;
-    if(s == kOfxImageEffectContextFilter) return eContextFilter;
-    if(s == kOfxImageEffectContextTransition) return eContextTransition;
-    if(s == kOfxImageEffectContextPaint) return eContextPaint;
-    if(s == kOfxImageEffectContextGeneral) return eContextGeneral;
-    if(s == kOfxImageEffectContextRetimer) return eContextRetimer;
-    OFX::Log::error(true, "Unknown image effect context '%s'", s.c_str());
-    throw std::invalid_argument(s);
+    return mapToContextEnum(s.data(), s.size());
   }
 
+  /** @brief map a string to a context */
+  ContextEnum mapToContextEnum(const char *s)
+  {
+    return mapToContextEnum(s, strlen(s));
+  }
+
+
   const char* mapContextEnumToStr(ContextEnum context)
   {
     switch (context) {
@@ -196,32 +218,45 @@ namespace OFX {
     return OFX::Message::eMessageReplyFailed;
   }
 
-  /** @brief map a std::string to a context */
+  /** @brief map a string to an instance changed reason, of the given length */
+  InstanceChangeReason mapToInstanceChangedReason(const char *s, size_t len)
+  {
+    if(matches(s, len, kOfxChangePluginEdited)) return eChangePluginEdit;
+    if(matches(s, len, kOfxChangeUserEdited)) return eChangeUserEdit;
+    if(matches(s, len, kOfxChangeTime)) return eChangeTime;
+    OFX::Log::error(true, "Unknown instance changed reason '%.*s'", (int) len, s);
+    throw std::invalid_argument(std::string(s, len));
+  }
+
+  /** @brief map a string to an instance changed reason */
   InstanceChangeReason mapToInstanceChangedReason(const std::string &s)
   {
-    if(s == kOfxChangePluginEdited) return eChangePluginEdit;
-    if(s == kOfxChangeUserEdited) return eChangeUserEdit;
-    if(s == kOfxChangeTime) return eChangeTime;
-    OFX::Log::error(true, "Unknown instance changed reason '%s'", s.c_str());
-    throw std::invalid_argument(s);
+    return mapToInstanceChangedReason(s.data(), s.size());
   }
 
-  /** @brief turns a bit depth string into and enum */
-  BitDepthEnum mapStrToBitDepthEnum(const std::string &str)
+  /** @brief map a string to an instance changed reason */
+  InstanceChangeReason mapToInstanceChangedReason(const char *s)
   {
-    if(str == kOfxBitDepthByte) {
+    return mapToInstanceChangedReason(s, strlen(s));
+  }
+
+
+  /** @brief turns a bit depth string into and enum, of the given length */
+  BitDepthEnum mapStrToBitDepthEnum(const char *str, size_t len)
+  {
+    if(matches(str, len, kOfxBitDepthByte)) {
       return eBitDepthUByte;
     }
-    else if(str == kOfxBitDepthShort) {
+    else if(matches(str, len, kOfxBitDepthShort)) {
       return eBitDepthUShort;
     }
-    else if(str == kOfxBitDepthHalf) {
+    else if(matches(str, len, kOfxBitDepthHalf)) {
       return eBitDepthHalf;
     }
-    else if(str == kOfxBitDepthFloat) {
+    else if(matches(str, len, kOfxBitDepthFloat)) {
       return eBitDepthFloat;
     }
-    else if(str == kOfxBitDepthNone) {
+    else if(matches(str, len, kOfxBitDepthNone)) {
       return eBitDepthNone;
     }
     else {
@@ -229,6 +264,19 @@ namespace OFX {
     }
   }
 
+  /** @brief turns a bit depth string into and enum */
+  BitDepthEnum mapStrToBitDepthEnum(const std::string &str)
+  {
+    return mapStrToBitDepthEnum(str.data(), str.size());
+  }
+
+  /** @brief turns a bit depth string into and enum */
+  BitDepthEnum mapStrToBitDepthEnum(const char *str)
+  {
+    return mapStrToBitDepthEnum(str, strlen(str));
+  }
+
+
   /** @brief turns a bit depth string into and enum */
   const char* mapBitDepthEnumToStr(BitDepthEnum bitDepth)
   {
@@ -251,19 +299,19 @@ namespace OFX {
     }
   }
 
-  /** @brief turns a pixel component string into and enum */
-  PixelComponentEnum mapStrToPixelComponentEnum(const std::string &str)
+  /** @brief turns a pixel component string into and enum, of the given length */
+  PixelComponentEnum mapStrToPixelComponentEnum(const char *str, size_t len)
   {
-    if(str == kOfxImageComponentRGBA) {
+    if(matches(str, len, kOfxImageComponentRGBA)) {
       return ePixelComponentRGBA;
     }
-    else if(str == kOfxImageComponentRGB) {
+    else if(matches(str, len, kOfxImageComponentRGB)) {
       return ePixelComponentRGB;
     }
-    else if(str == kOfxImageComponentAlpha) {
+    else if(matches(str, len, kOfxImageComponentAlpha)) {
       return ePixelComponentAlpha;
     }
-    else if(str == kOfxImageComponentNone) {
+    else if(matches(str, len, kOfxImageComponentNone)) {
       return ePixelComponentNone;
     }
     else {
@@ -271,6 +319,19 @@ namespace OFX {
     }
   }
 
+  /** @brief turns a pixel component string into and enum */
+  PixelComponentEnum mapStrToPixelComponentEnum(const std::string &str)
+  {
+    return mapStrToPixelComponentEnum(str.data(), str.size());
+  }
+
+  /** @brief turns a pixel component string into and enum */
+  PixelComponentEnum mapStrToPixelComponentEnum(const char *str)
+  {
+    return mapStrToPixelComponentEnum(str, strlen(str));
+  }
+
+
   /** @brief turns a pixel component string into and enum */
   const char* mapPixelComponentEnumToStr(PixelComponentEnum pixelComponent)
   {
@@ -289,16 +350,16 @@ namespace OFX {
     }
   }
 
-  /** @brief turns a premultiplication string into and enum */
-  static PreMultiplicationEnum mapStrToPreMultiplicationEnum(const std::string &str)
+  /** @brief turns a premultiplication string into and enum, of the given length */
+  static PreMultiplicationEnum mapStrToPreMultiplicationEnum(const char *str, size_t len)
   {
-    if(str == kOfxImageOpaque) {
+    if(matches(str, len, kOfxImageOpaque)) {
       return eImageOpaque;
     }
-    else if(str == kOfxImagePreMultiplied) {
+    else if(matches(str, len, kOfxImagePreMultiplied)) {
       return eImagePreMultiplied;
     }
-    else if(str == kOfxImageUnPreMultiplied) {
+    else if(matches(str, len, kOfxImageUnPreMultiplied)) {
       return eImageUnPreMultiplied;
     }
     else {
@@ -306,19 +367,25 @@ namespace OFX {
     }
   }
 
-  /** @brief turns a field string into and enum */
-  FieldEnum mapStrToFieldEnum(const std::string &str)
+  /** @brief turns a premultiplication string into and enum */
+  static PreMultiplicationEnum mapStrToPreMultiplicationEnum(const char *str)
   {
-    if(str == kOfxImageFieldNone) {
+    return mapStrToPreMultiplicationEnum(str, strlen(str));
+  }
+
+  /** @brief turns a field string into and enum, of the given length */
+  FieldEnum mapStrToFieldEnum(const char *str, size_t len)
+  {
+    if(matches(str, len, kOfxImageFieldNone)) {
       return eFieldNone;
     }
-    else if(str == kOfxImageFieldBoth) {
+    else if(matches(str, len, kOfxImageFieldBoth)) {
       return eFieldBoth;
     }
-    else if(str == kOfxImageFieldLower) {
+    else if(matches(str, len, kOfxImageFieldLower)) {
       return eFieldLower;
     }
-    else if(str == kOfxImageFieldUpper) {
+    else if(matches(str, len, kOfxImageFieldUpper)) {
       return eFieldUpper;
     }
     else {
@@ -326,6 +393,19 @@ namespace OFX {
     }
   }
 
+  /** @brief turns a field string into and enum */
+  FieldEnum mapStrToFieldEnum(const std::string &str)
+  {
+    return mapStrToFieldEnum(str.data(), str.size());
+  }
+
+  /** @brief turns a field string into and enum */
+  FieldEnum mapStrToFieldEnum(const char *str)
+  {
+    return mapStrToFieldEnum(str, strlen(str));
+  }
+
+
 
   ////////////////////////////////////////////////////////////////////////////////
   // clip descriptor
@@ -785,7 +865,8 @@ namespace OFX {
     _rowBytes         = _imageProps.propGetInt(kOfxImagePropRowBytes, /*throwOnFailure*/false); // not required for OpenCL Images
     _pixelAspectRatio = _imageProps.propGetDouble(kOfxImagePropPixelAspectRatio);;
       
-    std::string str  = _imageProps.propGetString(kOfxImageEffectPropComponents);
+    // the host's own strings, mapped straight to enums without copying
+    const char *str  = _imageProps.propGetCString(kOfxImageEffectPropComponents);
     _pixelComponents = mapStrToPixelComponentEnum(str);
 
     switch (_pixelComponents) {
@@ -807,7 +888,7 @@ namespace OFX {
         break;
     }
 
-    str = _imageProps.propGetString(kOfxImageEffectPropPixelDepth);
+    str = _imageProps.propGetCString(kOfxImageEffectPropPixelDepth);
     _pixelDepth = mapStrToBitDepthEnum(str);
 
     // compute bytes per pixel
@@ -823,7 +904,7 @@ namespace OFX {
     case eBitDepthCustom : _pixelBytes *= 0; break;
     }
 
-    str = _imageProps.propGetString(kOfxImageEffectPropPreMultiplication);
+    str = _imageProps.propGetCString(kOfxImageEffectPropPreMultiplication);
     _preMultiplication =  mapStrToPreMultiplicationEnum(str);
 
     _regionOfDefinition.x1 = _imageProps.propGetInt(kOfxImagePropRegionOfDefinition, 0);
@@ -836,25 +917,25 @@ namespace OFX {
     _bounds.x2 = _imageProps.propGetInt(kOfxImagePropBounds, 2);
     _bounds.y2 = _imageProps.propGetInt(kOfxImagePropBounds, 3);
 
-    str = _imageProps.propGetString(kOfxImagePropField);
-    if(str == kOfxImageFieldNone) {
+    str = _imageProps.propGetCString(kOfxImagePropField);
+    if(strcmp(str, kOfxImageFieldNone) == 0) {
       _field = eFieldNone;
     }
-    else if(str == kOfxImageFieldBoth) {
+    else if(strcmp(str, kOfxImageFieldBoth) == 0) {
       _field = eFieldBoth;
     }
-    else if(str == kOfxImageFieldLower) {
+    else if(strcmp(str, kOfxImageFieldLower) == 0) {
       _field = eFieldLower;
     }
-    else if(str == kOfxImageFieldUpper) {
+    else if(strcmp(str, kOfxImageFieldUpper) == 0) {
       _field = eFieldLower;
     }
     else {
-      OFX::Log::error(true, "Unknown field state '%s' reported on an image", str.c_str());
+      OFX::Log::error(true, "Unknown field state '%s' reported on an image", str);
       _field = eFieldNone;
     }
 
-    _uniqueID = _imageProps.propGetString(kOfxImagePropUniqueIdentifier);
+    _uniqueID = _imageProps.propGetCString(kOfxImagePropUniqueIdentifier);
 
     _renderScale.x = _imageProps.propGetDouble(kOfxImageEffectPropRenderScale, 0);
     _renderScale.y = _imageProps.propGetDouble(kOfxImageEffectPropRenderScale, 1);
@@ -931,6 +1012,16 @@ namespace OFX {
     return (const void *) pix;
   }
 
+  int Image::getRowAlignment(void) const
+  {
+    if(!_pixelData)
+      return 0;
+    // lowest set bit of the base address, the row bytes and a cache line together
+    size_t rowBytes = (size_t) (_rowBytes < 0 ? -_rowBytes : _rowBytes);
+    size_t bits = (size_t) _pixelData | rowBytes | 64;
+    return (int) (bits & (~bits + 1));
+  }
+
   ////////////////////////////////////////////////////////////////////////////////
   // clip instance
 
@@ -961,7 +1052,7 @@ namespace OFX {
   /** @brief get the pixel depth */
   BitDepthEnum Clip::getPixelDepth(void) const
   {
-    std::string str = _clipProps.propGetString(kOfxImageEffectPropPixelDepth);
+    const char *str = _clipProps.propGetCString(kOfxImageEffectPropPixelDepth);
     BitDepthEnum e;
     try {
       e = mapStrToBitDepthEnum(str);
@@ -971,7 +1062,7 @@ namespace OFX {
     }
     // gone wrong ?
     catch(std::invalid_argument&) {
-      OFX::Log::error(true, "Unknown pixel depth property '%s' reported on clip '%s'", str.c_str(), _clipName.c_str());
+      OFX::Log::error(true, "Unknown pixel depth property '%s' reported on clip '%s'", str, _clipName.c_str());
       e = eBitDepthNone;
     }
     return e;
@@ -980,7 +1071,7 @@ namespace OFX {
   /** @brief get the components in the image */
   PixelComponentEnum Clip::getPixelComponents(void) const
   {
-    std::string str = _clipProps.propGetString(kOfxImageEffectPropComponents);
+    const char *str = _clipProps.propGetCString(kOfxImageEffectPropComponents);
     PixelComponentEnum e;
     try {
       e = mapStrToPixelComponentEnum(str);
@@ -990,7 +1081,7 @@ namespace OFX {
     }
     // gone wrong ?
     catch(std::invalid_argument&) {
-      OFX::Log::error(true, "Unknown  pixel component type '%s' reported on clip '%s'", str.c_str(), _clipName.c_str());
+      OFX::Log::error(true, "Unknown  pixel component type '%s' reported on clip '%s'", str, _clipName.c_str());
       e = ePixelComponentNone;
     }
     return e;
@@ -999,7 +1090,7 @@ namespace OFX {
   /** @brief get the number of components in the image */
   int Clip::getPixelComponentCount(void) const
   {
-    std::string str = _clipProps.propGetString(kOfxImageEffectPropComponents);
+    const char *str = _clipProps.propGetCString(kOfxImageEffectPropComponents);
     PixelComponentEnum e;
     try {
       e = mapStrToPixelComponentEnum(str);
@@ -1009,7 +1100,7 @@ namespace OFX {
     }
     // gone wrong ?
     catch(std::invalid_argument&) {
-      OFX::Log::error(true, "Unknown  pixel component type '%s' reported on clip '%s'", str.c_str(), _clipName.c_str());
+      OFX::Log::error(true, "Unknown  pixel component type '%s' reported on clip '%s'", str, _clipName.c_str());
       e = ePixelComponentNone;
     }
 
@@ -1031,7 +1122,7 @@ namespace OFX {
   /** @brief what is the actual pixel depth of the clip */
   BitDepthEnum Clip::getUnmappedPixelDepth(void) const
   {
-    std::string str = _clipProps.propGetString(kOfxImageClipPropUnmappedPixelDepth);
+    const char *str = _clipProps.propGetCString(kOfxImageClipPropUnmappedPixelDepth);
     BitDepthEnum e;
     try {
       e = mapStrToBitDepthEnum(str);
@@ -1041,7 +1132,7 @@ namespace OFX {
     }
     // gone wrong ?
     catch(std::invalid_argument&) {
-      OFX::Log::error(true, "Unknown unmapped pixel depth property '%s' reported on clip '%s'", str.c_str(), _clipName.c_str());
+      OFX::Log::error(true, "Unknown unmapped pixel depth property '%s' reported on clip '%s'", str, _clipName.c_str());
       e = eBitDepthNone;
     }
     return e;
@@ -1050,7 +1141,7 @@ namespace OFX {
   /** @brief what is the component type of the clip */
   PixelComponentEnum Clip::getUnmappedPixelComponents(void) const
   {
-    std::string str = _clipProps.propGetString(kOfxImageClipPropUnmappedComponents);
+    const char *str = _clipProps.propGetCString(kOfxImageClipPropUnmappedComponents);
     PixelComponentEnum e;
     try {
       e = mapStrToPixelComponentEnum(str);
@@ -1060,7 +1151,7 @@ namespace OFX {
     }
     // gone wrong ?
     catch(std::invalid_argument&) {
-      OFX::Log::error(true, "Unknown unmapped pixel component type '%s' reported on clip '%s'", str.c_str(), _clipName.c_str());
+      OFX::Log::error(true, "Unknown unmapped pixel component type '%s' reported on clip '%s'", str, _clipName.c_str());
       e = ePixelComponentNone;
     }
     return e;
@@ -1069,14 +1160,14 @@ namespace OFX {
   /** @brief get the components in the image */
   PreMultiplicationEnum Clip::getPreMultiplication(void) const
   {
-    std::string str = _clipProps.propGetString(kOfxImageEffectPropPreMultiplication);
+    const char *str = _clipProps.propGetCString(kOfxImageEffectPropPreMultiplication);
     PreMultiplicationEnum e;
     try {
       e = mapStrToPreMultiplicationEnum(str);
     }
     // gone wrong ?
     catch(std::invalid_argument&) {
-      OFX::Log::error(true, "Unknown premultiplication type '%s' reported on clip %s!", str.c_str(), _clipName.c_str());
+      OFX::Log::error(true, "Unknown premultiplication type '%s' reported on clip %s!", str, _clipName.c_str());
       e = eImageOpaque;
     }
     return e;
@@ -1085,16 +1176,16 @@ namespace OFX {
   /** @brief which spatial field comes first temporally */
   FieldEnum Clip::getFieldOrder(void) const
   {
-    std::string str = _clipProps.propGetString(kOfxImageClipPropFieldOrder);
+    const char *str = _clipProps.propGetCString(kOfxImageClipPropFieldOrder);
     FieldEnum e;
     try {
       e = mapStrToFieldEnum(str);
       OFX::Log::error(e != eFieldNone && e != eFieldLower && e != eFieldUpper, 
-        "Field order '%s' reported on a clip %s is invalid, it must be none, lower or upper.", str.c_str(), _clipName.c_str());
+        "Field order '%s' reported on a clip %s is invalid, it must be none, lower or upper.", str, _clipName.c_str());
     }
     // gone wrong ?
     catch(std::invalid_argument&) {
-      OFX::Log::error(true, "Unknown field order '%s' reported on a clip %s.", str.c_str(), _clipName.c_str());
+      OFX::Log::error(true, "Unknown field order '%s' reported on a clip %s.", str, _clipName.c_str());
       e = eFieldNone;
     }
     return e;
@@ -1192,6 +1283,66 @@ namespace OFX {
     return new Image(imageHandle);
   }
 
+  /** @brief start fetching an image, with an optional region in canonical coordinates */
+  ImageFetch *Clip::fetchImageAsync(double t, const OfxRectD *bounds)
+  {
+    return new ImageFetch(this, t, bounds);
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  // image being fetched from a clip
+
+  /** @brief hidden constructor, starts the fetch */
+  ImageFetch::ImageFetch(Clip *clip, double t, const OfxRectD *bounds)
+    : _clip(clip)
+    , _time(t)
+    , _hasBounds(bounds != NULL)
+    , _handle(0)
+    , _done(false)
+  {
+    _bounds.x1 = _bounds.y1 = _bounds.x2 = _bounds.y2 = 0;
+    if(bounds)
+      _bounds = *bounds;
+
+    if(OFX::Private::gAsyncImageFetchSuite) {
+      OfxStatus stat = OFX::Private::gAsyncImageFetchSuite->clipStartImageFetch(clip->getHandle(), t, bounds, &_handle);
+      if(stat == kOfxStatErrBadHandle)
+        throwSuiteStatusException(stat);
+      else if(stat != kOfxStatOK)
+        _handle = 0; // fetch it when asked for instead
+    }
+  }
+
+  /** @brief dtor, abandons the fetch if the image has not been got */
+  ImageFetch::~ImageFetch()
+  {
+    if(_handle)
+      OFX::Private::gAsyncImageFetchSuite->clipAbandonImageFetch(_handle);
+  }
+
+  /** @brief wait for the image and return it */
+  Image *ImageFetch::getImage(void)
+  {
+    if(_done)
+      return NULL;
+    _done = true;
+
+    // no fetch started, so fetch it now
+    if(!_handle)
+      return _clip->fetchImage(_time, _hasBounds ? &_bounds : NULL);
+
+    OfxPropertySetHandle imageHandle;
+    OfxStatus stat = OFX::Private::gAsyncImageFetchSuite->clipFinishImageFetch(_handle, &imageHandle);
+    _handle = 0;
+    if(stat == kOfxStatFailed) {
+      return NULL; // not an error, fetched images out of range/region, assume black and transparent
+    }
+    else
+      throwSuiteStatusException(stat);
+
+    return new Image(imageHandle);
+  }
+
 #ifdef OFX_SUPPORTS_OPENGLRENDER
   Texture *Clip::loadTexture(double t, BitDepthEnum format, const OfxRectD *region)
   {
@@ -1226,7 +1377,7 @@ namespace OFX {
     OFX::Validation::validatePluginInstanceProperties(_effectProps);
 
     // fetch the context
-    std::string ctxt = _effectProps.propGetString(kOfxImageEffectPropContext);
+    const char *ctxt = _effectProps.propGetCString(kOfxImageEffectPropContext);
     _context = mapToContextEnum(ctxt);
 
     // the param set daddy-oh
@@ -1409,6 +1560,9 @@ namespace OFX {
   /** @brief does the host want us to abort rendering? */
   bool ImageEffect::abort(void) const
   {
+    // if the host handed the render its abort flag, read that rather than go through the suite
+    if(const int *flag = OFX::Private::gRenderAbortFlag)
+      return OFX::Private::isRenderAbortFlagSet(flag);
     return OFX::Private::gEffectSuite->abort(_effectHandle) != 0;
   }
 
@@ -1909,6 +2063,7 @@ namespace OFX {
         gHostDescription.maxPages                   = hostProps.propGetInt(kOfxParamHostPropMaxPages);
         gHostDescription.pageRowCount               = hostProps.propGetInt(kOfxParamHostPropPageRowColumnCount, 0);
         gHostDescription.pageColumnCount            = hostProps.propGetInt(kOfxParamHostPropPageRowColumnCount, 1);
+        gHostDescription.rowAlignment               = hostProps.propGetInt(kOfxImageEffectHostPropRowAlignment, false);
 
         int numComponents = hostProps.propGetDimension(kOfxImageEffectPropSupportedComponents);
         for(int i=0; i<numComponents; ++i)
@@ -1962,6 +2117,8 @@ namespace OFX {
         gProgressSuiteV2 = (OfxProgressSuiteV2 *)     fetchSuite(kOfxProgressSuite, 2, true);
         gTimeLineSuite   = (OfxTimeLineSuiteV1 *)     fetchSuite(kOfxTimeLineSuite, 1, true);
         gParametricParameterSuite = (OfxParametricParameterSuiteV1*) fetchSuite(kOfxParametricParameterSuite, 1, true);
+        gParamBatchSuite = (OfxParameterBatchSuiteV1*) fetchSuite(kOfxParameterBatchSuite, 1, true);
+        gAsyncImageFetchSuite = (OfxAsyncImageFetchSuiteV1*) fetchSuite(kOfxAsyncImageFetchSuite, 1, true);
 #ifdef OFX_SUPPORTS_OPENGLRENDER
         gOpenGLRenderSuite = (OfxImageEffectOpenGLRenderSuiteV1*) fetchSuite(kOfxOpenGLRenderSuite, 1, true);
 #endif
@@ -2009,6 +2166,8 @@ namespace OFX {
         gMessageSuiteV2 = 0;
         gInteractSuite = 0;
         gParametricParameterSuite = 0;
+        gParamBatchSuite = 0;
+        gAsyncImageFetchSuite = 0;
       }
 
       {
@@ -2124,13 +2283,13 @@ namespace OFX {
       args.renderQualityDraft = inArgs.propGetInt(kOfxImageEffectPropRenderQualityDraft, false) != 0;
 
       args.fieldToRender = eFieldNone;
-      std::string str = inArgs.propGetString(kOfxImageEffectPropFieldToRender);
+      const char *str = inArgs.propGetCString(kOfxImageEffectPropFieldToRender);
       try {
         args.fieldToRender = mapStrToFieldEnum(str);
       }
       catch (std::invalid_argument&) {
         // dud field?
-        OFX::Log::error(true, "Unknown field to render '%s'", str.c_str());
+        OFX::Log::error(true, "Unknown field to render '%s'", str);
 
         // HACK need to throw something to cause a failure
       }
@@ -2147,6 +2306,9 @@ namespace OFX {
       // get the arguments 
       getRenderActionArguments(args, inArgs);
 
+      // make the host's abort flag, if any, visible to abort() on this thread and any we spawn
+      RenderAbortFlagScope abortFlag((const int *) inArgs.propGetPointer(kOfxImageEffectPropRenderAbortFlag, false));
+
       // and call the plugin client render code
       effectInstance->render(args);
     }
@@ -2239,13 +2401,13 @@ namespace OFX {
       args.renderWindow.x2 = inArgs.propGetInt(kOfxImageEffectPropRenderWindow, 2);
       args.renderWindow.y2 = inArgs.propGetInt(kOfxImageEffectPropRenderWindow, 3);
 
-      std::string str = inArgs.propGetString(kOfxImageEffectPropFieldToRender);
+      const char *str = inArgs.propGetCString(kOfxImageEffectPropFieldToRender);
       try {
         args.fieldToRender = mapStrToFieldEnum(str);
       }
       catch (std::invalid_argument&) {
         // dud field?
-        OFX::Log::error(true, "Unknown field to render '%s'", str.c_str());
+        OFX::Log::error(true, "Unknown field to render '%s'", str);
 
         // HACK need to throw something to cause a failure
       }
@@ -2501,7 +2663,7 @@ namespace OFX {
     {
       ImageEffect *effectInstance = retrieveImageEffectPointer(handle);
 
-      std::string reasonStr = inArgs.propGetString(kOfxPropChangeReason);
+      const char *reasonStr = inArgs.propGetCString(kOfxPropChangeReason);
       InstanceChangeReason reason = mapToInstanceChangedReason(reasonStr);
 
       // and call the plugin client code
@@ -2518,26 +2680,26 @@ namespace OFX {
       InstanceChangedArgs args;
 
       // why did it change
-      std::string reasonStr = inArgs.propGetString(kOfxPropChangeReason);
+      const char *reasonStr = inArgs.propGetCString(kOfxPropChangeReason);
       args.reason = mapToInstanceChangedReason(reasonStr);
       args.time = inArgs.propGetDouble(kOfxPropTime);
       args.renderScale.x = inArgs.propGetDouble(kOfxImageEffectPropRenderScale, 0);
       args.renderScale.y = inArgs.propGetDouble(kOfxImageEffectPropRenderScale, 1);
 
       // what changed
-      std::string changedType = inArgs.propGetString(kOfxPropType);
+      const char *changedType = inArgs.propGetCString(kOfxPropType);
       std::string changedName = inArgs.propGetString(kOfxPropName);
 
-      if(changedType == kOfxTypeParameter) {
+      if(strcmp(changedType, kOfxTypeParameter) == 0) {
         // and call the plugin client code
         effectInstance->changedParam(args, changedName);
       }
-      else if(changedType == kOfxTypeClip) {
+      else if(strcmp(changedType, kOfxTypeClip) == 0) {
         // and call the plugin client code
         effectInstance->changedClip(args, changedName);
       }
       else {
-        OFX::Log::error(true, "Instance Changed called with unknown type '%s' of object '%s'", changedType.c_str(), changedName.c_str());
+        OFX::Log::error(true, "Instance Changed called with unknown type '%s' of object '%s'", changedType, changedName.c_str());
       }
     }
 
@@ -2548,7 +2710,7 @@ namespace OFX {
     {
       ImageEffect *effectInstance = retrieveImageEffectPointer(handle);
 
-      std::string reasonStr = inArgs.propGetString(kOfxPropChangeReason);
+      const char *reasonStr = inArgs.propGetCString(kOfxPropChangeReason);
       InstanceChangeReason reason = mapToInstanceChangedReason(reasonStr);
 
       // and call the plugin client code
@@ -2564,8 +2726,8 @@ namespace OFX {
       OfxPropertySetHandle   outArgsRaw,
       const char* plugname)
     {
-      OFX::Log::print("********************************************************************************");
-      OFX::Log::print("START mainEntry (%s for %s)", actionRaw, plugname);
+      OFX_LOG_DEBUG("********************************************************************************");
+      OFX_LOG_DEBUG("START mainEntry (%s for %s)", actionRaw, plugname);
       OFX::Log::indent();
       OfxStatus stat = kOfxStatReplyDefault;
       try {
@@ -2638,7 +2800,7 @@ namespace OFX {
           ImageEffectDescriptor *desc = new ImageEffectDescriptor(handle);
 
           // figure the context and map it to an enum
-          std::string contextStr = inArgs.propGetString(kOfxImageEffectPropContext);
+          const char *contextStr = inArgs.propGetCString(kOfxImageEffectPropContext);
           ContextEnum context = mapToContextEnum(contextStr);
 
           // validate the host
@@ -2660,7 +2822,7 @@ namespace OFX {
           PropertySet effectProps = fetchEffectProps(handle);
 
           // get the context and turn it into an enum
-          std::string str = effectProps.propGetString(kOfxImageEffectPropContext);
+          const char *str = effectProps.propGetCString(kOfxImageEffectPropContext);
           ContextEnum context = mapToContextEnum(str);
 
           // make the image effect instance for this context
@@ -2892,8 +3054,12 @@ namespace OFX {
       }
 
       OFX::Log::outdent();
-      OFX::Log::print("STOP mainEntry (%s for %s, returning %d=%s)\n", actionRaw, plugname,
-                      stat, mapStatusToString(stat));
+      OFX_LOG_DEBUG("STOP mainEntry (%s for %s, returning %d=%s)\n", actionRaw, plugname,
+                    stat, mapStatusToString(stat));
+
+      // stop the log's writer thread once the last plugin is unloaded, before the host unloads the binary
+      if(gLoadCount == 0 && strcmp(actionRaw, kOfxActionUnload) == 0)
+        OFX::Log::close();
       return stat;
     }      
 
@@ -2903,8 +3069,8 @@ namespace OFX {
       OfxPropertySetHandle   inArgsRaw,
       OfxPropertySetHandle   outArgsRaw)
     {
-      OFX::Log::print("********************************************************************************");
-      OFX::Log::print("START customParamInterpolationV1Entry");
+      OFX_LOG_DEBUG("********************************************************************************");
+      OFX_LOG_DEBUG("START customParamInterpolationV1Entry");
       OFX::Log::indent();
       OfxStatus stat = kOfxStatReplyDefault;
       try {
@@ -2984,7 +3150,7 @@ namespace OFX {
       }
 
       OFX::Log::outdent();
-      OFX::Log::print("STOP customParamInterpolationV1Entry\n");
+      OFX_LOG_DEBUG("STOP customParamInterpolationV1Entry\n");
       return stat;
     }
 
@@ -0,0 +1,321 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <limits.h>
+#include <algorithm>
+#include <limits>
+
+#include "ofxsSupportPrivate.h"
+#include "ofxsImageStatistics.h"
+#include "ofxsPixelConversion.h"
+#include "ofxsMultiThread.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define OFXS_IMAGE_STATISTICS_X86
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define OFXS_IMAGE_STATISTICS_INLINE inline __attribute__((always_inline))
+#else
+#  define OFXS_IMAGE_STATISTICS_INLINE inline
+#endif
+
+namespace OFX {
+
+  namespace ImageStatistics {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // lane kernels
+
+    /** @brief Values are folded into lanes, a multiple of the number of components wide, so
+    that each lane only ever sees the one component and the loop over them vectorises.
+    */
+    static const int kMaxLanes = 16;
+
+    /** @brief the lanes for a number of components */
+    static int LaneCount(int nComponents)
+    {
+      return nComponents == 3 ? 12 : 16;
+    }
+
+    /** @brief fold n values into the lanes' minimums, maximums and sums, NaNs are skipped by the comparisons */
+    template <int L>
+    static OFXS_IMAGE_STATISTICS_INLINE void Lanes(const float *v, int n, float *lanesMin, float *lanesMax, float *lanesSum)
+    {
+      // locals, so the compiler knows they do not alias the values
+      float mn[L], mx[L], sum[L];
+      for(int j = 0; j < L; ++j) {
+        mn[j] = lanesMin[j];
+        mx[j] = lanesMax[j];
+        sum[j] = lanesSum[j];
+      }
+
+      int i = 0;
+      for(; i + L <= n; i += L) {
+        for(int j = 0; j < L; ++j) {
+          float x = v[i + j];
+          mn[j] = x < mn[j] ? x : mn[j];
+          mx[j] = x > mx[j] ? x : mx[j];
+          sum[j] += x;
+        }
+      }
+      for(int j = 0; i < n; ++i, ++j) {
+        float x = v[i];
+        mn[j] = x < mn[j] ? x : mn[j];
+        mx[j] = x > mx[j] ? x : mx[j];
+        sum[j] += x;
+      }
+
+      for(int j = 0; j < L; ++j) {
+        lanesMin[j] = mn[j];
+        lanesMax[j] = mx[j];
+        lanesSum[j] = sum[j];
+      }
+    }
+
+    typedef void (*LanesFunction)(const float *v, int n, float *lanesMin, float *lanesMax, float *lanesSum);
+
+    template <int L>
+    static void LanesPortable(const float *v, int n, float *lanesMin, float *lanesMax, float *lanesSum)
+    {
+      Lanes<L>(v, n, lanesMin, lanesMax, lanesSum);
+    }
+
+#ifdef OFXS_IMAGE_STATISTICS_X86
+    template <int L>
+    __attribute__((target("avx2")))
+    static void LanesAVX2(const float *v, int n, float *lanesMin, float *lanesMax, float *lanesSum)
+    {
+      Lanes<L>(v, n, lanesMin, lanesMax, lanesSum);
+    }
+
+    template <int L>
+    __attribute__((target("avx512f")))
+    static void LanesAVX512(const float *v, int n, float *lanesMin, float *lanesMax, float *lanesSum)
+    {
+      Lanes<L>(v, n, lanesMin, lanesMax, lanesSum);
+    }
+#endif
+
+    /** @brief the lane kernel for the instruction set conversions are being done with */
+    template <int L>
+    static LanesFunction PickLanes(void)
+    {
+#ifdef OFXS_IMAGE_STATISTICS_X86
+      switch(PixelConversion::getInstructionSet()) {
+      case PixelConversion::eInstructionSetAVX512 : return LanesAVX512<L>;
+      case PixelConversion::eInstructionSetAVX2 : return LanesAVX2<L>;
+      default : break;
+      }
+#endif
+      return LanesPortable<L>;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // gathering
+
+    /** @brief the number of pixels of a row converted to floats at a time */
+    static const int kChunkPixels = 256;
+
+    /** @brief what is being gathered, and over what */
+    struct Pass {
+      const Image *image;
+      int x1, x2;
+      int nComponents;
+      int pixelBytes;
+      int alphaComponent;   /**< @brief -1 if the pixels have no alpha */
+      Options options;
+      float binScale;       /**< @brief bins per unit value */
+      LanesFunction lanes;
+    };
+
+    /** @brief the statistics gathered by one thread */
+    struct Accumulator {
+      float lanesMin[kMaxLanes];
+      float lanesMax[kMaxLanes];
+      double sum[4];
+      std::vector<long long> histogram;
+      OfxRectI alphaBounds;  /**< @brief x1 > x2 while no pixel with alpha has been seen */
+
+      explicit Accumulator(size_t histogramSize)
+        : histogram(histogramSize, 0)
+      {
+        std::fill(lanesMin, lanesMin + kMaxLanes, std::numeric_limits<float>::infinity());
+        std::fill(lanesMax, lanesMax + kMaxLanes, -std::numeric_limits<float>::infinity());
+        std::fill(sum, sum + 4, 0.);
+        alphaBounds.x1 = alphaBounds.y1 = INT_MAX;
+        alphaBounds.x2 = alphaBounds.y2 = INT_MIN;
+      }
+    };
+
+    /** @brief gather statistics over a chunk of n pixels of row y starting at x */
+    static void GatherChunk(const Pass &pass, const float *v, int n, int x, int y, Accumulator &acc)
+    {
+      int nComponents = pass.nComponents;
+      unsigned int statistics = pass.options.statistics;
+
+      if(statistics & (eStatisticMinMax | eStatisticMean)) {
+        float lanesSum[kMaxLanes] = {0};
+        pass.lanes(v, n * nComponents, acc.lanesMin, acc.lanesMax, lanesSum);
+        int nLanes = LaneCount(nComponents);
+        for(int j = 0; j < nLanes; ++j)
+          acc.sum[j % nComponents] += lanesSum[j];
+      }
+
+      if(statistics & eStatisticHistogram) {
+        int nBins = pass.options.nBins;
+        float low = pass.options.low;
+        float scale = pass.binScale;
+        long long *histogram = &acc.histogram[0];
+        const float *pix = v;
+        for(int p = 0; p < n; ++p, pix += nComponents) {
+          for(int c = 0; c < nComponents; ++c) {
+            float f = (pix[c] - low) * scale;
+            int bin = f > 0.f ? (f < (float) nBins ? (int) f : nBins - 1) : 0;
+            ++histogram[c * nBins + bin];
+          }
+        }
+      }
+
+      if((statistics & eStatisticAlphaBounds) && pass.alphaComponent >= 0) {
+        const float *alpha = v + pass.alphaComponent;
+        int first = 0;
+        while(first < n && alpha[first * nComponents] == 0.f)
+          ++first;
+        if(first < n) {
+          int last = n - 1;
+          while(alpha[last * nComponents] == 0.f)
+            --last;
+          acc.alphaBounds.x1 = std::min(acc.alphaBounds.x1, x + first);
+          acc.alphaBounds.x2 = std::max(acc.alphaBounds.x2, x + last + 1);
+          acc.alphaBounds.y1 = std::min(acc.alphaBounds.y1, y);
+          acc.alphaBounds.y2 = std::max(acc.alphaBounds.y2, y + 1);
+        }
+      }
+    }
+
+    /** @brief gather statistics over some rows */
+    static void GatherRows(const Pass &pass, const MultiThread::Range &rows, Accumulator &acc)
+    {
+      BitDepthEnum depth = pass.image->getPixelDepth();
+      float chunk[kChunkPixels * 4];
+
+      for(int y = rows.begin; y < rows.end; ++y) {
+        const char *src = (const char *) pass.image->getPixelAddress(pass.x1, y);
+        for(int x = pass.x1; x < pass.x2; x += kChunkPixels) {
+          int n = std::min(kChunkPixels, pass.x2 - x);
+          // floats are gathered from in place, anything else is converted first
+          const float *v = (const float *) src;
+          if(depth != eBitDepthFloat) {
+            PixelConversion::convertRow(src, depth, chunk, eBitDepthFloat, n, pass.nComponents);
+            v = chunk;
+          }
+          GatherChunk(pass, v, n, x, y, acc);
+          src += (size_t) n * pass.pixelBytes;
+        }
+      }
+    }
+
+    /** @brief fold the statistics gathered by one thread into another's */
+    static void Combine(Accumulator &result, const Accumulator &partial)
+    {
+      for(int j = 0; j < kMaxLanes; ++j) {
+        result.lanesMin[j] = std::min(result.lanesMin[j], partial.lanesMin[j]);
+        result.lanesMax[j] = std::max(result.lanesMax[j], partial.lanesMax[j]);
+      }
+      for(int c = 0; c < 4; ++c)
+        result.sum[c] += partial.sum[c];
+      for(size_t i = 0; i < result.histogram.size(); ++i)
+        result.histogram[i] += partial.histogram[i];
+      result.alphaBounds.x1 = std::min(result.alphaBounds.x1, partial.alphaBounds.x1);
+      result.alphaBounds.y1 = std::min(result.alphaBounds.y1, partial.alphaBounds.y1);
+      result.alphaBounds.x2 = std::max(result.alphaBounds.x2, partial.alphaBounds.x2);
+      result.alphaBounds.y2 = std::max(result.alphaBounds.y2, partial.alphaBounds.y2);
+    }
+
+    Results compute(const Image &image, const OfxRectI &window, const Options &options)
+    {
+      int nComponents = image.getPixelComponentCount();
+      if(nComponents < 1 || nComponents > 4)
+        throwSuiteStatusException(kOfxStatErrImageFormat);
+
+      int componentBytes = 0;
+      switch(image.getPixelDepth()) {
+      case eBitDepthUByte : componentBytes = 1; break;
+      case eBitDepthUShort :
+      case eBitDepthHalf : componentBytes = 2; break;
+      case eBitDepthFloat : componentBytes = 4; break;
+      default : throwSuiteStatusException(kOfxStatErrUnsupported);
+      }
+
+      Pass pass;
+      pass.image = &image;
+      pass.nComponents = nComponents;
+      pass.pixelBytes = nComponents * componentBytes;
+      pass.alphaComponent = (image.getPixelComponents() == ePixelComponentRGBA ? 3 :
+                             image.getPixelComponents() == ePixelComponentAlpha ? 0 : -1);
+      pass.options = options;
+      pass.options.nBins = std::max(options.nBins, 1);
+      pass.binScale = options.high > options.low ? pass.options.nBins / (options.high - options.low) : 0.f;
+      pass.lanes = nComponents == 3 ? PickLanes<12>() : PickLanes<16>();
+
+      const OfxRectI &bounds = image.getBounds();
+      pass.x1 = std::max(window.x1, bounds.x1);
+      pass.x2 = std::min(window.x2, bounds.x2);
+      int y1 = std::max(window.y1, bounds.y1);
+      int y2 = std::min(window.y2, bounds.y2);
+      if(pass.x1 >= pass.x2 || y1 >= y2) {
+        pass.x2 = pass.x1;
+        y2 = y1;
+      }
+
+      size_t histogramSize = (options.statistics & eStatisticHistogram) ? (size_t) nComponents * pass.options.nBins : 0;
+      Accumulator acc = MultiThread::parallelReduce(MultiThread::Range(y1, y2), Accumulator(histogramSize),
+                                                    [&pass](const MultiThread::Range &rows, Accumulator &partial) {
+                                                      GatherRows(pass, rows, partial);
+                                                    },
+                                                    Combine);
+
+      Results results;
+      results.nComponents = nComponents;
+      results.nPixels = (long long) (pass.x2 - pass.x1) * (y2 - y1);
+      for(int c = 0; c < 4; ++c) {
+        results.min[c] = results.max[c] = 0.f;
+        results.mean[c] = 0.;
+      }
+      if(results.nPixels > 0) {
+        int nLanes = LaneCount(nComponents);
+        for(int c = 0; c < nComponents; ++c) {
+          float mn = std::numeric_limits<float>::infinity();
+          float mx = -mn;
+          for(int j = c; j < nLanes; j += nComponents) {
+            mn = std::min(mn, acc.lanesMin[j]);
+            mx = std::max(mx, acc.lanesMax[j]);
+          }
+          // all NaNs leaves nothing to have a minimum or maximum of
+          results.min[c] = mn <= mx ? mn : 0.f;
+          results.max[c] = mn <= mx ? mx : 0.f;
+          results.mean[c] = acc.sum[c] / results.nPixels;
+        }
+      }
+      results.nBins = pass.options.nBins;
+      results.histogram.swap(acc.histogram);
+
+      if(pass.alphaComponent < 0) {
+        results.alphaBounds.x1 = pass.x1;
+        results.alphaBounds.x2 = pass.x2;
+        results.alphaBounds.y1 = y1;
+        results.alphaBounds.y2 = y2;
+      }
+      else if(acc.alphaBounds.x1 < acc.alphaBounds.x2) {
+        results.alphaBounds = acc.alphaBounds;
+      }
+      else {
+        results.alphaBounds.x1 = results.alphaBounds.x2 = pass.x1;
+        results.alphaBounds.y1 = results.alphaBounds.y2 = y1;
+      }
+      return results;
+    }
+
+  };
+};
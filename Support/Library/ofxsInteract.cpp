@@ -493,8 +493,8 @@ namespace OFX {
       OfxPropertySetHandle    outArgsRaw,
       InteractDescriptor& desc)
     {
-      OFX::Log::print("********************************************************************************");
-      OFX::Log::print("START overlayInteractMainEntry (%s)", actionRaw);
+      OFX_LOG_DEBUG("********************************************************************************");
+      OFX_LOG_DEBUG("START overlayInteractMainEntry (%s)", actionRaw);
       OFX::Log::indent();
       OfxStatus stat = kOfxStatReplyDefault;
 
@@ -538,7 +538,7 @@ namespace OFX {
       }
 
       OFX::Log::outdent();
-      OFX::Log::print("STOP overlayInteractMainEntry (%s)", actionRaw);
+      OFX_LOG_DEBUG("STOP overlayInteractMainEntry (%s)", actionRaw);
       return stat;
     }
 
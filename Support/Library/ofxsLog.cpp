@@ -5,30 +5,235 @@
 
 The log file is written to using printf style functions, rather than via c++ iostreams.
 
+Each thread logging gets a ring buffer of fixed size records the first time it logs. It
+formats its messages straight into the next free record, stamps it with the raw ticks of
+the steady clock and publishes it by moving the ring's head on, with no lock taken. A
+writer thread, started when the file is opened, wakes every so often or when a ring is
+filling up, takes the records from every ring, sorts them by time and writes them out
+with a single fflush. A thread that finds its ring full sleeps until the writer has emptied
+it, rather than drop messages.
 */
 
 #include <cassert>
 #include <cstdio>
 #include <cstdarg>
 #include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "ofxsLog.h"
 
 namespace OFX {
   namespace Log {
 
-    /** @brief log file */
-    static FILE *gLogFP = 0;
-
     /// environment variable for the log file
 #define kLogFileEnvVar "OFX_PLUGIN_LOGFILE"
 
     /** @brief the global logfile name */
     static std::string gLogFileName(getenv(kLogFileEnvVar) ? getenv(kLogFileEnvVar) : "ofxPluginLog.txt");
 
-    /** @brief global indent level, not MP sane */
-    static int gIndent = 0;
+    /** @brief bytes of text in a record, longer messages are cut short */
+    static const int kRecordTextBytes = 240;
+
+    /** @brief records in each thread's ring, a power of two */
+    static const unsigned int kRingRecords = 256;
+
+    /** @brief how often the writer wakes when no ring is filling up */
+    static const std::chrono::milliseconds kWriterPeriod(50);
+
+    /** @brief a logged message */
+    struct Record {
+      long long ticks;            /**< @brief steady clock ticks when it was logged */
+      int thread;                 /**< @brief number of the thread that logged it */
+      short level;                /**< @brief its LevelEnum */
+      short indent;               /**< @brief the thread's indent when it was logged */
+      char text[kRecordTextBytes];
+    };
+
+    /** @brief the records of a thread, written by that thread only and read by the writer only */
+    struct Ring {
+      Record records[kRingRecords];
+      std::atomic<unsigned int> head;   /**< @brief count of records published by the thread */
+      std::atomic<unsigned int> tail;   /**< @brief count of records taken by the writer */
+      std::atomic<bool> retired;        /**< @brief the thread has exited and will publish no more */
+      int thread;
+
+      explicit Ring(int t) : head(0), tail(0), retired(false), thread(t) {}
+    };
+
+    /** @brief the calling thread's ring and indent, the ring is retired when the thread exits, for the writer to free */
+    struct ThreadState {
+      Ring *ring;
+      int indent;
+      bool exited;      /**< @brief the thread is exiting, so anything it logs from now on is dropped */
+
+      ThreadState() : ring(0), indent(0), exited(false) {}
+      ~ThreadState()
+      {
+        if(ring)
+          ring->retired.store(true, std::memory_order_release);
+        ring = 0;
+        exited = true;
+      }
+    };
+
+    static thread_local ThreadState gThreadState;
+
+    /** @brief the rings of all the threads that have logged, guarded by gRingsMutex */
+    static std::vector<Ring *> gRings;
+    static std::mutex gRingsMutex;
+    static int gNextThread = 0;
+
+    /** @brief log file, set under gFileMutex and gDrainMutex, gIsOpen mirrors it for the threads logging */
+    static FILE *gLogFP = 0;
+    static std::atomic<bool> gIsOpen(false);
+    static std::mutex gFileMutex;
+    static long long gOpenTicks = 0;
+
+    /** @brief the writer thread and what it waits on */
+    static std::thread gWriter;
+    static std::mutex gWakeMutex;
+    static std::condition_variable gWake;
+    static bool gStopping = false;
+
+    /** @brief held whilst taking records from the rings and writing them, so only one thread does at a time and the file is not closed under it */
+    static std::mutex gDrainMutex;
+    static std::vector<Record> gDrained;
+
+    /** @brief what a thread with a full ring sleeps on, signalled once the rings have been emptied */
+    static std::mutex gRoomMutex;
+    static std::condition_variable gRoom;
+
+    /** @brief wake the threads waiting for room in their rings */
+    static void signalRoom(void)
+    {
+      // taking the lock orders this after a waiter's last look at its ring, so the wake is not lost
+      { std::lock_guard<std::mutex> lock(gRoomMutex); }
+      gRoom.notify_all();
+    }
+
+    static long long nowTicks(void)
+    {
+      return (long long) std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    /** @brief the calling thread's ring, made on first use, null once the thread's state has been destroyed */
+    static Ring *getRing(void)
+    {
+      if(gThreadState.exited)
+        return 0;
+      if(!gThreadState.ring) {
+        std::lock_guard<std::mutex> lock(gRingsMutex);
+        gThreadState.ring = new Ring(gNextThread++);
+        gRings.push_back(gThreadState.ring);
+      }
+      return gThreadState.ring;
+    }
+
+    /** @brief take every record published so far from the rings, write them in time order and free retired rings */
+    static void drain(void)
+    {
+      std::lock_guard<std::mutex> drainLock(gDrainMutex);
+      gDrained.clear();
+      {
+        std::lock_guard<std::mutex> lock(gRingsMutex);
+        std::vector<Ring *>::iterator it = gRings.begin();
+        while(it != gRings.end()) {
+          Ring *ring = *it;
+          bool retired = ring->retired.load(std::memory_order_acquire);
+          unsigned int head = ring->head.load(std::memory_order_acquire);
+          unsigned int tail = ring->tail.load(std::memory_order_relaxed);
+          for(; tail != head; ++tail)
+            gDrained.push_back(ring->records[tail & (kRingRecords - 1)]);
+          ring->tail.store(tail, std::memory_order_release);
+          if(retired) {
+            delete ring;
+            it = gRings.erase(it);
+          }
+          else
+            ++it;
+        }
+      }
+      signalRoom();
+
+      if(gDrained.empty() || !gLogFP)
+        return;
+
+      std::stable_sort(gDrained.begin(), gDrained.end(),
+                       [](const Record &a, const Record &b) { return a.ticks < b.ticks; });
+
+      const double secondsPerTick = double(std::chrono::steady_clock::period::num) / std::chrono::steady_clock::period::den;
+      for(size_t i = 0; i < gDrained.size(); ++i) {
+        const Record &r = gDrained[i];
+        fprintf(gLogFP, "%12.6f %3d ", (r.ticks - gOpenTicks) * secondsPerTick, r.thread);
+        for(int j = 0; j < r.indent; j++) {
+          fputs("    ", gLogFP);
+        }
+        if(r.level == eLevelWarning)
+          fputs("WARNING : ", gLogFP);
+        else if(r.level == eLevelError)
+          fputs("ERROR : ", gLogFP);
+        fputs(r.text, gLogFP);
+        fputc('\n', gLogFP);
+      }
+      fflush(gLogFP);
+    }
+
+    /** @brief what the writer thread runs */
+    static void writerLoop(void)
+    {
+      std::unique_lock<std::mutex> lock(gWakeMutex);
+      while(!gStopping) {
+        gWake.wait_for(lock, kWriterPeriod);
+        lock.unlock();
+        drain();
+        lock.lock();
+      }
+    }
+
+    /** @brief format a message into the next record of the calling thread's ring and publish it */
+    static void push(LevelEnum level, const char *format, va_list args)
+    {
+      Ring *ring = getRing();
+      if(!ring)
+        return;
+      unsigned int head = ring->head.load(std::memory_order_relaxed);
+
+      // sleep until the writer has emptied the ring if it is full
+      if(head - ring->tail.load(std::memory_order_acquire) >= kRingRecords) {
+        std::unique_lock<std::mutex> lock(gRoomMutex);
+        while(head - ring->tail.load(std::memory_order_acquire) >= kRingRecords) {
+          if(!gIsOpen.load(std::memory_order_acquire))
+            return;
+          gWake.notify_one();
+          gRoom.wait(lock);
+        }
+      }
+
+      Record &r = ring->records[head & (kRingRecords - 1)];
+      r.ticks = nowTicks();
+      r.thread = ring->thread;
+      r.level = (short) level;
+      r.indent = (short) std::max(gThreadState.indent, 0);
+      int n = vsnprintf(r.text, kRecordTextBytes, format, args);
+      if(n >= kRecordTextBytes)
+        memcpy(r.text + kRecordTextBytes - 4, "...", 4);
+      else if(n < 0)
+        r.text[0] = 0;
+      ring->head.store(head + 1, std::memory_order_release);
+
+      // get the writer going early if the ring is filling up
+      if(head + 1 - ring->tail.load(std::memory_order_relaxed) >= kRingRecords / 2)
+        gWake.notify_one();
+    }
 
     /** @brief Sets the name of the log file. */
     void setFileName(const std::string &value)
@@ -36,95 +241,140 @@ namespace OFX {
       gLogFileName = value;
     }
 
-    /** @brief Opens the log file, returns whether this was successful or not. */
+    /** @brief Opens the log file and starts the thread writing to it, returns whether this was successful or not. */
     bool open(void)
     {
 #ifdef DEBUG
-      if(!gLogFP) {
-        gLogFP = fopen(gLogFileName.c_str(), "a");
-        return gLogFP != 0;
-      }
+      static const bool allowed = true;
+#else
+      // release builds only log when asked to
+      static const bool allowed = getenv(kLogFileEnvVar) != 0;
 #endif
-      return gLogFP != 0;
+      if(allowed && !gIsOpen.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(gFileMutex);
+        if(!gLogFP) {
+          FILE *fp = fopen(gLogFileName.c_str(), "a");
+          if(fp) {
+            time_t now = time(0);
+            fprintf(fp, "Log opened %s", ctime(&now));
+            {
+              std::lock_guard<std::mutex> drainLock(gDrainMutex);
+              gLogFP = fp;
+              gOpenTicks = nowTicks();
+            }
+            gStopping = false;
+            gWriter = std::thread(writerLoop);
+            gIsOpen.store(true, std::memory_order_release);
+          }
+        }
+      }
+      return gIsOpen.load(std::memory_order_acquire);
     }
 
-    /** @brief Closes the log file. */
-    void close(void)
+    /** @brief Writes out any messages waiting, stops the writing thread, waiting for it to finish if asked to, and closes the log file. */
+    static void closeFile(bool joinWriter)
     {
+      std::lock_guard<std::mutex> lock(gFileMutex);
       if(gLogFP) {
+        {
+          std::lock_guard<std::mutex> wakeLock(gWakeMutex);
+          gStopping = true;
+        }
+        gWake.notify_one();
+        if(gWriter.joinable()) {
+          if(joinWriter)
+            gWriter.join();
+          else
+            gWriter.detach();
+        }
+        drain();
+        gIsOpen.store(false, std::memory_order_release);
+        signalRoom();
+
+        // a flush may still be draining, so close the file only once it has done
+        std::lock_guard<std::mutex> drainLock(gDrainMutex);
         fclose(gLogFP);
+        gLogFP = 0;
       }
-      gLogFP = 0;
     }
 
-    /** @brief Indent it, not MP sane at the moment */
+    /** @brief Writes out any messages waiting, stops the writing thread and closes the log file. */
+    void close(void)
+    {
+      closeFile(true);
+    }
+
+    /** @brief Writes out the messages logged so far, returning once they are in the file. */
+    void flush(void)
+    {
+      if(gIsOpen.load(std::memory_order_acquire))
+        drain();
+    }
+
+    /** @brief Indent the calling thread's messages */
     void indent(void)
     {
-      ++gIndent;
+      ++gThreadState.indent;
     }
 
-    /** @brief Outdent it, not MP sane at the moment */
+    /** @brief Outdent the calling thread's messages */
     void outdent(void)
     {
-      --gIndent;
+      --gThreadState.indent;
     }
 
-    /** @brief do the indenting */
-    static void doIndent(void)
+    /** @brief Logs a message at the given level, prefixed with a notice for warnings and errors. */
+    void log(LevelEnum level, const char *format, ...)
     {
-      if(open()) {
-        for(int i = 0; i < gIndent; i++) {
-          fputs("    ", gLogFP);
-        }
+      if(level >= OFX_LOG_LEVEL && open()) {
+        va_list args;
+        va_start(args, format);
+        push(level, format, args);
+        va_end(args);
       }
     }
 
     /** @brief Prints to the log file. */
     void print(const char *format, ...)
     {
-      if(open()) {
-        doIndent();
+      if(eLevelInfo >= OFX_LOG_LEVEL && open()) {
         va_list args;
         va_start(args, format);
-        vfprintf(gLogFP, format, args);
-        fputc('\n', gLogFP);
-        fflush(gLogFP);
+        push(eLevelInfo, format, args);
         va_end(args);
-      }  
+      }
     }
 
     /** @brief Prints to the log file only if the condition is true and prepends a warning notice. */
     void warning(bool condition, const char *format, ...)
     {
-      if(condition && open()) {
-        doIndent();
-        fputs("WARNING : ", gLogFP);
-
+      if(condition && eLevelWarning >= OFX_LOG_LEVEL && open()) {
         va_list args;
         va_start(args, format);
-        vfprintf(gLogFP, format, args);
-        fputc('\n', gLogFP);
+        push(eLevelWarning, format, args);
         va_end(args);
-
-        fflush(gLogFP);
-      }  
+      }
     }
 
     /** @brief Prints to the log file only if the condition is true and prepends an error notice. */
     void error(bool condition, const char *format, ...)
     {
-      if(condition && open()) {
-        doIndent();
-        fputs("ERROR : ", gLogFP);
-
+      if(condition && eLevelError >= OFX_LOG_LEVEL && open()) {
         va_list args;
         va_start(args, format);
-        vfprintf(gLogFP, format, args);
-        fputc('\n', gLogFP);
+        push(eLevelError, format, args);
         va_end(args);
-
-        fflush(gLogFP);
-      }  
+      }
     }
+
+    /** @brief closes the log when the binary is unloaded, if the plugin has not already, so nothing logged is lost
+
+    This only writes out and closes the file. The writer is told to stop but not waited for, as the loader may
+    hold a lock here that the exiting thread needs, as FreeLibrary does on Windows. The orderly join is left to
+    close, called on kOfxActionUnload.
+    */
+    static struct Closer {
+      ~Closer() { closeFile(false); }
+    } gCloser;
   };
 };
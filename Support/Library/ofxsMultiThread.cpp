@@ -1,6 +1,9 @@
 // Copyright OpenFX and contributors to the OpenFX project.
 // SPDX-License-Identifier: BSD-3-Clause
 
+#include <atomic>
+#include <exception>
+
 #include "ofxsSupportPrivate.h"
 
 namespace OFX {
@@ -20,14 +23,21 @@ namespace OFX {
     {
     }
 
+    /** @brief What gets passed to the threads, the render's abort flag has to follow it onto them */
+    struct ThreadArgs {
+      Processor *processor;
+      const int *abortFlag;
+    };
+
     /** @brief Function to pass to the multi thread suite */
     void Processor::staticMultiThreadFunction(unsigned int threadIndex, unsigned int threadMax, void *customArg)
     {
-      // cast the custom arg to one of me
-      Processor *me = (Processor *)  customArg;
+      // cast the custom arg to one of our args
+      ThreadArgs *args = (ThreadArgs *) customArg;
+      OFX::Private::RenderAbortFlagScope abortFlag(args->abortFlag);
 
       // and call my thread function
-      me->multiThreadFunction(threadIndex, threadMax);
+      args->processor->multiThreadFunction(threadIndex, threadMax);
     }
 
     /** @brief Function to pass to the multi thread suite */
@@ -45,7 +55,8 @@ namespace OFX {
         // OK do it
           OfxStatus stat = kOfxStatFailed;
           if(OFX::Private::gThreadSuite){
-              stat = OFX::Private::gThreadSuite->multiThread(staticMultiThreadFunction, nCPUs, (void *)this);
+              ThreadArgs args = {this, OFX::Private::gRenderAbortFlag};
+              stat = OFX::Private::gThreadSuite->multiThread(staticMultiThreadFunction, nCPUs, (void *)&args);
           }
 
         // did we do it?
@@ -86,6 +97,79 @@ namespace OFX {
       return n;
     }
 
+    ////////////////////////////////////////////////////////////////////////////////
+    // parallel for and reduce
+
+    /** @brief the fewest and most chunks a range is cut into when no grain is given, and whatever the grain */
+    static const int kDefaultChunks = 256;
+    static const int kMaxChunks = 1024;
+
+    int getGrain(const Range &range, int grain)
+    {
+      int size = range.size();
+      if(grain <= 0)
+        grain = (size + kDefaultChunks - 1) / kDefaultChunks;
+      grain = std::max(grain, (size + kMaxChunks - 1) / kMaxChunks);
+      return std::max(grain, 1);
+    }
+
+    /** @brief Hands chunks out to the threads it runs on from a shared counter */
+    class ChunkProcessor : public Processor {
+    protected :
+      void (*_fn)(int chunk, void *arg);
+      void *_arg;
+      int _nChunks;
+      std::atomic<int> _nextChunk;
+      std::atomic<bool> _failed;
+      std::exception_ptr _exception; /**< @brief the first exception thrown by a chunk */
+
+    public :
+      ChunkProcessor(int nChunks, void (*fn)(int chunk, void *arg), void *arg)
+        : _fn(fn)
+        , _arg(arg)
+        , _nChunks(nChunks)
+        , _nextChunk(0)
+        , _failed(false)
+      {
+      }
+
+      /** @brief take chunks until there are none left, exceptions must not get back into the host */
+      void multiThreadFunction(unsigned int /*threadID*/, unsigned int /*nThreads*/)
+      {
+        while(!_failed.load(std::memory_order_relaxed)) {
+          int chunk = _nextChunk.fetch_add(1, std::memory_order_relaxed);
+          if(chunk >= _nChunks)
+            return;
+          try {
+            _fn(chunk, _arg);
+          }
+          catch(...) {
+            if(!_failed.exchange(true))
+              _exception = std::current_exception();
+            return;
+          }
+        }
+      }
+
+      /** @brief run the chunks and rethrow anything they threw */
+      void run()
+      {
+        // the host need not support spawning threads from spawned threads
+        unsigned int nCPUs = isSpawnedThread() ? 1 : std::min(getNumCPUs(), (unsigned int) _nChunks);
+        multiThread(std::max(nCPUs, 1u));
+        if(_exception)
+          std::rethrow_exception(_exception);
+      }
+    };
+
+    void forEachChunk(int nChunks, void (*fn)(int chunk, void *arg), void *arg)
+    {
+      if(nChunks <= 0)
+        return;
+      ChunkProcessor processor(nChunks, fn, arg);
+      processor.run();
+    }
+
     ////////////////////////////////////////////////////////////////////////////////
     // MUTEX class
 
@@ -1925,6 +1925,37 @@ namespace OFX {
     throwSuiteStatusException(stat);
   }
 
+  /** @brief get the values at each of an array of times */
+  void DoubleParam::getValuesAtTimes(const double *times, int nTimes, double *values)
+  {
+    if(OFX::Private::gParamBatchSuite) {
+      OfxStatus stat = OFX::Private::gParamBatchSuite->paramGetValuesAtTimes(_paramHandle, times, nTimes, values);
+      if(stat != kOfxStatErrUnsupported) {
+        throwSuiteStatusException(stat);
+        return;
+      }
+    }
+    // no batch suite, get them one at a time
+    for(int i = 0; i < nTimes; ++i) {
+      getValueAtTime(times[i], values[i]);
+    }
+  }
+
+  /** @brief get the values at evenly spaced times */
+  void DoubleParam::getValuesOverRange(double start, double step, int nTimes, double *values)
+  {
+    if(OFX::Private::gParamBatchSuite) {
+      OfxStatus stat = OFX::Private::gParamBatchSuite->paramGetValuesOverRange(_paramHandle, start, step, nTimes, values);
+      if(stat != kOfxStatErrUnsupported) {
+        throwSuiteStatusException(stat);
+        return;
+      }
+    }
+    for(int i = 0; i < nTimes; ++i) {
+      getValueAtTime(start + i * step, values[i]);
+    }
+  }
+
   /** @brief set value */
   void DoubleParam::setValue(double v)
   {
@@ -2038,6 +2069,37 @@ namespace OFX {
     throwSuiteStatusException(stat);
   }
 
+  /** @brief get the values at each of an array of times */
+  void Double2DParam::getValuesAtTimes(const double *times, int nTimes, double *values)
+  {
+    if(OFX::Private::gParamBatchSuite) {
+      OfxStatus stat = OFX::Private::gParamBatchSuite->paramGetValuesAtTimes(_paramHandle, times, nTimes, values);
+      if(stat != kOfxStatErrUnsupported) {
+        throwSuiteStatusException(stat);
+        return;
+      }
+    }
+    // no batch suite, get them one at a time
+    for(int i = 0; i < nTimes; ++i) {
+      getValueAtTime(times[i], values[2*i], values[2*i+1]);
+    }
+  }
+
+  /** @brief get the values at evenly spaced times */
+  void Double2DParam::getValuesOverRange(double start, double step, int nTimes, double *values)
+  {
+    if(OFX::Private::gParamBatchSuite) {
+      OfxStatus stat = OFX::Private::gParamBatchSuite->paramGetValuesOverRange(_paramHandle, start, step, nTimes, values);
+      if(stat != kOfxStatErrUnsupported) {
+        throwSuiteStatusException(stat);
+        return;
+      }
+    }
+    for(int i = 0; i < nTimes; ++i) {
+      getValueAtTime(start + i * step, values[2*i], values[2*i+1]);
+    }
+  }
+
   /** @brief set value */
   void Double2DParam::setValue(double x, double y)
   {
@@ -2287,6 +2349,37 @@ namespace OFX {
     throwSuiteStatusException(stat);
   }
 
+  /** @brief get the values at each of an array of times */
+  void RGBAParam::getValuesAtTimes(const double *times, int nTimes, double *values)
+  {
+    if(OFX::Private::gParamBatchSuite) {
+      OfxStatus stat = OFX::Private::gParamBatchSuite->paramGetValuesAtTimes(_paramHandle, times, nTimes, values);
+      if(stat != kOfxStatErrUnsupported) {
+        throwSuiteStatusException(stat);
+        return;
+      }
+    }
+    // no batch suite, get them one at a time
+    for(int i = 0; i < nTimes; ++i) {
+      getValueAtTime(times[i], values[4*i], values[4*i+1], values[4*i+2], values[4*i+3]);
+    }
+  }
+
+  /** @brief get the values at evenly spaced times */
+  void RGBAParam::getValuesOverRange(double start, double step, int nTimes, double *values)
+  {
+    if(OFX::Private::gParamBatchSuite) {
+      OfxStatus stat = OFX::Private::gParamBatchSuite->paramGetValuesOverRange(_paramHandle, start, step, nTimes, values);
+      if(stat != kOfxStatErrUnsupported) {
+        throwSuiteStatusException(stat);
+        return;
+      }
+    }
+    for(int i = 0; i < nTimes; ++i) {
+      getValueAtTime(start + i * step, values[4*i], values[4*i+1], values[4*i+2], values[4*i+3]);
+    }
+  }
+
   /** @brief set value */
   void RGBAParam::setValue(double r, double g, double b, double a)
   {
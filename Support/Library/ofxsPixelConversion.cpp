@@ -0,0 +1,528 @@
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+#include "ofxsSupportPrivate.h"
+#include "ofxsPixelConversion.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define OFXS_PIXEL_CONVERSION_X86
+#  include <immintrin.h>
+#endif
+
+namespace OFX {
+
+  namespace PixelConversion {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // scalar conversions
+
+    unsigned short floatToHalf(float f)
+    {
+      unsigned int x;
+      memcpy(&x, &f, sizeof(x));
+      unsigned short sign = (unsigned short) ((x >> 16) & 0x8000);
+      unsigned int absx = x & 0x7fffffff;
+
+      // infinity and NaN, keeping NaNs quiet
+      if(absx >= 0x7f800000)
+        return sign | 0x7c00 | (absx > 0x7f800000 ? 0x200 | ((absx >> 13) & 0x3ff) : 0);
+
+      // 65520 and up round to infinity
+      if(absx >= 0x477ff000)
+        return sign | 0x7c00;
+
+      // below the smallest normal half, shift the mantissa and its implicit bit down
+      if(absx < 0x38800000) {
+        if(absx < 0x33000000)
+          return sign;
+        unsigned int mantissa = (absx & 0x7fffff) | 0x800000;
+        int shift = 126 - (int) (absx >> 23);
+        unsigned int h = mantissa >> shift;
+        unsigned int rem = mantissa & ((1u << shift) - 1);
+        unsigned int half = 1u << (shift - 1);
+        if(rem > half || (rem == half && (h & 1)))
+          ++h;
+        return sign | (unsigned short) h;
+      }
+
+      // rebias the exponent, a carry out of the mantissa when rounding bumps it as it should
+      unsigned int h = (absx - 0x38000000) >> 13;
+      unsigned int rem = absx & 0x1fff;
+      if(rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+        ++h;
+      return sign | (unsigned short) h;
+    }
+
+    float halfToFloat(unsigned short h)
+    {
+      unsigned int sign = (unsigned int) (h & 0x8000) << 16;
+      unsigned int exponent = (h >> 10) & 0x1f;
+      unsigned int mantissa = h & 0x3ff;
+      unsigned int x;
+
+      if(exponent == 0) {
+        if(mantissa == 0) {
+          x = sign;
+        }
+        else {
+          // subnormal, normalise it
+          exponent = 113;
+          while(!(mantissa & 0x400)) {
+            mantissa <<= 1;
+            --exponent;
+          }
+          x = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+        }
+      }
+      else if(exponent == 31) {
+        // infinity and NaN, quietening NaNs as the hardware does
+        x = sign | 0x7f800000 | (mantissa << 13) | (mantissa ? 0x400000 : 0);
+      }
+      else {
+        x = sign | ((exponent + 112) << 23) | (mantissa << 13);
+      }
+
+      float f;
+      memcpy(&f, &x, sizeof(f));
+      return f;
+    }
+
+    /** @brief scale a float to an integral range, clamped, NaN going to 0 */
+    static inline float ScaleClamp(float v, float max)
+    {
+      v *= max;
+      v = v > 0 ? v : 0;
+      return v < max ? v : max;
+    }
+
+    static void HalfToFloatPortable(const unsigned short *src, float *dst, int n)
+    {
+      for(int i = 0; i < n; ++i)
+        dst[i] = halfToFloat(src[i]);
+    }
+
+    static void FloatToHalfPortable(const float *src, unsigned short *dst, int n)
+    {
+      for(int i = 0; i < n; ++i)
+        dst[i] = floatToHalf(src[i]);
+    }
+
+    static void UByteToFloatPortable(const unsigned char *src, float *dst, int n)
+    {
+      for(int i = 0; i < n; ++i)
+        dst[i] = (float) src[i] * (1.f / 255.f);
+    }
+
+    static void UShortToFloatPortable(const unsigned short *src, float *dst, int n)
+    {
+      for(int i = 0; i < n; ++i)
+        dst[i] = (float) src[i] * (1.f / 65535.f);
+    }
+
+    static void FloatToUBytePortable(const float *src, unsigned char *dst, int n)
+    {
+      for(int i = 0; i < n; ++i)
+        dst[i] = (unsigned char) nearbyintf(ScaleClamp(src[i], 255.f));
+    }
+
+    static void FloatToUShortPortable(const float *src, unsigned short *dst, int n)
+    {
+      for(int i = 0; i < n; ++i)
+        dst[i] = (unsigned short) nearbyintf(ScaleClamp(src[i], 65535.f));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // vector conversions, each converts as much as it can a vector at a time and leaves the rest to the portable one
+
+#ifdef OFXS_PIXEL_CONVERSION_X86
+    __attribute__((target("avx,f16c")))
+    static void HalfToFloatF16C(const unsigned short *src, float *dst, int n)
+    {
+      int i = 0;
+      for(; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) (src + i))));
+      HalfToFloatPortable(src + i, dst + i, n - i);
+    }
+
+    __attribute__((target("avx,f16c")))
+    static void FloatToHalfF16C(const float *src, unsigned short *dst, int n)
+    {
+      int i = 0;
+      for(; i + 8 <= n; i += 8)
+        _mm_storeu_si128((__m128i *) (dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+      FloatToHalfPortable(src + i, dst + i, n - i);
+    }
+
+    __attribute__((target("avx2")))
+    static void UByteToFloatAVX2(const unsigned char *src, float *dst, int n)
+    {
+      const __m256 scale = _mm256_set1_ps(1.f / 255.f);
+      int i = 0;
+      for(; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *) (src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+      }
+      UByteToFloatPortable(src + i, dst + i, n - i);
+    }
+
+    __attribute__((target("avx2")))
+    static void UShortToFloatAVX2(const unsigned short *src, float *dst, int n)
+    {
+      const __m256 scale = _mm256_set1_ps(1.f / 65535.f);
+      int i = 0;
+      for(; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *) (src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+      }
+      UShortToFloatPortable(src + i, dst + i, n - i);
+    }
+
+    /** @brief scale, clamp and round 8 floats to ints, as ScaleClamp and nearbyintf do */
+    __attribute__((target("avx2")))
+    static inline __m256i ScaleClampRoundAVX2(const float *src, __m256 max)
+    {
+      __m256 v = _mm256_mul_ps(_mm256_loadu_ps(src), max);
+      v = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), max);
+      return _mm256_cvtps_epi32(v);
+    }
+
+    __attribute__((target("avx2")))
+    static void FloatToUByteAVX2(const float *src, unsigned char *dst, int n)
+    {
+      const __m256 max = _mm256_set1_ps(255.f);
+      int i = 0;
+      for(; i + 8 <= n; i += 8) {
+        __m256i v = ScaleClampRoundAVX2(src + i, max);
+        __m128i w = _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        _mm_storel_epi64((__m128i *) (dst + i), _mm_packus_epi16(w, w));
+      }
+      FloatToUBytePortable(src + i, dst + i, n - i);
+    }
+
+    __attribute__((target("avx2")))
+    static void FloatToUShortAVX2(const float *src, unsigned short *dst, int n)
+    {
+      const __m256 max = _mm256_set1_ps(65535.f);
+      int i = 0;
+      for(; i + 8 <= n; i += 8) {
+        __m256i v = ScaleClampRoundAVX2(src + i, max);
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+      }
+      FloatToUShortPortable(src + i, dst + i, n - i);
+    }
+
+    // some versions of gcc warn about the intrinsics' own undefined registers
+#   if defined(__GNUC__) && !defined(__clang__)
+#     pragma GCC diagnostic push
+#     pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#   endif
+    __attribute__((target("avx512f")))
+    static void HalfToFloatAVX512(const unsigned short *src, float *dst, int n)
+    {
+      int i = 0;
+      for(; i + 16 <= n; i += 16)
+        _mm512_storeu_ps(dst + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *) (src + i))));
+      HalfToFloatPortable(src + i, dst + i, n - i);
+    }
+
+    __attribute__((target("avx512f")))
+    static void FloatToHalfAVX512(const float *src, unsigned short *dst, int n)
+    {
+      int i = 0;
+      for(; i + 16 <= n; i += 16)
+        _mm256_storeu_si256((__m256i *) (dst + i), _mm512_cvtps_ph(_mm512_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+      FloatToHalfPortable(src + i, dst + i, n - i);
+    }
+
+    __attribute__((target("avx512f")))
+    static void UByteToFloatAVX512(const unsigned char *src, float *dst, int n)
+    {
+      const __m512 scale = _mm512_set1_ps(1.f / 255.f);
+      int i = 0;
+      for(; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *) (src + i)));
+        _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_cvtepi32_ps(v), scale));
+      }
+      UByteToFloatPortable(src + i, dst + i, n - i);
+    }
+
+    __attribute__((target("avx512f")))
+    static void UShortToFloatAVX512(const unsigned short *src, float *dst, int n)
+    {
+      const __m512 scale = _mm512_set1_ps(1.f / 65535.f);
+      int i = 0;
+      for(; i + 16 <= n; i += 16) {
+        __m512i v = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *) (src + i)));
+        _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_cvtepi32_ps(v), scale));
+      }
+      UShortToFloatPortable(src + i, dst + i, n - i);
+    }
+
+    /** @brief scale, clamp and round 16 floats to ints, as ScaleClamp and nearbyintf do */
+    __attribute__((target("avx512f")))
+    static inline __m512i ScaleClampRoundAVX512(const float *src, __m512 max)
+    {
+      __m512 v = _mm512_mul_ps(_mm512_loadu_ps(src), max);
+      v = _mm512_min_ps(_mm512_max_ps(v, _mm512_setzero_ps()), max);
+      return _mm512_cvtps_epi32(v);
+    }
+
+    __attribute__((target("avx512f")))
+    static void FloatToUByteAVX512(const float *src, unsigned char *dst, int n)
+    {
+      const __m512 max = _mm512_set1_ps(255.f);
+      int i = 0;
+      for(; i + 16 <= n; i += 16)
+        _mm_storeu_si128((__m128i *) (dst + i), _mm512_cvtusepi32_epi8(ScaleClampRoundAVX512(src + i, max)));
+      FloatToUBytePortable(src + i, dst + i, n - i);
+    }
+
+    __attribute__((target("avx512f")))
+    static void FloatToUShortAVX512(const float *src, unsigned short *dst, int n)
+    {
+      const __m512 max = _mm512_set1_ps(65535.f);
+      int i = 0;
+      for(; i + 16 <= n; i += 16)
+        _mm256_storeu_si256((__m256i *) (dst + i), _mm512_cvtusepi32_epi16(ScaleClampRoundAVX512(src + i, max)));
+      FloatToUShortPortable(src + i, dst + i, n - i);
+    }
+#   if defined(__GNUC__) && !defined(__clang__)
+#     pragma GCC diagnostic pop
+#   endif
+#endif
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // run time dispatch
+
+    /** @brief the kernels for an instruction set */
+    struct Kernels {
+      InstructionSetEnum instructionSet;
+      void (*halfToFloat)(const unsigned short *src, float *dst, int n);
+      void (*floatToHalf)(const float *src, unsigned short *dst, int n);
+      void (*ubyteToFloat)(const unsigned char *src, float *dst, int n);
+      void (*ushortToFloat)(const unsigned short *src, float *dst, int n);
+      void (*floatToUByte)(const float *src, unsigned char *dst, int n);
+      void (*floatToUShort)(const float *src, unsigned short *dst, int n);
+    };
+
+    /** @brief pick the kernels for the best instruction set the CPU has */
+    static Kernels PickKernels(void)
+    {
+      Kernels k = {eInstructionSetPortable,
+                   HalfToFloatPortable, FloatToHalfPortable,
+                   UByteToFloatPortable, UShortToFloatPortable,
+                   FloatToUBytePortable, FloatToUShortPortable};
+#ifdef OFXS_PIXEL_CONVERSION_X86
+      __builtin_cpu_init();
+      if(__builtin_cpu_supports("avx512f")) {
+        k.instructionSet = eInstructionSetAVX512;
+        k.halfToFloat = HalfToFloatAVX512;
+        k.floatToHalf = FloatToHalfAVX512;
+        k.ubyteToFloat = UByteToFloatAVX512;
+        k.ushortToFloat = UShortToFloatAVX512;
+        k.floatToUByte = FloatToUByteAVX512;
+        k.floatToUShort = FloatToUShortAVX512;
+      }
+      else if(__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c")) {
+        k.instructionSet = eInstructionSetF16C;
+        k.halfToFloat = HalfToFloatF16C;
+        k.floatToHalf = FloatToHalfF16C;
+        if(__builtin_cpu_supports("avx2")) {
+          k.instructionSet = eInstructionSetAVX2;
+          k.ubyteToFloat = UByteToFloatAVX2;
+          k.ushortToFloat = UShortToFloatAVX2;
+          k.floatToUByte = FloatToUByteAVX2;
+          k.floatToUShort = FloatToUShortAVX2;
+        }
+      }
+#endif
+      return k;
+    }
+
+    /** @brief the kernels to convert with, picked on first use */
+    static const Kernels &GetKernels(void)
+    {
+      static const Kernels kernels = PickKernels();
+      return kernels;
+    }
+
+    InstructionSetEnum getInstructionSet(void)
+    {
+      return GetKernels().instructionSet;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // row conversion
+
+    /** @brief bytes in a component of the given depth, 0 if it is not one we convert */
+    static int BytesPerComponent(BitDepthEnum depth)
+    {
+      switch(depth) {
+      case eBitDepthUByte : return 1;
+      case eBitDepthUShort :
+      case eBitDepthHalf : return 2;
+      case eBitDepthFloat : return 4;
+      default : return 0;
+      }
+    }
+
+    /** @brief the 4x4 ordered dither thresholds, in sixteenths */
+    static const unsigned char kBayer[4][4] = {
+      { 0,  8,  2, 10},
+      {12,  4, 14,  6},
+      { 3, 11,  1,  9},
+      {15,  7, 13,  5}
+    };
+
+    /** @brief quantise floats to an integral depth with an ordered dither, the values falling within
+        a step being spread over its two ends in proportion, rather than all rounding to the nearer */
+    template <class PIX>
+    static void FloatToIntDithered(const float *src, PIX *dst, int nPixels, int nComponents, float max, int x, int y)
+    {
+      const unsigned char *row = kBayer[y & 3];
+      for(int p = 0; p < nPixels; ++p) {
+        float threshold = (row[(x + p) & 3] + 0.5f) / 16.f;
+        for(int c = 0; c < nComponents; ++c) {
+          float v = floorf(ScaleClamp(*src++, max) + threshold);
+          *dst++ = (PIX) (v < max ? v : max);
+        }
+      }
+    }
+
+    /** @brief convert floats to the given depth */
+    static void FromFloat(const Kernels &k, const float *src, void *dst, BitDepthEnum dstDepth,
+                          int nPixels, int nComponents, DitherEnum dither, int x, int y)
+    {
+      int n = nPixels * nComponents;
+      switch(dstDepth) {
+      case eBitDepthUByte :
+        if(dither == eDitherOrdered)
+          FloatToIntDithered(src, (unsigned char *) dst, nPixels, nComponents, 255.f, x, y);
+        else
+          k.floatToUByte(src, (unsigned char *) dst, n);
+        break;
+      case eBitDepthUShort :
+        if(dither == eDitherOrdered)
+          FloatToIntDithered(src, (unsigned short *) dst, nPixels, nComponents, 65535.f, x, y);
+        else
+          k.floatToUShort(src, (unsigned short *) dst, n);
+        break;
+      case eBitDepthHalf :
+        k.floatToHalf(src, (unsigned short *) dst, n);
+        break;
+      default :
+        memcpy(dst, src, n * sizeof(float));
+        break;
+      }
+    }
+
+    /** @brief convert from the given depth to floats */
+    static void ToFloat(const Kernels &k, const void *src, BitDepthEnum srcDepth, float *dst, int n)
+    {
+      switch(srcDepth) {
+      case eBitDepthUByte : k.ubyteToFloat((const unsigned char *) src, dst, n); break;
+      case eBitDepthUShort : k.ushortToFloat((const unsigned short *) src, dst, n); break;
+      case eBitDepthHalf : k.halfToFloat((const unsigned short *) src, dst, n); break;
+      default : memcpy(dst, src, n * sizeof(float)); break;
+      }
+    }
+
+    /** @brief components converted through the float buffer at a time */
+    static const int kChunkComponents = 1024;
+
+    void convertRow(const void *src, BitDepthEnum srcDepth,
+                    void *dst, BitDepthEnum dstDepth,
+                    int nPixels, int nComponents,
+                    DitherEnum dither, int x, int y)
+    {
+      int srcBytes = BytesPerComponent(srcDepth);
+      int dstBytes = BytesPerComponent(dstDepth);
+      if(srcBytes == 0 || dstBytes == 0)
+        throwSuiteStatusException(kOfxStatErrUnsupported);
+      if(nPixels <= 0 || nComponents <= 0)
+        return;
+
+      if(srcDepth == dstDepth) {
+        memcpy(dst, src, (size_t) nPixels * nComponents * srcBytes);
+        return;
+      }
+
+      // dithering only does anything when going to a coarser integral depth
+      bool coarser = (dstDepth == eBitDepthUByte && srcDepth != eBitDepthUByte) ||
+                     (dstDepth == eBitDepthUShort && (srcDepth == eBitDepthHalf || srcDepth == eBitDepthFloat));
+      if(!coarser)
+        dither = eDitherNone;
+
+      // bytes and shorts convert exactly, without going through floats
+      if(dither == eDitherNone && srcDepth == eBitDepthUByte && dstDepth == eBitDepthUShort) {
+        const unsigned char *s = (const unsigned char *) src;
+        unsigned short *d = (unsigned short *) dst;
+        for(int i = 0, n = nPixels * nComponents; i < n; ++i)
+          d[i] = (unsigned short) (s[i] * 257);
+        return;
+      }
+      if(dither == eDitherNone && srcDepth == eBitDepthUShort && dstDepth == eBitDepthUByte) {
+        const unsigned short *s = (const unsigned short *) src;
+        unsigned char *d = (unsigned char *) dst;
+        for(int i = 0, n = nPixels * nComponents; i < n; ++i)
+          d[i] = (unsigned char) ((s[i] * 255u + 32767u) / 65535u);
+        return;
+      }
+
+      const Kernels &k = GetKernels();
+
+      // one end is float, so convert straight to or from it
+      if(srcDepth == eBitDepthFloat) {
+        FromFloat(k, (const float *) src, dst, dstDepth, nPixels, nComponents, dither, x, y);
+        return;
+      }
+      if(dstDepth == eBitDepthFloat) {
+        ToFloat(k, src, srcDepth, (float *) dst, nPixels * nComponents);
+        return;
+      }
+
+      // otherwise go through floats a chunk of whole pixels at a time
+      float buffer[kChunkComponents];
+      int chunkPixels = kChunkComponents / nComponents;
+      if(chunkPixels == 0)
+        throwSuiteStatusException(kOfxStatErrUnsupported);
+
+      const char *s = (const char *) src;
+      char *d = (char *) dst;
+      for(int p = 0; p < nPixels; p += chunkPixels) {
+        int n = nPixels - p < chunkPixels ? nPixels - p : chunkPixels;
+        ToFloat(k, s, srcDepth, buffer, n * nComponents);
+        FromFloat(k, buffer, d, dstDepth, n, nComponents, dither, x + p, y);
+        s += (size_t) n * nComponents * srcBytes;
+        d += (size_t) n * nComponents * dstBytes;
+      }
+    }
+
+    void convertImage(const Image &src, Image &dst, const OfxRectI &window, DitherEnum dither)
+    {
+      if(src.getPixelComponents() != dst.getPixelComponents() ||
+         src.getPixelComponentCount() != dst.getPixelComponentCount())
+        throwSuiteStatusException(kOfxStatErrImageFormat);
+
+      const OfxRectI &srcBounds = src.getBounds();
+      const OfxRectI &dstBounds = dst.getBounds();
+      int x1 = std::max(window.x1, std::max(srcBounds.x1, dstBounds.x1));
+      int y1 = std::max(window.y1, std::max(srcBounds.y1, dstBounds.y1));
+      int x2 = std::min(window.x2, std::min(srcBounds.x2, dstBounds.x2));
+      int y2 = std::min(window.y2, std::min(srcBounds.y2, dstBounds.y2));
+      if(x1 >= x2)
+        return;
+
+      for(int y = y1; y < y2; ++y)
+        convertRow(src.getPixelAddress(x1, y), src.getPixelDepth(),
+                   dst.getPixelAddress(x1, y), dst.getPixelDepth(),
+                   x2 - x1, src.getPixelComponentCount(),
+                   dither, x1, y);
+    }
+
+  };
+};
@@ -62,7 +62,7 @@ namespace OFX {
       throwPropertyException(stat, property); 
 
     if(_gPropLogging > 0) 
-      Log::print("Fetched dimension of property %s, returned %d.",  property, dimension);
+      OFX_LOG_DEBUG("Fetched dimension of property %s, returned %d.",  property, dimension);
 
     return dimension;
   }
@@ -75,7 +75,7 @@ namespace OFX {
     Log::error(stat != kOfxStatOK, "Failed on resetting property %s to its defaults, host returned status %s.", property, mapStatusToString(stat));
     throwPropertyException(stat, property); 
 
-    if(_gPropLogging > 0) Log::print("Reset property %s.",  property);
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Reset property %s.",  property);
   }
 
   /** @brief, Set a single dimension pointer property */
@@ -88,7 +88,7 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property);  
 
-    if(_gPropLogging > 0) Log::print("Set pointer property %s[%d] to be %p.",  property, idx, value);
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Set pointer property %s[%d] to be %p.",  property, idx, value);
   }
 
   /** @brief, Set a single dimension string property */
@@ -101,7 +101,7 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property); 
 
-    if(_gPropLogging > 0) Log::print("Set string property %s[%d] to be %s.",  property, idx, value.c_str());
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Set string property %s[%d] to be %s.",  property, idx, value.c_str());
   }
 
   /** @brief, Set a single dimension double property */
@@ -114,7 +114,7 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property); 
 
-    if(_gPropLogging > 0) Log::print("Set double property %s[%d] to be %lf.",  property, idx, value);
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Set double property %s[%d] to be %lf.",  property, idx, value);
   }
 
   /** @brief, Set a single dimension int property */
@@ -127,7 +127,7 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property); 
 
-    if(_gPropLogging > 0) Log::print("Set int property %s[%d] to be %d.",  property, idx, value);
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Set int property %s[%d] to be %d.",  property, idx, value);
   }
 
   /** @brief, Set a multiple dimension double property */
@@ -140,7 +140,7 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property); 
 
-    if(_gPropLogging > 0) Log::print("Set double property %s[0..%d].",  property, count-1);
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Set double property %s[0..%d].",  property, count-1);
   }
 
   /** @brief Get single pointer property */
@@ -154,13 +154,19 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property); 
 
-    if(_gPropLogging > 0) Log::print("Retrieved pointer property %s[%d], was given %p.",  property, idx, value);
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Retrieved pointer property %s[%d], was given %p.",  property, idx, value);
 
     return value;
   }
 
   /** @brief Get single string property */
   std::string PropertySet::propGetString(const char* property, int idx, bool throwOnFailure) const
+  {
+    return std::string(propGetCString(property, idx, throwOnFailure));
+  }
+
+  /** @brief Get single string property, as the host's own string */
+  const char *PropertySet::propGetCString(const char* property, int idx, bool throwOnFailure) const
   {
     assert(_propHandle != 0);
     char *value = NULL;
@@ -170,8 +176,8 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property);
 
-    if(_gPropLogging > 0) Log::print("Retrieved string property %s[%d], was given %s.",  property, idx, value);
-    return value != NULL ?  std::string(value) : std::string();
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Retrieved string property %s[%d], was given %s.",  property, idx, value);
+    return value != NULL ?  value : "";
   }
 
   /** @brief Get single double property */
@@ -185,7 +191,7 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property); 
 
-    if(_gPropLogging > 0) Log::print("Retrieved double property %s[%d], was given %lf.",  property, idx, value);
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Retrieved double property %s[%d], was given %lf.",  property, idx, value);
     return value;
   }
 
@@ -200,17 +206,24 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property); 
 
-    if(_gPropLogging > 0) Log::print("Retrieved int property %s[%d], was given %d.",  property, idx, value);
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Retrieved int property %s[%d], was given %d.",  property, idx, value);
     return value;
   }
     
   std::list<std::string> PropertySet::propGetNString(const char* property, bool throwOnFailure) const
+  {
+    std::vector<const char *> values;
+    propGetNCString(property, values, throwOnFailure);
+    return std::list<std::string>(values.begin(), values.end());
+  }
+
+  void PropertySet::propGetNCString(const char* property, std::vector<const char *> &values, bool throwOnFailure) const
   {
     assert(_propHandle != 0);
-    std::list<std::string> ret;
+    values.clear();
     int dimension = propGetDimension(property,throwOnFailure);
     if (dimension <= 0) {
-      return ret;
+      return;
     }
     std::vector<char*> rawValue(dimension);
     OfxStatus stat = gPropSuite->propGetStringN(_propHandle, property, dimension, rawValue.data());
@@ -219,12 +232,12 @@ namespace OFX {
     if(throwOnFailure)
       throwPropertyException(stat, property);
       
-    if(_gPropLogging > 0) Log::print("Retrieved string property %s, was given %s.",  property,rawValue.data());
+    if(_gPropLogging > 0) OFX_LOG_DEBUG("Retrieved string property %s, was given %d values.",  property, dimension);
       
+    values.reserve(dimension);
     for (int i = 0; i < dimension; ++i) {
-      ret.push_back(std::string(rawValue[i]));
+      values.push_back(rawValue[i] != NULL ? rawValue[i] : "");
     }
-    return ret;
 
   }
 
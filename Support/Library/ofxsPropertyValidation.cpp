@@ -9,6 +9,8 @@ This file contains headers for classes that are used to validate property sets a
 
 #include "ofxsSupportPrivate.h"
 #include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
 #ifdef OFX_SUPPORTS_OPENGLRENDER
 #include "ofxGPURender.h"
 #endif
@@ -18,12 +20,9 @@ This file contains headers for classes that are used to validate property sets a
 
 // #define  kOfxsDisableValidation
 
-// disable validation if not a debug build
-#ifndef DEBUG
-#define  kOfxsDisableValidation
-#endif
+/** @brief environment variable that overrides the validation mode, one of "off", "always", "once" or "sampled", optionally followed by ":N" for the sample period */
+#define kOfxsValidationModeEnvVar "OFX_PLUGIN_VALIDATION"
 
-//#define kOfxsDisableValidation
 /** @brief OFX namespace
 */
 namespace OFX {
@@ -31,6 +30,27 @@ namespace OFX {
   /** @brief The validation code has its own namespace */
   namespace Validation {
 
+    /** @brief validate everything every time in debug builds, and each shape once otherwise */
+#ifdef DEBUG
+    static std::atomic<int> gMode(eModeAlways);
+#else
+    static std::atomic<int> gMode(eModeOncePerShape);
+#endif
+    static std::atomic<int> gSamplePeriod(kDefaultSamplePeriod);
+
+    /** @brief Set how property sets are validated */
+    void setMode(ModeEnum mode, int samplePeriod)
+    {
+      gSamplePeriod = samplePeriod > 0 ? samplePeriod : 1;
+      gMode = mode;
+    }
+
+    /** @brief How property sets are validated */
+    ModeEnum getMode(void)
+    {
+      return ModeEnum(gMode.load(std::memory_order_relaxed));
+    }
+
 #ifndef kOfxsDisableValidation
     /** @brief Set the vector by getting dimension things specified by ilk from the argp list, used by PropertyDescription ctor */
     static void
@@ -194,6 +214,7 @@ namespace OFX {
     */
     PropertySetDescription::PropertySetDescription(const char *setName, ...) // PropertyDescription *v, int nV)
       : _setName(setName)
+      , _nValidations(0)
     {
 
       // go through the var args to extract defaults to check against and values to set to
@@ -234,9 +255,28 @@ namespace OFX {
       PropertySetDescription::addProperty(PropertyDescription *desc,
       bool deleteOnDestruction)
     {
+      std::lock_guard<std::mutex> lock(_mutex);
       _descriptions.push_back(desc);
       if(deleteOnDestruction)
         _deleteThese.push_back(desc);
+
+      // sets seen so far were not checked for it
+      _shapes.clear();
+    }
+
+    /** @brief Fetch the dimension the host gives each described property of a set, -1 for those it does not have */
+    void
+      PropertySetDescription::getShape(PropertySet &propSet, std::vector<int> &shape) const
+    {
+      OfxPropertySetHandle handle = propSet.propSetHandle();
+      shape.resize(_descriptions.size());
+      for(size_t i = 0; i < _descriptions.size(); i++) {
+        int dimension = -1;
+        // straight to the suite, a missing property is a shape, not an error to log
+        if(OFX::Private::gPropSuite->propGetDimension(handle, _descriptions[i]->_name.c_str(), &dimension) != kOfxStatOK)
+          dimension = -1;
+        shape[i] = dimension;
+      }
     }
 
     /** @brief Validate all the properties in the set */
@@ -245,7 +285,26 @@ namespace OFX {
       bool checkDefaults,
       bool logOrdinaryMessages)
     {
-      OFX::Log::print("START validating properties of %s.", _setName.c_str());
+      ModeEnum mode = getMode();
+      if(mode == eModeOff)
+        return;
+
+      if(mode == eModeSampled && _nValidations++ % (unsigned int) gSamplePeriod.load(std::memory_order_relaxed) != 0)
+        return;
+
+      if(mode != eModeAlways) {
+        // only validate shapes we have not seen before, the verdict on the others is already in the log,
+        // the probing is done before locking so render threads only contend for the lookup, and whether
+        // defaults are checked is part of the shape, as descriptors and instances share a description
+        static thread_local std::vector<int> shape;
+        getShape(propSet, shape);
+        shape.push_back(checkDefaults ? 1 : 0);
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(!_shapes.insert(shape).second)
+          return;
+      }
+
+      OFX_LOG_DEBUG("START validating properties of %s.", _setName.c_str());
       OFX::Log::indent();
 
       // don't print ordinary messages whilst we are checking them
@@ -259,791 +318,959 @@ namespace OFX {
       if(!logOrdinaryMessages) PropertySet::propEnableLogging();
 
       OFX::Log::outdent();
-      OFX::Log::print("STOP property validation of %s.", _setName.c_str());
+      OFX_LOG_DEBUG("STOP property validation of %s.", _setName.c_str());
     }
 
 
-    /** @brief A list of properties that all hosts must have, and will be validated against. None of these has a default, but they must exist. */
-    static PropertyDescription gHostProps[ ] =
-    {
-      // single dimensional string properties
-      PropertyDescription(kOfxPropType,  OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropName,  OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropLabel, OFX::eString, 1, eDescFinished),
-
-      // single dimensional int properties
-      PropertyDescription(kOfxImageEffectHostPropIsBackground,           OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsOverlays,           OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsMultiResolution,    OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsTiles,              OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropTemporalClipAccess,         OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsMultipleClipDepths, OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsMultipleClipPARs,   OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSetableFrameRate,           OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSetableFielding,            OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamHostPropSupportsStringAnimation,      OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamHostPropSupportsCustomInteract,       OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamHostPropSupportsChoiceAnimation,      OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamHostPropSupportsStrChoiceAnimation,   OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamHostPropSupportsBooleanAnimation,     OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamHostPropSupportsCustomAnimation,      OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamHostPropMaxParameters,                OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamHostPropMaxPages,                     OFX::eInt, 1, eDescFinished),
-
-      // variable multi dimensional string properties
-      PropertyDescription(kOfxImageEffectPropSupportedComponents,        OFX::eString, -1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportedContexts,          OFX::eString, -1, eDescFinished),
-
-      // multi dimensional int properties
-      PropertyDescription(kOfxParamHostPropPageRowColumnCount,           OFX::eInt, 2, eDescFinished),
-    };
-
-    /** @brief the property set for the global host pointer */
-    static PropertySetDescription gHostPropSet("Host Property", 
-      gHostProps, sizeof(gHostProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-
-    /** @brief A list of properties to validate the effect descriptor against */
-    static PropertyDescription gPluginDescriptorProps[ ] =
-    {
-      // string props that have no defaults that can be checked against
-      PropertyDescription(kOfxPropLabel,                      OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropShortLabel,                 OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropLongLabel,                  OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPluginPropGrouping,  OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPluginPropFilePath,             OFX::eString, 1, eDescFinished),
-
-      // string props with defaults that can be checked against
-      PropertyDescription(kOfxPropType,                             OFX::eString, 1, eDescDefault, kOfxTypeImageEffect, eDescFinished),
-      PropertyDescription(kOfxImageEffectPluginRenderThreadSafety,  OFX::eString, 1, eDescDefault, kOfxImageEffectRenderFullySafe, eDescFinished),
-
-      // int props with defaults that can be checked against
-      PropertyDescription(kOfxImageEffectPluginPropSingleInstance,         OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxImageEffectPluginPropHostFrameThreading,     OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsMultiResolution,      OFX::eInt, 1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsTiles,                OFX::eInt, 1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropTemporalClipAccess,           OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxImageEffectPluginPropFieldRenderTwiceAlways, OFX::eInt, 1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsMultipleClipDepths,   OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsMultipleClipPARs,     OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-
-      // Pointer props with defaults that can be checked against
-      PropertyDescription(kOfxImageEffectPluginPropOverlayInteractV1,      OFX::ePointer, 1, eDescDefault, (void *)(0), eDescFinished),
-
-      // string props that have variable dimension, and can't be checked against for defaults
-      PropertyDescription(kOfxImageEffectPropSupportedContexts,  OFX::eString, -1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportedPixelDepths,  OFX::eString, -1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropClipPreferencesSlaveParam,  OFX::eString, -1, eDescFinished),
-    };
-
-    /** @brief the property set for the global plugin descriptor */
-    static PropertySetDescription gPluginDescriptorPropSet("Plugin Descriptor", 
-      gPluginDescriptorProps, sizeof(gPluginDescriptorProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief A list of properties to validate the plugin instance */
-    static PropertyDescription gPluginInstanceProps[ ] =
-    {
-      // string props with defaults that can be checked against
-      PropertyDescription(kOfxPropType,                                OFX::eString,  1, eDescDefault, kOfxTypeImageEffectInstance, eDescFinished),
-
-      // int props with defaults that can be checked against
-      PropertyDescription(kOfxImageEffectInstancePropSequentialRender, OFX::eInt,     1, eDescDefault, 0, eDescFinished),
-
-      // Pointer props with defaults that can be checked against
-      PropertyDescription(kOfxPropInstanceData,                        OFX::ePointer, 1, eDescDefault, (void *)(0), eDescFinished),
-      PropertyDescription(kOfxImageEffectPropPluginHandle,             OFX::ePointer, 1, eDescFinished),
-
-      // string props that have no defaults that can be checked against
-      PropertyDescription(kOfxImageEffectPropContext,                  OFX::eString,  1, eDescFinished),
-
-      // int props with not defaults that can be checked against
-      PropertyDescription(kOfxPropIsInteractive,                       OFX::eInt,     1, eDescFinished),
-
-      // double props that can't be checked against for defaults
-      PropertyDescription(kOfxImageEffectPropProjectSize,              OFX::eDouble,  2, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropProjectExtent,            OFX::eDouble,  2, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropProjectOffset,            OFX::eDouble,  2, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropProjectPixelAspectRatio,  OFX::eDouble,  1, eDescFinished),
-      PropertyDescription(kOfxImageEffectInstancePropEffectDuration,   OFX::eDouble,  1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropFrameRate,                OFX::eDouble,  1, eDescFinished),
-    };
-
-    /** @brief the property set for a plugin instance */
-    static PropertySetDescription gPluginInstancePropSet("Plugin Instance", 
-      gPluginInstanceProps, sizeof(gPluginInstanceProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief A list of properties to validate a clip descriptor */
-    static PropertyDescription gClipDescriptorProps[ ] =
-    {
-      // string props with checkable defaults
-      PropertyDescription(kOfxPropType,                           OFX::eString, 1, eDescDefault, kOfxTypeClip, eDescFinished),
-      PropertyDescription(kOfxImageClipPropFieldExtraction,       OFX::eString, 1, eDescDefault, kOfxImageFieldDoubled, eDescFinished),
-
-      // string props with no checkable defaults
-      PropertyDescription(kOfxImageEffectPropSupportedComponents, OFX::eString,-1, eDescFinished),
-      PropertyDescription(kOfxPropName,                           OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropLabel,                          OFX::eString, 1,  eDescFinished),
-      PropertyDescription(kOfxPropShortLabel,                     OFX::eString, 1,  eDescFinished),
-      PropertyDescription(kOfxPropLongLabel,                      OFX::eString, 1, eDescFinished),
-
-      // int props with checkable defaults
-      PropertyDescription(kOfxImageEffectPropTemporalClipAccess,  OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxImageClipPropOptional,              OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxImageClipPropIsMask,                OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsTiles,       OFX::eInt, 1, eDescDefault, 1, eDescFinished),
-    };
-
-    /** @brief the property set for a clip descriptor */
-    static PropertySetDescription gClipDescriptorPropSet("Clip Descriptor", 
-      gClipDescriptorProps, sizeof(gClipDescriptorProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-
-    /** @brief A list of properties to validate a clip instance */
-    static PropertyDescription gClipInstanceProps[ ] =
-    {
-      // we can only validate this one against a fixed default
-      PropertyDescription(kOfxPropType,                           OFX::eString, 1, eDescDefault, kOfxTypeClip, eDescFinished),
-
-      // the rest are set by the plugin during description or by the host
-      PropertyDescription(kOfxPropName,                           OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropLabel,                          OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropShortLabel,                     OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropLongLabel,                      OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportedComponents, OFX::eString,-1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropFieldExtraction,       OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropPixelDepth,          OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropComponents,          OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropUnmappedPixelDepth,    OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropUnmappedComponents,    OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropPreMultiplication,   OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropFieldOrder,            OFX::eString, 1, eDescFinished),
-
-      // int props
-      PropertyDescription(kOfxImageEffectPropTemporalClipAccess, OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropOptional,             OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropIsMask,               OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropSupportsTiles,      OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropConnected,            OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropContinuousSamples,    OFX::eInt, 1, eDescFinished),
-
-      // double props
-      PropertyDescription(kOfxImagePropPixelAspectRatio,         OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropFrameRate,          OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropFrameRange,         OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropUnmappedFrameRate,  OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropUnmappedFrameRange, OFX::eDouble, 2, eDescFinished),
-    };
-
-    /** @brief the property set for a clip instance */
-    static PropertySetDescription gClipInstancePropSet("Clip Instance", gClipInstanceProps, sizeof(gClipInstanceProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief List of properties to validate an image or texture instance */
-    static PropertyDescription gImageBaseInstanceProps[ ] =
-    {
-      // this is the only property with a checkable default
-      PropertyDescription(kOfxPropType,                         OFX::eString, 1, eDescDefault, kOfxTypeImage, eDescFinished),
-
-      // all other properties are set by the host
-      PropertyDescription(kOfxImageEffectPropPixelDepth,        OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropComponents,        OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropPreMultiplication, OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImagePropField,                   OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImagePropUniqueIdentifier,        OFX::eString, 1, eDescFinished),
-
-      // double props
-      PropertyDescription(kOfxImageEffectPropRenderScale,       OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxImagePropPixelAspectRatio,        OFX::eDouble, 1, eDescFinished),
-
-      // pointer props
-      PropertyDescription(kOfxImagePropData,                    OFX::ePointer, 1, eDescFinished),
-
-      // int props
-      PropertyDescription(kOfxImagePropBounds,                  OFX::eInt, 4, eDescFinished),
-      PropertyDescription(kOfxImagePropRegionOfDefinition,      OFX::eInt, 4, eDescFinished),
-      PropertyDescription(kOfxImagePropRowBytes,                OFX::eInt, 1, eDescFinished),
+    /** @brief The descriptions of the host, effects, clips and images property sets */
+    struct ObjectSets {
+      PropertySetDescription *hostPropSet;
+      PropertySetDescription *pluginDescriptorPropSet;
+      PropertySetDescription *pluginInstancePropSet;
+      PropertySetDescription *clipDescriptorPropSet;
+      PropertySetDescription *clipInstancePropSet;
+      PropertySetDescription *imageBaseInstancePropSet;
+      PropertySetDescription *imageInstancePropSet;
+#ifdef OFX_SUPPORTS_OPENGLRENDER
+      PropertySetDescription *textureInstancePropSet;
+#endif
     };
 
-    /** @brief the property set for an image instance */
-    static PropertySetDescription gImageBaseInstancePropSet("Image or Texture Instance",
-      gImageBaseInstanceProps, sizeof(gImageBaseInstanceProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief List of properties to validate an image or texture instance */
-    static PropertyDescription gImageInstanceProps[ ] =
+    /** @brief the object property set descriptions, built the first time one of them is needed */
+    static ObjectSets &getObjectSets(void)
     {
-      // pointer props
-      PropertyDescription(kOfxImagePropData,                    OFX::ePointer, 1, eDescFinished),
-    };
+      /** @brief A list of properties that all hosts must have, and will be validated against. None of these has a default, but they must exist. */
+      static PropertyDescription hostProps[ ] =
+      {
+        // single dimensional string properties
+        PropertyDescription(kOfxPropType,  OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropName,  OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropLabel, OFX::eString, 1, eDescFinished),
+
+        // single dimensional int properties
+        PropertyDescription(kOfxImageEffectHostPropIsBackground,           OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsOverlays,           OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsMultiResolution,    OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsTiles,              OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropTemporalClipAccess,         OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsMultipleClipDepths, OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsMultipleClipPARs,   OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSetableFrameRate,           OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSetableFielding,            OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamHostPropSupportsStringAnimation,      OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamHostPropSupportsCustomInteract,       OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamHostPropSupportsChoiceAnimation,      OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamHostPropSupportsStrChoiceAnimation,   OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamHostPropSupportsBooleanAnimation,     OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamHostPropSupportsCustomAnimation,      OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamHostPropMaxParameters,                OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamHostPropMaxPages,                     OFX::eInt, 1, eDescFinished),
+
+        // variable multi dimensional string properties
+        PropertyDescription(kOfxImageEffectPropSupportedComponents,        OFX::eString, -1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportedContexts,          OFX::eString, -1, eDescFinished),
+
+        // multi dimensional int properties
+        PropertyDescription(kOfxParamHostPropPageRowColumnCount,           OFX::eInt, 2, eDescFinished),
+      };
+
+      /** @brief the property set for the global host pointer */
+      static PropertySetDescription hostPropSet("Host Property", 
+        hostProps, sizeof(hostProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+
+      /** @brief A list of properties to validate the effect descriptor against */
+      static PropertyDescription pluginDescriptorProps[ ] =
+      {
+        // string props that have no defaults that can be checked against
+        PropertyDescription(kOfxPropLabel,                      OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropShortLabel,                 OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropLongLabel,                  OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPluginPropGrouping,  OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPluginPropFilePath,             OFX::eString, 1, eDescFinished),
+
+        // string props with defaults that can be checked against
+        PropertyDescription(kOfxPropType,                             OFX::eString, 1, eDescDefault, kOfxTypeImageEffect, eDescFinished),
+        PropertyDescription(kOfxImageEffectPluginRenderThreadSafety,  OFX::eString, 1, eDescDefault, kOfxImageEffectRenderFullySafe, eDescFinished),
+
+        // int props with defaults that can be checked against
+        PropertyDescription(kOfxImageEffectPluginPropSingleInstance,         OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxImageEffectPluginPropHostFrameThreading,     OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsMultiResolution,      OFX::eInt, 1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsTiles,                OFX::eInt, 1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropTemporalClipAccess,           OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxImageEffectPluginPropFieldRenderTwiceAlways, OFX::eInt, 1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsMultipleClipDepths,   OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsMultipleClipPARs,     OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+
+        // Pointer props with defaults that can be checked against
+        PropertyDescription(kOfxImageEffectPluginPropOverlayInteractV1,      OFX::ePointer, 1, eDescDefault, (void *)(0), eDescFinished),
+
+        // string props that have variable dimension, and can't be checked against for defaults
+        PropertyDescription(kOfxImageEffectPropSupportedContexts,  OFX::eString, -1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportedPixelDepths,  OFX::eString, -1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropClipPreferencesSlaveParam,  OFX::eString, -1, eDescFinished),
+      };
+
+      /** @brief the property set for the global plugin descriptor */
+      static PropertySetDescription pluginDescriptorPropSet("Plugin Descriptor", 
+        pluginDescriptorProps, sizeof(pluginDescriptorProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief A list of properties to validate the plugin instance */
+      static PropertyDescription pluginInstanceProps[ ] =
+      {
+        // string props with defaults that can be checked against
+        PropertyDescription(kOfxPropType,                                OFX::eString,  1, eDescDefault, kOfxTypeImageEffectInstance, eDescFinished),
+
+        // int props with defaults that can be checked against
+        PropertyDescription(kOfxImageEffectInstancePropSequentialRender, OFX::eInt,     1, eDescDefault, 0, eDescFinished),
+
+        // Pointer props with defaults that can be checked against
+        PropertyDescription(kOfxPropInstanceData,                        OFX::ePointer, 1, eDescDefault, (void *)(0), eDescFinished),
+        PropertyDescription(kOfxImageEffectPropPluginHandle,             OFX::ePointer, 1, eDescFinished),
+
+        // string props that have no defaults that can be checked against
+        PropertyDescription(kOfxImageEffectPropContext,                  OFX::eString,  1, eDescFinished),
+
+        // int props with not defaults that can be checked against
+        PropertyDescription(kOfxPropIsInteractive,                       OFX::eInt,     1, eDescFinished),
+
+        // double props that can't be checked against for defaults
+        PropertyDescription(kOfxImageEffectPropProjectSize,              OFX::eDouble,  2, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropProjectExtent,            OFX::eDouble,  2, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropProjectOffset,            OFX::eDouble,  2, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropProjectPixelAspectRatio,  OFX::eDouble,  1, eDescFinished),
+        PropertyDescription(kOfxImageEffectInstancePropEffectDuration,   OFX::eDouble,  1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropFrameRate,                OFX::eDouble,  1, eDescFinished),
+      };
+
+      /** @brief the property set for a plugin instance */
+      static PropertySetDescription pluginInstancePropSet("Plugin Instance", 
+        pluginInstanceProps, sizeof(pluginInstanceProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief A list of properties to validate a clip descriptor */
+      static PropertyDescription clipDescriptorProps[ ] =
+      {
+        // string props with checkable defaults
+        PropertyDescription(kOfxPropType,                           OFX::eString, 1, eDescDefault, kOfxTypeClip, eDescFinished),
+        PropertyDescription(kOfxImageClipPropFieldExtraction,       OFX::eString, 1, eDescDefault, kOfxImageFieldDoubled, eDescFinished),
+
+        // string props with no checkable defaults
+        PropertyDescription(kOfxImageEffectPropSupportedComponents, OFX::eString,-1, eDescFinished),
+        PropertyDescription(kOfxPropName,                           OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropLabel,                          OFX::eString, 1,  eDescFinished),
+        PropertyDescription(kOfxPropShortLabel,                     OFX::eString, 1,  eDescFinished),
+        PropertyDescription(kOfxPropLongLabel,                      OFX::eString, 1, eDescFinished),
+
+        // int props with checkable defaults
+        PropertyDescription(kOfxImageEffectPropTemporalClipAccess,  OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxImageClipPropOptional,              OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxImageClipPropIsMask,                OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsTiles,       OFX::eInt, 1, eDescDefault, 1, eDescFinished),
+      };
+
+      /** @brief the property set for a clip descriptor */
+      static PropertySetDescription clipDescriptorPropSet("Clip Descriptor", 
+        clipDescriptorProps, sizeof(clipDescriptorProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+
+      /** @brief A list of properties to validate a clip instance */
+      static PropertyDescription clipInstanceProps[ ] =
+      {
+        // we can only validate this one against a fixed default
+        PropertyDescription(kOfxPropType,                           OFX::eString, 1, eDescDefault, kOfxTypeClip, eDescFinished),
+
+        // the rest are set by the plugin during description or by the host
+        PropertyDescription(kOfxPropName,                           OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropLabel,                          OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropShortLabel,                     OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropLongLabel,                      OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportedComponents, OFX::eString,-1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropFieldExtraction,       OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropPixelDepth,          OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropComponents,          OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropUnmappedPixelDepth,    OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropUnmappedComponents,    OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropPreMultiplication,   OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropFieldOrder,            OFX::eString, 1, eDescFinished),
+
+        // int props
+        PropertyDescription(kOfxImageEffectPropTemporalClipAccess, OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropOptional,             OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropIsMask,               OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropSupportsTiles,      OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropConnected,            OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropContinuousSamples,    OFX::eInt, 1, eDescFinished),
+
+        // double props
+        PropertyDescription(kOfxImagePropPixelAspectRatio,         OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropFrameRate,          OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropFrameRange,         OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropUnmappedFrameRate,  OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropUnmappedFrameRange, OFX::eDouble, 2, eDescFinished),
+      };
+
+      /** @brief the property set for a clip instance */
+      static PropertySetDescription clipInstancePropSet("Clip Instance", clipInstanceProps, sizeof(clipInstanceProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief List of properties to validate an image or texture instance */
+      static PropertyDescription imageBaseInstanceProps[ ] =
+      {
+        // this is the only property with a checkable default
+        PropertyDescription(kOfxPropType,                         OFX::eString, 1, eDescDefault, kOfxTypeImage, eDescFinished),
+
+        // all other properties are set by the host
+        PropertyDescription(kOfxImageEffectPropPixelDepth,        OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropComponents,        OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropPreMultiplication, OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImagePropField,                   OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImagePropUniqueIdentifier,        OFX::eString, 1, eDescFinished),
+
+        // double props
+        PropertyDescription(kOfxImageEffectPropRenderScale,       OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxImagePropPixelAspectRatio,        OFX::eDouble, 1, eDescFinished),
+
+        // pointer props
+        PropertyDescription(kOfxImagePropData,                    OFX::ePointer, 1, eDescFinished),
+
+        // int props
+        PropertyDescription(kOfxImagePropBounds,                  OFX::eInt, 4, eDescFinished),
+        PropertyDescription(kOfxImagePropRegionOfDefinition,      OFX::eInt, 4, eDescFinished),
+        PropertyDescription(kOfxImagePropRowBytes,                OFX::eInt, 1, eDescFinished),
+      };
+
+      /** @brief the property set for an image instance */
+      static PropertySetDescription imageBaseInstancePropSet("Image or Texture Instance",
+        imageBaseInstanceProps, sizeof(imageBaseInstanceProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief List of properties to validate an image or texture instance */
+      static PropertyDescription imageInstanceProps[ ] =
+      {
+        // pointer props
+        PropertyDescription(kOfxImagePropData,                    OFX::ePointer, 1, eDescFinished),
+      };
 
-    /** @brief the property set for an image instance */
-    static PropertySetDescription gImageInstancePropSet("Image Instance",
-      gImageInstanceProps, sizeof(gImageInstanceProps)/sizeof(PropertyDescription),
-      NULLPTR);
+      /** @brief the property set for an image instance */
+      static PropertySetDescription imageInstancePropSet("Image Instance",
+        imageInstanceProps, sizeof(imageInstanceProps)/sizeof(PropertyDescription),
+        NULLPTR);
 
 #ifdef OFX_SUPPORTS_OPENGLRENDER
-    /** @brief List of properties to validate an image or texture instance */
-    static PropertyDescription gTextureInstanceProps[ ] =
-    {
-      // pointer props
-      PropertyDescription(kOfxImageEffectPropOpenGLTextureIndex, OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropOpenGLTextureTarget, OFX::eInt, 1, eDescFinished),
-    };
+      /** @brief List of properties to validate an image or texture instance */
+      static PropertyDescription textureInstanceProps[ ] =
+      {
+        // pointer props
+        PropertyDescription(kOfxImageEffectPropOpenGLTextureIndex, OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropOpenGLTextureTarget, OFX::eInt, 1, eDescFinished),
+      };
+
+      /** @brief the property set for an image instance */
+      static PropertySetDescription textureInstancePropSet("Texture Instance",
+        textureInstanceProps, sizeof(textureInstanceProps)/sizeof(PropertyDescription),
+        NULLPTR);
+#endif
 
-    /** @brief the property set for an image instance */
-    static PropertySetDescription gTextureInstancePropSet("Texture Instance",
-      gTextureInstanceProps, sizeof(gTextureInstanceProps)/sizeof(PropertyDescription),
-      NULLPTR);
+      static ObjectSets sets = {
+        &hostPropSet,
+        &pluginDescriptorPropSet,
+        &pluginInstancePropSet,
+        &clipDescriptorPropSet,
+        &clipInstancePropSet,
+        &imageBaseInstancePropSet,
+        &imageInstancePropSet,
+#ifdef OFX_SUPPORTS_OPENGLRENDER
+        &textureInstancePropSet
 #endif
+      };
+      return sets;
+    }
+
 
     ////////////////////////////////////////////////////////////////////////////////
     // Action in/out args properties 
     ////////////////////////////////////////////////////////////////////////////////
 
-    /** @brief kOfxImageEffectActionDescribeInContext actions's inargs properties */
-    static PropertyDescription gDescribeInContextActionInArgProps[ ] =
-    {
-      PropertyDescription(kOfxImageEffectPropContext,   OFX::eString, 1, eDescFinished),
-    };
-
-    /** @brief the property set for describe in context action  */
-    static PropertySetDescription gDescribeInContextActionInArgPropSet(kOfxImageEffectActionDescribeInContext " in argument", 
-      gDescribeInContextActionInArgProps, sizeof(gDescribeInContextActionInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief kOfxImageEffectActionRender action's inargs properties */
-    static PropertyDescription gRenderActionInArgProps[ ] =
-    {
-      PropertyDescription(kOfxPropTime,                     OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRenderScale,   OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRenderWindow,  OFX::eInt,    4, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropFieldToRender, OFX::eString, 1, eDescFinished),
-      // The following appeared in OFX 1.2, and are thus not mandatory
-      //PropertyDescription(kOfxImageEffectPropSequentialRenderStatus,  OFX::eInt,    1, eDescFinished),
-      //PropertyDescription(kOfxImageEffectPropInteractiveRenderStatus, OFX::eInt,    1, eDescFinished),
-      // The following appeared in OFX 1.4,  and is thus not mandatory
-      //PropertyDescription(kOfxImageEffectPropRenderQualityDraft, OFX::eInt,    1, eDescFinished),
-    };
-
-    /** @brief kOfxImageEffectActionRender property set */
-    static PropertySetDescription gRenderActionInArgPropSet(kOfxImageEffectActionRender " in argument", 
-      gRenderActionInArgProps, sizeof(gRenderActionInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief kOfxImageEffectActionBeginSequenceRender action's inargs properties */
-    static PropertyDescription gBeginSequenceRenderActionInArgProps[ ] =
-    {
-      PropertyDescription(kOfxImageEffectPropFrameRange,  OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropFrameStep,   OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRenderScale, OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxPropIsInteractive,          OFX::eInt, 1, eDescFinished),
-      // The following appeared in OFX 1.2, and are thus not mandatory
-      //PropertyDescription(kOfxImageEffectPropSequentialRenderStatus,  OFX::eInt,    1, eDescFinished),
-      //PropertyDescription(kOfxImageEffectPropInteractiveRenderStatus, OFX::eInt,    1, eDescFinished),
-    };
-
-    /** @brief kOfxImageEffectActionBeginSequenceRender property set */
-    static PropertySetDescription gBeginSequenceRenderActionInArgPropSet(kOfxImageEffectActionBeginSequenceRender " in argument", 
-      gBeginSequenceRenderActionInArgProps, sizeof(gBeginSequenceRenderActionInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief kOfxImageEffectActionEndSequenceRender action's inargs properties */
-    static PropertyDescription gEndSequenceRenderActionInArgProps[ ] =
-    {
-      PropertyDescription(kOfxImageEffectPropFrameRange,  OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropFrameStep,   OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRenderScale, OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxPropIsInteractive,          OFX::eInt, 1, eDescFinished),
-      // The following appeared in OFX 1.2, and are thus not mandatory
-      //PropertyDescription(kOfxImageEffectPropSequentialRenderStatus,  OFX::eInt,    1, eDescFinished),
-      //PropertyDescription(kOfxImageEffectPropInteractiveRenderStatus, OFX::eInt,    1, eDescFinished),
-    };
-
-    /** @brief kOfxImageEffectActionEndSequenceRender property set */
-    static PropertySetDescription gEndSequenceRenderActionInArgPropSet(kOfxImageEffectActionEndSequenceRender " in argument", 
-      gEndSequenceRenderActionInArgProps, sizeof(gEndSequenceRenderActionInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief kOfxImageEffectActionIsIdentity action's inargs properties */
-    static PropertyDescription gIsIdentityActionInArgProps[ ] =
-    {
-      PropertyDescription(kOfxPropTime,                     OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRenderScale,   OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRenderWindow,  OFX::eInt,    4, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropFieldToRender, OFX::eString, 1, eDescFinished),
-    };
-
-    /** @brief kOfxImageEffectActionIsIdentity property set */
-    static PropertySetDescription gIsIdentityActionInArgPropSet(kOfxImageEffectActionIsIdentity " in argument", 
-      gIsIdentityActionInArgProps, sizeof(gIsIdentityActionInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief kOfxImageEffectActionIsIdentity action's outargs properties */
-    static PropertyDescription gIsIdentityActionOutArgProps[ ] =
-    {
-      PropertyDescription(kOfxPropTime, OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxPropName, OFX::eString, 1, eDescFinished),
-    };
-
-    /** @brief kOfxImageEffectActionIsIdentity property set */
-    static PropertySetDescription gIsIdentityActionOutArgPropSet(kOfxImageEffectActionIsIdentity " out argument", 
-      gIsIdentityActionOutArgProps, sizeof(gIsIdentityActionOutArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief kOfxImageEffectActionGetRegionOfDefinition action's inargs properties */
-    static PropertyDescription gGetRegionOfDefinitionInArgProps[ ] =
-    {
-      PropertyDescription(kOfxPropTime,                     OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRenderScale,   OFX::eDouble, 2, eDescFinished),
+    /** @brief The descriptions of the action argument property sets */
+    struct ActionSets {
+      PropertySetDescription *describeInContextActionInArgPropSet;
+      PropertySetDescription *renderActionInArgPropSet;
+      PropertySetDescription *beginSequenceRenderActionInArgPropSet;
+      PropertySetDescription *endSequenceRenderActionInArgPropSet;
+      PropertySetDescription *isIdentityActionInArgPropSet;
+      PropertySetDescription *isIdentityActionOutArgPropSet;
+      PropertySetDescription *getRegionOfDefinitionInArgPropSet;
+      PropertySetDescription *getRegionOfDefinitionOutArgPropSet;
+      PropertySetDescription *getRegionOfInterestInArgPropSet;
+      PropertySetDescription *getTimeDomainOutArgPropSet;
+      PropertySetDescription *getFramesNeededInArgPropSet;
+      PropertySetDescription *getClipPreferencesOutArgPropSet;
+      PropertySetDescription *instanceChangedInArgPropSet;
+      PropertySetDescription *beginInstanceChangedInArgPropSet;
+      PropertySetDescription *endInstanceChangedInArgPropSet;
     };
 
-    /** @brief kOfxImageEffectActionGetRegionOfDefinition property set */
-    static PropertySetDescription gGetRegionOfDefinitionInArgPropSet(kOfxImageEffectActionGetRegionOfDefinition " in argument", 
-      gGetRegionOfDefinitionInArgProps, sizeof(gGetRegionOfDefinitionInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
-
-    /** @brief kOfxImageEffectActionGetRegionOfDefinition action's outargs properties */
-    static PropertyDescription gGetRegionOfDefinitionOutArgProps[ ] =
+    /** @brief the action property set descriptions, built the first time one of them is needed */
+    static ActionSets &getActionSets(void)
     {
-      PropertyDescription(kOfxImageEffectPropRegionOfDefinition,   OFX::eDouble, 4, eDescFinished),
-    };
-
-    /** @brief kOfxImageEffectActionGetRegionOfDefinition  property set */
-    static PropertySetDescription gGetRegionOfDefinitionOutArgPropSet(kOfxImageEffectActionGetRegionOfDefinition " out argument",
-      gGetRegionOfDefinitionOutArgProps, sizeof(gGetRegionOfDefinitionOutArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
+      /** @brief kOfxImageEffectActionDescribeInContext actions's inargs properties */
+      static PropertyDescription describeInContextActionInArgProps[ ] =
+      {
+        PropertyDescription(kOfxImageEffectPropContext,   OFX::eString, 1, eDescFinished),
+      };
 
-    /** @brief kOfxImageEffectActionGetRegionsOfInterest action's inargs properties */
-    static PropertyDescription gGetRegionOfInterestInArgProps[ ] =
-    {
-      PropertyDescription(kOfxPropTime,                          OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRenderScale,        OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRegionOfInterest,   OFX::eDouble, 4, eDescFinished),
-    };
+      /** @brief the property set for describe in context action  */
+      static PropertySetDescription describeInContextActionInArgPropSet(kOfxImageEffectActionDescribeInContext " in argument", 
+        describeInContextActionInArgProps, sizeof(describeInContextActionInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
 
-    /** @brief kOfxImageEffectActionGetRegionsOfInterest property set */
-    static PropertySetDescription gGetRegionOfInterestInArgPropSet(kOfxImageEffectActionGetRegionsOfInterest "in argument",
-      gGetRegionOfInterestInArgProps, sizeof(gGetRegionOfInterestInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
+      /** @brief kOfxImageEffectActionRender action's inargs properties */
+      static PropertyDescription renderActionInArgProps[ ] =
+      {
+        PropertyDescription(kOfxPropTime,                     OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRenderScale,   OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRenderWindow,  OFX::eInt,    4, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropFieldToRender, OFX::eString, 1, eDescFinished),
+        // The following appeared in OFX 1.2, and are thus not mandatory
+        //PropertyDescription(kOfxImageEffectPropSequentialRenderStatus,  OFX::eInt,    1, eDescFinished),
+        //PropertyDescription(kOfxImageEffectPropInteractiveRenderStatus, OFX::eInt,    1, eDescFinished),
+        // The following appeared in OFX 1.4,  and is thus not mandatory
+        //PropertyDescription(kOfxImageEffectPropRenderQualityDraft, OFX::eInt,    1, eDescFinished),
+      };
+
+      /** @brief kOfxImageEffectActionRender property set */
+      static PropertySetDescription renderActionInArgPropSet(kOfxImageEffectActionRender " in argument", 
+        renderActionInArgProps, sizeof(renderActionInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief kOfxImageEffectActionBeginSequenceRender action's inargs properties */
+      static PropertyDescription beginSequenceRenderActionInArgProps[ ] =
+      {
+        PropertyDescription(kOfxImageEffectPropFrameRange,  OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropFrameStep,   OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRenderScale, OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxPropIsInteractive,          OFX::eInt, 1, eDescFinished),
+        // The following appeared in OFX 1.2, and are thus not mandatory
+        //PropertyDescription(kOfxImageEffectPropSequentialRenderStatus,  OFX::eInt,    1, eDescFinished),
+        //PropertyDescription(kOfxImageEffectPropInteractiveRenderStatus, OFX::eInt,    1, eDescFinished),
+      };
+
+      /** @brief kOfxImageEffectActionBeginSequenceRender property set */
+      static PropertySetDescription beginSequenceRenderActionInArgPropSet(kOfxImageEffectActionBeginSequenceRender " in argument", 
+        beginSequenceRenderActionInArgProps, sizeof(beginSequenceRenderActionInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief kOfxImageEffectActionEndSequenceRender action's inargs properties */
+      static PropertyDescription endSequenceRenderActionInArgProps[ ] =
+      {
+        PropertyDescription(kOfxImageEffectPropFrameRange,  OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropFrameStep,   OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRenderScale, OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxPropIsInteractive,          OFX::eInt, 1, eDescFinished),
+        // The following appeared in OFX 1.2, and are thus not mandatory
+        //PropertyDescription(kOfxImageEffectPropSequentialRenderStatus,  OFX::eInt,    1, eDescFinished),
+        //PropertyDescription(kOfxImageEffectPropInteractiveRenderStatus, OFX::eInt,    1, eDescFinished),
+      };
+
+      /** @brief kOfxImageEffectActionEndSequenceRender property set */
+      static PropertySetDescription endSequenceRenderActionInArgPropSet(kOfxImageEffectActionEndSequenceRender " in argument", 
+        endSequenceRenderActionInArgProps, sizeof(endSequenceRenderActionInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief kOfxImageEffectActionIsIdentity action's inargs properties */
+      static PropertyDescription isIdentityActionInArgProps[ ] =
+      {
+        PropertyDescription(kOfxPropTime,                     OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRenderScale,   OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRenderWindow,  OFX::eInt,    4, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropFieldToRender, OFX::eString, 1, eDescFinished),
+      };
+
+      /** @brief kOfxImageEffectActionIsIdentity property set */
+      static PropertySetDescription isIdentityActionInArgPropSet(kOfxImageEffectActionIsIdentity " in argument", 
+        isIdentityActionInArgProps, sizeof(isIdentityActionInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief kOfxImageEffectActionIsIdentity action's outargs properties */
+      static PropertyDescription isIdentityActionOutArgProps[ ] =
+      {
+        PropertyDescription(kOfxPropTime, OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxPropName, OFX::eString, 1, eDescFinished),
+      };
 
-    /** @brief kOfxImageEffectActionGetTimeDomain action's outargs properties */
-    static PropertyDescription gGetTimeDomainOutArgProps[ ] =
-    {
-      PropertyDescription(kOfxImageEffectPropFrameRange,   OFX::eDouble, 2, eDescFinished),
-    };
+      /** @brief kOfxImageEffectActionIsIdentity property set */
+      static PropertySetDescription isIdentityActionOutArgPropSet(kOfxImageEffectActionIsIdentity " out argument", 
+        isIdentityActionOutArgProps, sizeof(isIdentityActionOutArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
 
-    /** @brief kOfxImageEffectActionGetTimeDomain property set */
-    static PropertySetDescription gGetTimeDomainOutArgPropSet(kOfxImageEffectActionGetTimeDomain " out argument", 
-      gGetTimeDomainOutArgProps, sizeof(gGetTimeDomainOutArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
+      /** @brief kOfxImageEffectActionGetRegionOfDefinition action's inargs properties */
+      static PropertyDescription getRegionOfDefinitionInArgProps[ ] =
+      {
+        PropertyDescription(kOfxPropTime,                     OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRenderScale,   OFX::eDouble, 2, eDescFinished),
+      };
 
-    /** @brief kOfxImageEffectActionGetFramesNeeded action's inargs properties */
-    static PropertyDescription gGetFramesNeededInArgProps[ ] =
-    {
-      PropertyDescription(kOfxPropTime,                     OFX::eDouble, 1, eDescFinished),
-    };
+      /** @brief kOfxImageEffectActionGetRegionOfDefinition property set */
+      static PropertySetDescription getRegionOfDefinitionInArgPropSet(kOfxImageEffectActionGetRegionOfDefinition " in argument", 
+        getRegionOfDefinitionInArgProps, sizeof(getRegionOfDefinitionInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
 
-    /** @brief kOfxImageEffectActionGetFramesNeeded  property set */
-    static PropertySetDescription gGetFramesNeededInArgPropSet(kOfxImageEffectActionGetFramesNeeded " in argument", 
-      gGetFramesNeededInArgProps, sizeof(gGetFramesNeededInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
+      /** @brief kOfxImageEffectActionGetRegionOfDefinition action's outargs properties */
+      static PropertyDescription getRegionOfDefinitionOutArgProps[ ] =
+      {
+        PropertyDescription(kOfxImageEffectPropRegionOfDefinition,   OFX::eDouble, 4, eDescFinished),
+      };
 
-    /** @brief kOfxImageEffectActionGetClipPreferences action's outargs properties */
-    static PropertyDescription gGetClipPreferencesOutArgProps[ ] =
-    {
-      PropertyDescription(kOfxImageEffectPropFrameRate,         OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropFieldOrder,          OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxImageClipPropContinuousSamples,   OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxImageEffectFrameVarying,          OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropPreMultiplication, OFX::eString, 1, eDescFinished),
-    };
+      /** @brief kOfxImageEffectActionGetRegionOfDefinition  property set */
+      static PropertySetDescription getRegionOfDefinitionOutArgPropSet(kOfxImageEffectActionGetRegionOfDefinition " out argument",
+        getRegionOfDefinitionOutArgProps, sizeof(getRegionOfDefinitionOutArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
 
-    /** @brief kOfxImageEffectActionGetClipPreferences property set */
-    static PropertySetDescription gGetClipPreferencesOutArgPropSet(kOfxImageEffectActionGetClipPreferences " out argument", 
-      gGetClipPreferencesOutArgProps, sizeof(gGetClipPreferencesOutArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
+      /** @brief kOfxImageEffectActionGetRegionsOfInterest action's inargs properties */
+      static PropertyDescription getRegionOfInterestInArgProps[ ] =
+      {
+        PropertyDescription(kOfxPropTime,                          OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRenderScale,        OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRegionOfInterest,   OFX::eDouble, 4, eDescFinished),
+      };
+
+      /** @brief kOfxImageEffectActionGetRegionsOfInterest property set */
+      static PropertySetDescription getRegionOfInterestInArgPropSet(kOfxImageEffectActionGetRegionsOfInterest "in argument",
+        getRegionOfInterestInArgProps, sizeof(getRegionOfInterestInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief kOfxImageEffectActionGetTimeDomain action's outargs properties */
+      static PropertyDescription getTimeDomainOutArgProps[ ] =
+      {
+        PropertyDescription(kOfxImageEffectPropFrameRange,   OFX::eDouble, 2, eDescFinished),
+      };
 
-    /** @brief kOfxActionInstanceChanged action's inargs properties */
-    static PropertyDescription gInstanceChangedInArgProps[ ] =
-    {
-      PropertyDescription(kOfxPropType,                   OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropName,                   OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropChangeReason,           OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropTime,                   OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxImageEffectPropRenderScale, OFX::eDouble, 2, eDescFinished),
-    };
+      /** @brief kOfxImageEffectActionGetTimeDomain property set */
+      static PropertySetDescription getTimeDomainOutArgPropSet(kOfxImageEffectActionGetTimeDomain " out argument", 
+        getTimeDomainOutArgProps, sizeof(getTimeDomainOutArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
 
-    /** @brief kOfxActionInstanceChanged property set */
-    static PropertySetDescription gInstanceChangedInArgPropSet(kOfxActionInstanceChanged " in argument",
-      gInstanceChangedInArgProps, sizeof(gInstanceChangedInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
+      /** @brief kOfxImageEffectActionGetFramesNeeded action's inargs properties */
+      static PropertyDescription getFramesNeededInArgProps[ ] =
+      {
+        PropertyDescription(kOfxPropTime,                     OFX::eDouble, 1, eDescFinished),
+      };
 
-    /** @brief kOfxActionBeginInstanceChanged and kOfxActionEndInstanceChanged actions' inargs properties */
-    static PropertyDescription gBeginEndInstanceChangedInArgProps[ ] =
-    {
-      PropertyDescription(kOfxPropChangeReason,           OFX::eString, 1, eDescFinished),
-    };
+      /** @brief kOfxImageEffectActionGetFramesNeeded  property set */
+      static PropertySetDescription getFramesNeededInArgPropSet(kOfxImageEffectActionGetFramesNeeded " in argument", 
+        getFramesNeededInArgProps, sizeof(getFramesNeededInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
 
-    /** @brief kOfxActionBeginInstanceChanged property set */
-    static PropertySetDescription gBeginInstanceChangedInArgPropSet(kOfxActionBeginInstanceChanged " in argument",
-      gBeginEndInstanceChangedInArgProps, sizeof(gBeginEndInstanceChangedInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
-    /** @brief kOfxActionEndInstanceChanged property set */
-    static PropertySetDescription gEndInstanceChangedInArgPropSet(kOfxActionEndInstanceChanged " in argument",
-      gBeginEndInstanceChangedInArgProps, sizeof(gBeginEndInstanceChangedInArgProps)/sizeof(PropertyDescription),
-      NULLPTR);
+      /** @brief kOfxImageEffectActionGetClipPreferences action's outargs properties */
+      static PropertyDescription getClipPreferencesOutArgProps[ ] =
+      {
+        PropertyDescription(kOfxImageEffectPropFrameRate,         OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropFieldOrder,          OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxImageClipPropContinuousSamples,   OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxImageEffectFrameVarying,          OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropPreMultiplication, OFX::eString, 1, eDescFinished),
+      };
+
+      /** @brief kOfxImageEffectActionGetClipPreferences property set */
+      static PropertySetDescription getClipPreferencesOutArgPropSet(kOfxImageEffectActionGetClipPreferences " out argument", 
+        getClipPreferencesOutArgProps, sizeof(getClipPreferencesOutArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief kOfxActionInstanceChanged action's inargs properties */
+      static PropertyDescription instanceChangedInArgProps[ ] =
+      {
+        PropertyDescription(kOfxPropType,                   OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropName,                   OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropChangeReason,           OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropTime,                   OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxImageEffectPropRenderScale, OFX::eDouble, 2, eDescFinished),
+      };
+
+      /** @brief kOfxActionInstanceChanged property set */
+      static PropertySetDescription instanceChangedInArgPropSet(kOfxActionInstanceChanged " in argument",
+        instanceChangedInArgProps, sizeof(instanceChangedInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      /** @brief kOfxActionBeginInstanceChanged and kOfxActionEndInstanceChanged actions' inargs properties */
+      static PropertyDescription beginEndInstanceChangedInArgProps[ ] =
+      {
+        PropertyDescription(kOfxPropChangeReason,           OFX::eString, 1, eDescFinished),
+      };
+
+      /** @brief kOfxActionBeginInstanceChanged property set */
+      static PropertySetDescription beginInstanceChangedInArgPropSet(kOfxActionBeginInstanceChanged " in argument",
+        beginEndInstanceChangedInArgProps, sizeof(beginEndInstanceChangedInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
+      /** @brief kOfxActionEndInstanceChanged property set */
+      static PropertySetDescription endInstanceChangedInArgPropSet(kOfxActionEndInstanceChanged " in argument",
+        beginEndInstanceChangedInArgProps, sizeof(beginEndInstanceChangedInArgProps)/sizeof(PropertyDescription),
+        NULLPTR);
+
+      static ActionSets sets = {
+        &describeInContextActionInArgPropSet,
+        &renderActionInArgPropSet,
+        &beginSequenceRenderActionInArgPropSet,
+        &endSequenceRenderActionInArgPropSet,
+        &isIdentityActionInArgPropSet,
+        &isIdentityActionOutArgPropSet,
+        &getRegionOfDefinitionInArgPropSet,
+        &getRegionOfDefinitionOutArgPropSet,
+        &getRegionOfInterestInArgPropSet,
+        &getTimeDomainOutArgPropSet,
+        &getFramesNeededInArgPropSet,
+        &getClipPreferencesOutArgPropSet,
+        &instanceChangedInArgPropSet,
+        &beginInstanceChangedInArgPropSet,
+        &endInstanceChangedInArgPropSet
+      };
+      return sets;
+    }
 
 
     ////////////////////////////////////////////////////////////////////////////////
     // parameter properties 
     ////////////////////////////////////////////////////////////////////////////////
 
-    /** @brief Basic parameter descriptor properties */
-    static PropertyDescription gBasicParamProps[ ] =
-    {
-      PropertyDescription(kOfxPropType,                   OFX::eString, 1, eDescDefault, kOfxTypeParameter, eDescFinished),
-      PropertyDescription(kOfxPropName,                   OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropLabel,                  OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropShortLabel,             OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxPropLongLabel,              OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropType,              OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropSecret,            OFX::eInt,    1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxParamPropHint,              OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropScriptName,        OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropParent,            OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropEnabled,           OFX::eInt,    1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropDataPtr,           OFX::ePointer,1, eDescDefault, (void *)(0), eDescFinished),
+    /** @brief The descriptions of the parameter property sets */
+    struct ParamSets {
+      PropertySetDescription *int1DParamPropSet;
+      PropertySetDescription *int2DParamPropSet;
+      PropertySetDescription *int3DParamPropSet;
+      PropertySetDescription *double1DParamPropSet;
+      PropertySetDescription *double2DParamPropSet;
+      PropertySetDescription *double3DParamPropSet;
+      PropertySetDescription *rgbParamPropSet;
+      PropertySetDescription *rgbaParamPropSet;
+      PropertySetDescription *stringParamPropSet;
+      PropertySetDescription *customParamPropSet;
+      PropertySetDescription *booleanParamPropSet;
+      PropertySetDescription *choiceParamPropSet;
+      PropertySetDescription *strChoiceParamPropSet;
+      PropertySetDescription *pushButtonParamPropSet;
+      PropertySetDescription *groupParamPropSet;
+      PropertySetDescription *pageParamPropSet;
+      PropertySetDescription *parametricParamPropSet;
     };
 
-
-    /** @brief Props for params that can have an interact override their UI */
-    static PropertyDescription gInteractOverideParamProps[ ] =
+    /** @brief Add the descriptions that depend on how the host behaves, returns whether it could */
+    static bool addHostDependentProperties(ParamSets &sets)
     {
-      PropertyDescription(kOfxParamPropInteractV1,           OFX::ePointer,1, eDescDefault, (void *)(0), eDescFinished),
-      PropertyDescription(kOfxParamPropInteractSize,         OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropInteractSizeAspect,   OFX::eDouble, 1, eDescDefault, 1.0, eDescFinished),
-      PropertyDescription(kOfxParamPropInteractMinimumSize,  OFX::eDouble, 2, eDescDefault, 10, 10, eDescFinished),
-      PropertyDescription(kOfxParamPropInteractPreferedSize, OFX::eInt,    2, eDescDefault, 10, 10, eDescFinished),
-    };
+      const ImageEffectHostDescription *host = getImageEffectHostDescription();
+      if(!host)
+        return false;
+
+      // create new property descriptions depending on certain host states
+      PropertyDescription *desc;
+
+      // do custom params animate ?
+      desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
+        eDescDefault, int(host->supportsCustomAnimation),
+        eDescFinished);
+      sets.customParamPropSet->addProperty(desc, true);
+
+      // do strings animate ?
+      desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
+        eDescDefault, int(host->supportsStringAnimation),
+        eDescFinished);
+      sets.stringParamPropSet->addProperty(desc, true);
+
+      // do choice params animate      
+      desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
+        eDescDefault, int(host->supportsChoiceAnimation),
+        eDescFinished);
+      sets.choiceParamPropSet->addProperty(desc, true);
+
+      // do string choice params animate
+      desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
+        eDescDefault, int(host->supportsStrChoiceAnimation),
+        eDescFinished);
+      sets.strChoiceParamPropSet->addProperty(desc, true);
+
+      // do boolean params animate
+      desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
+        eDescDefault, int(host->supportsBooleanAnimation),
+        eDescFinished);
+      sets.booleanParamPropSet->addProperty(desc, true);
+      return true;
+    }
 
-    /** @brief Props for params that can hold values. */
-    static PropertyDescription gValueHolderParamProps[ ] =
+    /** @brief the param property set descriptions, built the first time one of them is needed */
+    static ParamSets &getParamSets(void)
     {
-      PropertyDescription(kOfxParamPropIsAnimating,               OFX::eInt,    1, eDescFinished),
-      PropertyDescription(kOfxParamPropIsAutoKeying,              OFX::eInt,    1, eDescFinished),
-      PropertyDescription(kOfxParamPropPersistant,                OFX::eInt,    1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropEvaluateOnChange,          OFX::eInt,    1, eDescDefault, 1, eDescFinished),
+      /** @brief Basic parameter descriptor properties */
+      static PropertyDescription basicParamProps[ ] =
+      {
+        PropertyDescription(kOfxPropType,                   OFX::eString, 1, eDescDefault, kOfxTypeParameter, eDescFinished),
+        PropertyDescription(kOfxPropName,                   OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropLabel,                  OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropShortLabel,             OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxPropLongLabel,              OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropType,              OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropSecret,            OFX::eInt,    1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxParamPropHint,              OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropScriptName,        OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropParent,            OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropEnabled,           OFX::eInt,    1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropDataPtr,           OFX::ePointer,1, eDescDefault, (void *)(0), eDescFinished),
+      };
+
+
+      /** @brief Props for params that can have an interact override their UI */
+      static PropertyDescription interactOverideParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropInteractV1,           OFX::ePointer,1, eDescDefault, (void *)(0), eDescFinished),
+        PropertyDescription(kOfxParamPropInteractSize,         OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropInteractSizeAspect,   OFX::eDouble, 1, eDescDefault, 1.0, eDescFinished),
+        PropertyDescription(kOfxParamPropInteractMinimumSize,  OFX::eDouble, 2, eDescDefault, 10, 10, eDescFinished),
+        PropertyDescription(kOfxParamPropInteractPreferedSize, OFX::eInt,    2, eDescDefault, 10, 10, eDescFinished),
+      };
+
+      /** @brief Props for params that can hold values. */
+      static PropertyDescription valueHolderParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropIsAnimating,               OFX::eInt,    1, eDescFinished),
+        PropertyDescription(kOfxParamPropIsAutoKeying,              OFX::eInt,    1, eDescFinished),
+        PropertyDescription(kOfxParamPropPersistant,                OFX::eInt,    1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropEvaluateOnChange,          OFX::eInt,    1, eDescDefault, 1, eDescFinished),
 #    ifdef kOfxParamPropPluginMayWrite
-      PropertyDescription(kOfxParamPropPluginMayWrite,            OFX::eInt,    1, eDescDefault, 0, eDescFinished), // removed in OFX 1.4
+        PropertyDescription(kOfxParamPropPluginMayWrite,            OFX::eInt,    1, eDescDefault, 0, eDescFinished), // removed in OFX 1.4
 #    endif
-      PropertyDescription(kOfxParamPropCacheInvalidation,         OFX::eString, 1, eDescDefault, kOfxParamInvalidateValueChange, eDescFinished),
-      PropertyDescription(kOfxParamPropCanUndo,                   OFX::eInt,    1, eDescDefault, 1, eDescFinished),
-    };
-
-    /** @brief values for a string param */
-    static PropertyDescription gStringParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eString, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,    1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxParamPropStringMode,           OFX::eString, 1, eDescDefault, kOfxParamStringIsSingleLine, eDescFinished),
-      PropertyDescription(kOfxParamPropStringFilePathExists, OFX::eInt,    1, eDescDefault, 1, eDescFinished),
-    };
-
-    /** @brief values for a string param */
-    static PropertyDescription gCustomParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,                OFX::eString,  1, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,               OFX::eInt,     1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxParamPropCustomInterpCallbackV1, OFX::ePointer, 1, eDescDefault, NULLPTR, eDescFinished),
-    };
-
-    /** @brief properties for an RGB colour param */
-    static PropertyDescription gRGBColourParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,    1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 3, eDescDefault, 0., 0., 0., eDescFinished),
-      PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 3, eDescDefault, 1., 1., 1., eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 3, eDescDefault, 0., 0., 0., eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 3, eDescDefault, 1., 1., 1., eDescFinished),
-      PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 3, eDescDefault, "r", "g", "b", eDescFinished),
-    };
-
-    /** @brief properties for an RGBA colour param */
-    static PropertyDescription gRGBAColourParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 4, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,    1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 4, eDescDefault, 0., 0., 0., 0., eDescFinished),
-      PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 4, eDescDefault, 1., 1., 1., 1., eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 4, eDescDefault, 0., 0., 0., 0., eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 4, eDescDefault, 1., 1., 1., 1., eDescFinished),
-      PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 4, eDescDefault, "r", "g", "b", "a", eDescFinished),
-    };
-
-    /** @brief properties for a boolean param */
-    static PropertyDescription gBooleanParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt, 1, eDescDefault, 0, eDescFinished),
-    };
-
+        PropertyDescription(kOfxParamPropCacheInvalidation,         OFX::eString, 1, eDescDefault, kOfxParamInvalidateValueChange, eDescFinished),
+        PropertyDescription(kOfxParamPropCanUndo,                   OFX::eInt,    1, eDescDefault, 1, eDescFinished),
+      };
 
-    /** @brief properties for a choice param */
-    static PropertyDescription gChoiceParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eInt,     1, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,     1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxParamPropChoiceOption,         OFX::eString, -1, eDescFinished),
-    };
-
-    /** @brief properties for a string choice param */
-    static PropertyDescription gStrChoiceParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eString,  1, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,     1, eDescDefault, 0, eDescFinished),
-      PropertyDescription(kOfxParamPropChoiceEnum,           OFX::eString, -1, eDescFinished),
-      PropertyDescription(kOfxParamPropChoiceOption,         OFX::eString, -1, eDescFinished),
-    };
-
-    /** @brief properties for a 1D integer param */
-    static PropertyDescription gInt1DParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropMin,                  OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropMax,                  OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMin,           OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMax,           OFX::eInt, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt, 1, eDescDefault, 1, eDescFinished),
-    };
-
-    /** @brief properties for a 2D integer param */
-    static PropertyDescription gInt2DParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eInt, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropMin,                  OFX::eInt, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropMax,                  OFX::eInt, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMin,           OFX::eInt, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMax,           OFX::eInt, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt, 1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 2, eDescDefault, "x", "y", eDescFinished),
-    };
-
-    /** @brief properties for a 3D integer param */
-    static PropertyDescription gInt3DParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eInt, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropMin,                  OFX::eInt, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropMax,                  OFX::eInt, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMin,           OFX::eInt, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMax,           OFX::eInt, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt, 1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 3, eDescDefault, "x", "y", "z", eDescFinished),
-    };
+      /** @brief values for a string param */
+      static PropertyDescription stringParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eString, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,    1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxParamPropStringMode,           OFX::eString, 1, eDescDefault, kOfxParamStringIsSingleLine, eDescFinished),
+        PropertyDescription(kOfxParamPropStringFilePathExists, OFX::eInt,    1, eDescDefault, 1, eDescFinished),
+      };
+
+      /** @brief values for a string param */
+      static PropertyDescription customParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,                OFX::eString,  1, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,               OFX::eInt,     1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxParamPropCustomInterpCallbackV1, OFX::ePointer, 1, eDescDefault, NULLPTR, eDescFinished),
+      };
 
-    /** @brief Properties common to all double params */
-    static PropertyDescription gDoubleParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,    1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropIncrement,            OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropDigits,               OFX::eInt,    1, eDescFinished),
-      PropertyDescription(kOfxParamPropDoubleType,           OFX::eString, 1, eDescDefault, kOfxParamDoubleTypePlain, eDescFinished),
-    };
+      /** @brief properties for an RGB colour param */
+      static PropertyDescription rgbColourParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,    1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 3, eDescDefault, 0., 0., 0., eDescFinished),
+        PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 3, eDescDefault, 1., 1., 1., eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 3, eDescDefault, 0., 0., 0., eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 3, eDescDefault, 1., 1., 1., eDescFinished),
+        PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 3, eDescDefault, "r", "g", "b", eDescFinished),
+      };
+
+      /** @brief properties for an RGBA colour param */
+      static PropertyDescription rgbaColourParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 4, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,    1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 4, eDescDefault, 0., 0., 0., 0., eDescFinished),
+        PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 4, eDescDefault, 1., 1., 1., 1., eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 4, eDescDefault, 0., 0., 0., 0., eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 4, eDescDefault, 1., 1., 1., 1., eDescFinished),
+        PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 4, eDescDefault, "r", "g", "b", "a", eDescFinished),
+      };
+
+      /** @brief properties for a boolean param */
+      static PropertyDescription booleanParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt, 1, eDescDefault, 0, eDescFinished),
+      };
 
 
-    /** @brief properties for a 1D double param */
-    static PropertyDescription gDouble1DParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropShowTimeMarker,       OFX::eInt,    1, eDescDefault, 0, eDescFinished),
-    };
+      /** @brief properties for a choice param */
+      static PropertyDescription choiceParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eInt,     1, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,     1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxParamPropChoiceOption,         OFX::eString, -1, eDescFinished),
+      };
 
-    /** @brief properties for a 2D double  param */
-    static PropertyDescription gDouble2DParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 2, eDescFinished),
-      PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 2, eDescDefault, "x", "y", eDescFinished),
-    };
+      /** @brief properties for a string choice param */
+      static PropertyDescription strChoiceParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eString,  1, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,     1, eDescDefault, 0, eDescFinished),
+        PropertyDescription(kOfxParamPropChoiceEnum,           OFX::eString, -1, eDescFinished),
+        PropertyDescription(kOfxParamPropChoiceOption,         OFX::eString, -1, eDescFinished),
+      };
+
+      /** @brief properties for a 1D integer param */
+      static PropertyDescription int1DParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropMin,                  OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropMax,                  OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMin,           OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMax,           OFX::eInt, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt, 1, eDescDefault, 1, eDescFinished),
+      };
+
+      /** @brief properties for a 2D integer param */
+      static PropertyDescription int2DParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eInt, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropMin,                  OFX::eInt, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropMax,                  OFX::eInt, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMin,           OFX::eInt, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMax,           OFX::eInt, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt, 1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 2, eDescDefault, "x", "y", eDescFinished),
+      };
+
+      /** @brief properties for a 3D integer param */
+      static PropertyDescription int3DParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eInt, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropMin,                  OFX::eInt, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropMax,                  OFX::eInt, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMin,           OFX::eInt, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMax,           OFX::eInt, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt, 1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 3, eDescDefault, "x", "y", "z", eDescFinished),
+      };
+
+      /** @brief Properties common to all double params */
+      static PropertyDescription doubleParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropAnimates,             OFX::eInt,    1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropIncrement,            OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropDigits,               OFX::eInt,    1, eDescFinished),
+        PropertyDescription(kOfxParamPropDoubleType,           OFX::eString, 1, eDescDefault, kOfxParamDoubleTypePlain, eDescFinished),
+      };
 
-    /** @brief properties for a 3D double param */
-    static PropertyDescription gDouble3DParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 3, eDescFinished),
-      PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 3, eDescDefault, "x", "y", "z", eDescFinished),
-    };
 
-    /** @brief properties for a group param */
-    static PropertyDescription gGroupParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropGroupOpen,           OFX::eInt, 1, eDescFinished),
-    };
+      /** @brief properties for a 1D double param */
+      static PropertyDescription double1DParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropShowTimeMarker,       OFX::eInt,    1, eDescDefault, 0, eDescFinished),
+      };
+
+      /** @brief properties for a 2D double  param */
+      static PropertyDescription double2DParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 2, eDescFinished),
+        PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 2, eDescDefault, "x", "y", eDescFinished),
+      };
+
+      /** @brief properties for a 3D double param */
+      static PropertyDescription double3DParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropDefault,              OFX::eDouble, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropMin,                  OFX::eDouble, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropMax,                  OFX::eDouble, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMin,           OFX::eDouble, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropDisplayMax,           OFX::eDouble, 3, eDescFinished),
+        PropertyDescription(kOfxParamPropDimensionLabel,       OFX::eString, 3, eDescDefault, "x", "y", "z", eDescFinished),
+      };
+
+      /** @brief properties for a group param */
+      static PropertyDescription groupParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropGroupOpen,           OFX::eInt, 1, eDescFinished),
+      };
 
-    /** @brief properties for a page param */
-    static PropertyDescription gPageParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropPageChild,            OFX::eString, -1, eDescFinished),
-    };
+      /** @brief properties for a page param */
+      static PropertyDescription pageParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropPageChild,            OFX::eString, -1, eDescFinished),
+      };
 
-    /** @brief properties for a parametric param */
-    static PropertyDescription gParametricParamProps[ ] =
-    {
-      PropertyDescription(kOfxParamPropAnimates,                     OFX::eInt,     1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropCanUndo,                      OFX::eInt,     1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropParametricDimension,          OFX::eInt,     1, eDescDefault, 1, eDescFinished),
-      PropertyDescription(kOfxParamPropParametricUIColour,           OFX::eDouble, -1, eDescFinished),
-      PropertyDescription(kOfxParamPropParametricInteractBackground, OFX::ePointer, 1, eDescDefault, (void*)(0), eDescFinished),
-      PropertyDescription(kOfxParamPropParametricRange,              OFX::eDouble,  2, eDescDefault, 0.0, 1.0, eDescFinished),
-    };
+      /** @brief properties for a parametric param */
+      static PropertyDescription parametricParamProps[ ] =
+      {
+        PropertyDescription(kOfxParamPropAnimates,                     OFX::eInt,     1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropCanUndo,                      OFX::eInt,     1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropParametricDimension,          OFX::eInt,     1, eDescDefault, 1, eDescFinished),
+        PropertyDescription(kOfxParamPropParametricUIColour,           OFX::eDouble, -1, eDescFinished),
+        PropertyDescription(kOfxParamPropParametricInteractBackground, OFX::ePointer, 1, eDescDefault, (void*)(0), eDescFinished),
+        PropertyDescription(kOfxParamPropParametricRange,              OFX::eDouble,  2, eDescDefault, 0.0, 1.0, eDescFinished),
+      };
+
+      /** @brief Property set for 1D ints */
+      static PropertySetDescription int1DParamPropSet("1D Integer parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(int1DParamProps),
+        NULLPTR);
+
+
+      /** @brief Property set for 2D ints */
+      static PropertySetDescription int2DParamPropSet("2D Integer parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(int2DParamProps),
+        NULLPTR);
+
+      /** @brief Property set for 3D ints */
+      static PropertySetDescription int3DParamPropSet("3D Integer parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(int3DParamProps),
+        NULLPTR);
+
+      /** @brief Property set for 1D doubles */
+      static PropertySetDescription double1DParamPropSet("1D Double parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(doubleParamProps),
+        mPropDescriptionArg(double1DParamProps),
+        NULLPTR);
+
+
+      /** @brief Property set for 2D doubles */
+      static PropertySetDescription double2DParamPropSet("2D Double parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(doubleParamProps),
+        mPropDescriptionArg(double2DParamProps),
+        NULLPTR);
+
+      /** @brief Property set for 3D doubles */
+      static PropertySetDescription double3DParamPropSet("3D Double parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(doubleParamProps),
+        mPropDescriptionArg(double3DParamProps),
+        NULLPTR);
+
+      /** @brief Property set for RGB colour params */
+      static PropertySetDescription rgbParamPropSet("RGB Colour parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(rgbColourParamProps),
+        NULLPTR);
+
+      /** @brief Property set for RGB colour params */
+      static PropertySetDescription rgbaParamPropSet("RGB Colour parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(rgbaColourParamProps),
+        NULLPTR);
+
+      /** @brief Property set for string params */
+      static PropertySetDescription stringParamPropSet("String parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(stringParamProps),
+        NULLPTR);
+
+      /** @brief Property set for string params */
+      static PropertySetDescription customParamPropSet("Custom parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(customParamProps),
+        NULLPTR);
+
+      /** @brief Property set for boolean params */
+      static PropertySetDescription booleanParamPropSet("Boolean parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(booleanParamProps),
+        NULLPTR);
+
+      /** @brief Property set for choice params */
+      static PropertySetDescription choiceParamPropSet("Choice parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(choiceParamProps),
+        NULLPTR);
+
+      /** @brief Property set for string choice params */
+      static PropertySetDescription strChoiceParamPropSet("String Choice parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(strChoiceParamProps),
+        NULLPTR);
+
+      /** @brief Property set for push button params */
+      static PropertySetDescription pushButtonParamPropSet("PushButton parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        NULLPTR);
+
+      /** @brief Property set for group params */
+      static PropertySetDescription groupParamPropSet("Group Parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(groupParamProps),
+        NULLPTR);
+
+      /** @brief Property set for page params */
+      static PropertySetDescription pageParamPropSet("Page Parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(pageParamProps),
+        NULLPTR);
+
+      static PropertySetDescription parametricParamPropSet("Parametric Parameter",
+        mPropDescriptionArg(basicParamProps),
+        mPropDescriptionArg(interactOverideParamProps),
+        mPropDescriptionArg(valueHolderParamProps),
+        mPropDescriptionArg(parametricParamProps),
+        NULLPTR);
+
+      static ParamSets sets = {
+        &int1DParamPropSet,
+        &int2DParamPropSet,
+        &int3DParamPropSet,
+        &double1DParamPropSet,
+        &double2DParamPropSet,
+        &double3DParamPropSet,
+        &rgbParamPropSet,
+        &rgbaParamPropSet,
+        &stringParamPropSet,
+        &customParamPropSet,
+        &booleanParamPropSet,
+        &choiceParamPropSet,
+        &strChoiceParamPropSet,
+        &pushButtonParamPropSet,
+        &groupParamPropSet,
+        &pageParamPropSet,
+        &parametricParamPropSet
+      };
+
+      // add the descriptions that depend on how the host behaves
+      static const bool addedHostProperties = addHostDependentProperties(sets);
+      (void) addedHostProperties;
+      return sets;
+    }
 
-    /** @brief Property set for 1D ints */
-    static PropertySetDescription gInt1DParamPropSet("1D Integer parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gInt1DParamProps),
-      NULLPTR);
-
-
-    /** @brief Property set for 2D ints */
-    static PropertySetDescription gInt2DParamPropSet("2D Integer parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gInt2DParamProps),
-      NULLPTR);
-
-    /** @brief Property set for 3D ints */
-    static PropertySetDescription gInt3DParamPropSet("3D Integer parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gInt3DParamProps),
-      NULLPTR);
-
-    /** @brief Property set for 1D doubles */
-    static PropertySetDescription gDouble1DParamPropSet("1D Double parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gDoubleParamProps),
-      mPropDescriptionArg(gDouble1DParamProps),
-      NULLPTR);
-
-
-    /** @brief Property set for 2D doubles */
-    static PropertySetDescription gDouble2DParamPropSet("2D Double parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gDoubleParamProps),
-      mPropDescriptionArg(gDouble2DParamProps),
-      NULLPTR);
-
-    /** @brief Property set for 3D doubles */
-    static PropertySetDescription gDouble3DParamPropSet("3D Double parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gDoubleParamProps),
-      mPropDescriptionArg(gDouble3DParamProps),
-      NULLPTR);
-
-    /** @brief Property set for RGB colour params */
-    static PropertySetDescription gRGBParamPropSet("RGB Colour parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gRGBColourParamProps),
-      NULLPTR);
-
-    /** @brief Property set for RGB colour params */
-    static PropertySetDescription gRGBAParamPropSet("RGB Colour parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gRGBAColourParamProps),
-      NULLPTR);
-
-    /** @brief Property set for string params */
-    static PropertySetDescription gStringParamPropSet("String parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gStringParamProps),
-      NULLPTR);
-
-    /** @brief Property set for string params */
-    static PropertySetDescription gCustomParamPropSet("Custom parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gCustomParamProps),
-      NULLPTR);
-
-    /** @brief Property set for boolean params */
-    static PropertySetDescription gBooleanParamPropSet("Boolean parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gBooleanParamProps),
-      NULLPTR);
-
-    /** @brief Property set for choice params */
-    static PropertySetDescription gChoiceParamPropSet("Choice parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gChoiceParamProps),
-      NULLPTR);
-
-    /** @brief Property set for string choice params */
-    static PropertySetDescription gStrChoiceParamPropSet("String Choice parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gStrChoiceParamProps),
-      NULLPTR);
-
-    /** @brief Property set for push button params */
-    static PropertySetDescription gPushButtonParamPropSet("PushButton parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      NULLPTR);
-
-    /** @brief Property set for group params */
-    static PropertySetDescription gGroupParamPropSet("Group Parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gGroupParamProps),
-      NULLPTR);
-
-    /** @brief Property set for page params */
-    static PropertySetDescription gPageParamPropSet("Page Parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gPageParamProps),
-      NULLPTR);
-
-    static PropertySetDescription gParametricParamPropSet("Parametric Parameter",
-      mPropDescriptionArg(gBasicParamProps),
-      mPropDescriptionArg(gInteractOverideParamProps),
-      mPropDescriptionArg(gValueHolderParamProps),
-      mPropDescriptionArg(gParametricParamProps),
-      NULLPTR);
 
 #endif
     /** @brief Validates the host structure and property handle */
@@ -1055,7 +1282,7 @@ namespace OFX {
 #else
       // make a description set
       PropertySet props(host->host);
-      gHostPropSet.validate(props);
+      getObjectSets().hostPropSet->validate(props);
 #endif
     }
 
@@ -1066,7 +1293,7 @@ namespace OFX {
 #ifdef kOfxsDisableValidation
     (void)props;
 #else
-      gPluginDescriptorPropSet.validate(props);
+      getObjectSets().pluginDescriptorPropSet->validate(props);
 #endif
     }
 
@@ -1077,7 +1304,7 @@ namespace OFX {
 #ifdef kOfxsDisableValidation
     (void)props;
 #else
-      gPluginInstancePropSet.validate(props);
+      getObjectSets().pluginInstancePropSet->validate(props);
 #endif
     }
 
@@ -1088,7 +1315,7 @@ namespace OFX {
 #ifdef kOfxsDisableValidation
     (void)props;
 #else
-      gClipDescriptorPropSet.validate(props);
+      getObjectSets().clipDescriptorPropSet->validate(props);
 #endif
     }
 
@@ -1099,7 +1326,7 @@ namespace OFX {
 #ifdef kOfxsDisableValidation
     (void)props;
 #else
-      gClipInstancePropSet.validate(props);
+      getObjectSets().clipInstancePropSet->validate(props);
 #endif
     }
 
@@ -1110,7 +1337,7 @@ namespace OFX {
 #ifdef kOfxsDisableValidation
     (void)props;
 #else
-      gImageBaseInstancePropSet.validate(props);
+      getObjectSets().imageBaseInstancePropSet->validate(props);
 #endif
     }
 
@@ -1121,7 +1348,7 @@ namespace OFX {
 #ifdef kOfxsDisableValidation
     (void)props;
 #else
-      gImageInstancePropSet.validate(props);
+      getObjectSets().imageInstancePropSet->validate(props);
 #endif
     }
 
@@ -1133,7 +1360,7 @@ namespace OFX {
 #ifdef kOfxsDisableValidation
     (void)props;
 #else
-      gTextureInstancePropSet.validate(props);
+      getObjectSets().textureInstancePropSet->validate(props);
 #endif
     }
 #endif
@@ -1148,45 +1375,45 @@ namespace OFX {
     (void)outArgs;
 #else
       if(action == kOfxActionInstanceChanged) {
-        gInstanceChangedInArgPropSet.validate(inArgs);
+        getActionSets().instanceChangedInArgPropSet->validate(inArgs);
       }
       else if(action == kOfxActionBeginInstanceChanged) {
-        gBeginInstanceChangedInArgPropSet.validate(inArgs);
+        getActionSets().beginInstanceChangedInArgPropSet->validate(inArgs);
       }
       else if(action == kOfxActionEndInstanceChanged) {
-        gEndInstanceChangedInArgPropSet.validate(inArgs);
+        getActionSets().endInstanceChangedInArgPropSet->validate(inArgs);
       }
       else if(action == kOfxImageEffectActionGetRegionOfDefinition) {
-        gGetRegionOfDefinitionInArgPropSet.validate(inArgs);
-        gGetRegionOfDefinitionOutArgPropSet.validate(outArgs);
+        getActionSets().getRegionOfDefinitionInArgPropSet->validate(inArgs);
+        getActionSets().getRegionOfDefinitionOutArgPropSet->validate(outArgs);
       }
       else if(action == kOfxImageEffectActionGetRegionsOfInterest) {
-        gGetRegionOfInterestInArgPropSet.validate(inArgs);
+        getActionSets().getRegionOfInterestInArgPropSet->validate(inArgs);
       }
       else if(action == kOfxImageEffectActionGetTimeDomain) {
-        gGetTimeDomainOutArgPropSet.validate(outArgs);
+        getActionSets().getTimeDomainOutArgPropSet->validate(outArgs);
       }
       else if(action == kOfxImageEffectActionGetFramesNeeded) {
-        gGetFramesNeededInArgPropSet.validate(inArgs);
+        getActionSets().getFramesNeededInArgPropSet->validate(inArgs);
       }
       else if(action == kOfxImageEffectActionGetClipPreferences) {
-        gGetClipPreferencesOutArgPropSet.validate(outArgs);
+        getActionSets().getClipPreferencesOutArgPropSet->validate(outArgs);
       }
       else if(action == kOfxImageEffectActionIsIdentity) {
-        gIsIdentityActionInArgPropSet.validate(inArgs);
-        gIsIdentityActionOutArgPropSet.validate(outArgs);
+        getActionSets().isIdentityActionInArgPropSet->validate(inArgs);
+        getActionSets().isIdentityActionOutArgPropSet->validate(outArgs);
       }
       else if(action == kOfxImageEffectActionRender) {
-        gRenderActionInArgPropSet.validate(inArgs);
+        getActionSets().renderActionInArgPropSet->validate(inArgs);
       }
       else if(action == kOfxImageEffectActionBeginSequenceRender) {
-        gBeginSequenceRenderActionInArgPropSet.validate(inArgs);
+        getActionSets().beginSequenceRenderActionInArgPropSet->validate(inArgs);
       }
       else if(action == kOfxImageEffectActionEndSequenceRender) {
-        gEndSequenceRenderActionInArgPropSet.validate(inArgs);
+        getActionSets().endSequenceRenderActionInArgPropSet->validate(inArgs);
       }
       else if(action == kOfxImageEffectActionDescribeInContext) {
-        gDescribeInContextActionInArgPropSet.validate(inArgs);
+        getActionSets().describeInContextActionInArgPropSet->validate(inArgs);
       }     
 #endif 
     }
@@ -1206,55 +1433,55 @@ namespace OFX {
       switch(paramType) 
       {
       case eStringParam :
-        gStringParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().stringParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eIntParam :	
-        gInt1DParamPropSet.validate(paramProps,  checkDefaults);
+        getParamSets().int1DParamPropSet->validate(paramProps,  checkDefaults);
         break;
       case eInt2DParam :
-        gInt2DParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().int2DParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eInt3DParam :
-        gInt3DParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().int3DParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eDoubleParam :
-        gDouble1DParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().double1DParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eDouble2DParam :
-        gDouble2DParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().double2DParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eDouble3DParam :
-        gDouble3DParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().double3DParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eRGBParam :
-        gRGBParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().rgbParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eRGBAParam :
-        gRGBAParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().rgbaParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eBooleanParam :
-        gBooleanParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().booleanParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eChoiceParam :
-        gChoiceParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().choiceParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eStrChoiceParam :
-        gStrChoiceParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().strChoiceParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eCustomParam :
-        gCustomParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().customParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eGroupParam :
-        gGroupParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().groupParamPropSet->validate(paramProps, checkDefaults);
         break;
       case ePageParam :
-        gPageParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().pageParamPropSet->validate(paramProps, checkDefaults);
         break;
       case ePushButtonParam :
-        gPushButtonParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().pushButtonParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eParametricParam:
-        gParametricParamPropSet.validate(paramProps, checkDefaults);
+        getParamSets().parametricParamPropSet->validate(paramProps, checkDefaults);
         break;
       case eDummyParam:
       //default:
@@ -1266,48 +1493,28 @@ namespace OFX {
     ////////////////////////////////////////////////////////////////////////////////
     //
 
-    /** @brief Initialises validation stuff that needs to be done once we know how the host behaves, called during the onload action */
+    /** @brief Initialises validation stuff, called during the onload action. The descriptions themselves are built when first needed. */
     void
       initialise(void)
     {
 #ifndef kOfxsDisableValidation
-      static bool beenInitialised = false;
-      if(!beenInitialised && getImageEffectHostDescription()) {
-        beenInitialised = true;
-
-        // create new property descriptions depending on certain host states
-        PropertyDescription *desc;
-
-        // do custom params animate ?
-        desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
-          eDescDefault, int(getImageEffectHostDescription()->supportsCustomAnimation),
-          eDescFinished);
-        gCustomParamPropSet.addProperty(desc, true);
-
-        // do strings animate ?
-        desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
-          eDescDefault, int(getImageEffectHostDescription()->supportsStringAnimation),
-          eDescFinished);
-        gStringParamPropSet.addProperty(desc, true);
-
-        // do choice params animate      
-        desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
-          eDescDefault, int(getImageEffectHostDescription()->supportsChoiceAnimation),
-          eDescFinished);
-        gChoiceParamPropSet.addProperty(desc, true);
-
-        // do string choice params animate
-        desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
-          eDescDefault, int(getImageEffectHostDescription()->supportsStrChoiceAnimation),
-          eDescFinished);
-        gStrChoiceParamPropSet.addProperty(desc, true);
-
-        // do boolean params animate
-        desc = new PropertyDescription(kOfxParamPropAnimates, OFX::eInt, 1,
-          eDescDefault, int(getImageEffectHostDescription()->supportsBooleanAnimation),
-          eDescFinished);
-        gBooleanParamPropSet.addProperty(desc, true);
-      }
+      static std::once_flag initialised;
+      std::call_once(initialised, []() {
+        // let the mode be overridden without a rebuild
+        const char *mode = getenv(kOfxsValidationModeEnvVar);
+        if(mode) {
+          if(strcmp(mode, "off") == 0)
+            setMode(eModeOff);
+          else if(strcmp(mode, "always") == 0)
+            setMode(eModeAlways);
+          else if(strcmp(mode, "once") == 0)
+            setMode(eModeOncePerShape);
+          else if(strncmp(mode, "sampled", 7) == 0)
+            setMode(eModeSampled, mode[7] == ':' ? atoi(mode + 8) : kDefaultSamplePeriod);
+          else
+            OFX::Log::warning(true, "Unknown validation mode '%s' in %s, ignoring it.", mode, kOfxsValidationModeEnvVar);
+        }
+      });
 #endif
     }
   };
@@ -4,10 +4,18 @@
 #ifndef _ofxsSupportPrivate_H_
 #define _ofxsSupportPrivate_H_
 
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <vector>
+
 #include "ofxsInteract.h"
 #include "ofxsImageEffect.h"
 #include "ofxsLog.h"
 #include "ofxsMultiThread.h"
+#include "ofxParamBatch.h"
+#include "ofxRenderAbort.h"
+#include "ofxImageAlignment.h"
 
 /** @brief Namespace private to the ofx support library.
 */
@@ -53,6 +61,29 @@ namespace OFX {
     /** @brief Pointer to the parametric parameter suite */
     extern OfxParametricParameterSuiteV1* gParametricParameterSuite;
 
+    /** @brief Pointer to the optional parameter batch suite */
+    extern OfxParameterBatchSuiteV1 *gParamBatchSuite;
+
+    /** @brief Pointer to the optional async image fetch suite */
+    extern OfxAsyncImageFetchSuiteV1 *gAsyncImageFetchSuite;
+
+    /** @brief The abort flag the host gave the render running on this thread, null if it gave none */
+    extern thread_local const int *gRenderAbortFlag;
+
+    /** @brief Is the abort flag set, the flag must not be null */
+    inline bool isRenderAbortFlagSet(const int *flag)
+    {
+      return reinterpret_cast<const std::atomic<int> *>(flag)->load(std::memory_order_relaxed) != 0;
+    }
+
+    /** @brief Sets the abort flag of the calling thread for its lifetime, restoring the previous one after */
+    class RenderAbortFlagScope {
+      const int *_previous;
+    public :
+      explicit RenderAbortFlagScope(const int *flag) : _previous(gRenderAbortFlag) {gRenderAbortFlag = flag;}
+      ~RenderAbortFlagScope() {gRenderAbortFlag = _previous;}
+    };
+
     /** @brief Support lib function called on an ofx load action */
     void loadAction(void);
 
@@ -79,6 +110,29 @@ namespace OFX {
   /** @brief The validation code has its own namespace */
   namespace Validation {
 
+    /** @brief How property sets are validated.
+
+    A set's shape is the dimension the host gives each of the properties it is described
+    with. Hosts make the sets they pass to a given action or for a given kind of object the
+    same way each time, so once a shape has been validated the verdict holds for every other
+    set of that shape, and checking the shape is enough.
+    */
+    enum ModeEnum {
+      eModeOff,           /**< @brief validate nothing */
+      eModeAlways,        /**< @brief validate every set fully, the default in debug builds */
+      eModeOncePerShape,  /**< @brief check the shape of every set, and validate each shape fully the first time it is seen, the default otherwise */
+      eModeSampled        /**< @brief as eModeOncePerShape, but only check one set in every sample period, for long sessions */
+    };
+
+    /** @brief the sample period of eModeSampled, unless told otherwise */
+    const int kDefaultSamplePeriod = 64;
+
+    /** @brief Set how property sets are validated, samplePeriod is only used by eModeSampled */
+    void setMode(ModeEnum mode, int samplePeriod = kDefaultSamplePeriod);
+
+    /** @brief How property sets are validated */
+    ModeEnum getMode(void);
+
     /** @brief This is uses to hold a property value, used by the property checking classes.
 
     Could have been a union, but std::string can't be in one.
@@ -157,6 +211,18 @@ namespace OFX {
       /** @brief The descriptions of each property */
       std::vector<PropertyDescription *> _deleteThese;
 
+      /** @brief guards the shapes */
+      std::mutex _mutex;
+
+      /** @brief the shapes of the sets validated so far */
+      std::set<std::vector<int> > _shapes;
+
+      /** @brief count of sets passed to validate, for sampling */
+      std::atomic<unsigned int> _nValidations;
+
+      /** @brief Fetch the dimension the host gives each described property of a set, -1 for those it does not have */
+      void getShape(PropertySet &propSet, std::vector<int> &shape) const;
+
     public :
       /** @brief constructor. 
 
@@ -171,7 +237,7 @@ namespace OFX {
       /** @brief add another property in */
       void addProperty(PropertyDescription *desc, bool deleteOnDestruction = true);
 
-      /** @brief See if all properties exist and have the correct dimensions */
+      /** @brief See if all properties exist and have the correct dimensions, as the mode allows */
       void validate(PropertySet &propSet, bool checkDefaults = true, bool logOrdinaryMessages = false); 
     };
 
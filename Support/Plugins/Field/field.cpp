@@ -11,6 +11,7 @@
 #include "ofxsMultiThread.h"
 
 #include "../include/ofxsProcessing.H"
+#include "ofxsImageView.h"
 
 
 // Base class for the RGBA and the Alpha processor
@@ -45,17 +46,22 @@ public :
     //eFieldLower only the spatially lower field is present
     //eFieldUpper only the spatially upper field is present
  
+    OFX::ImageView<PIX, nComponents> dstView(_dstImg);
+    OFX::ImageView<const PIX, nComponents> srcView(_srcImg);
+
     for(int y = procWindow.y1; y < procWindow.y2; y++) {
       if(_effect.abort()) break;
 
-      PIX *dstPix = (PIX *) _dstImg->getPixelAddress(procWindow.x1, y);
+      PIX *dstPix = dstView.getPixel(procWindow.x1, y);
 
-      for(int x = procWindow.x1; x < procWindow.x2; x++) {
+      // the run of the row the source has pixels for
+      typename OFX::ImageView<const PIX, nComponents>::Span srcSpan = srcView.getSpan(y, procWindow.x1, procWindow.x2);
+      const PIX *srcPix = srcSpan.begin();
 
-        PIX *srcPix = (PIX *)  (_srcImg ? _srcImg->getPixelAddress(x, y) : 0);
+      for(int x = procWindow.x1; x < procWindow.x2; x++) {
 
         // do we have a source image to scale up
-        if(srcPix) {
+        if(x >= srcSpan.x1() && x < srcSpan.x2()) {
           for(int c = 0; c < nComponents; c++) {
             if((_field == OFX::eFieldLower) && (c==0))
               dstPix[c] = max;
@@ -64,6 +70,7 @@ public :
             else
               dstPix[c] = max - srcPix[c];
           }
+          srcPix += nComponents;
         }
         else {
           // no src pixel here, be black and transparent
@@ -164,62 +171,11 @@ FieldPlugin::render(const OFX::RenderArguments &args)
   OFX::FieldEnum field = args.fieldToRender;
 
   // do the rendering
-  if(dstComponents == OFX::ePixelComponentRGBA) 
-  {
-    switch(dstBitDepth) 
-    {
-    case OFX::eBitDepthUByte : 
-    {      
-      ImageFielder<unsigned char, 4, 255> fred(*this, field);
-      setupAndProcess(fred, args);
-    }
-    break;
-    
-    case OFX::eBitDepthUShort : 
-    {
-      ImageFielder<unsigned short, 4, 65535> fred(*this, field);
-      setupAndProcess(fred, args);
-    }                          
-    break;
-    
-    case OFX::eBitDepthFloat : 
-    {
-      ImageFielder<float, 4, 1> fred(*this, field);
-      setupAndProcess(fred, args);
-    }
-    break;
-    default :
-      OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
-    }
-  }
-  else 
-  {
-    switch(dstBitDepth) 
-    {
-    case OFX::eBitDepthUByte : 
-    {
-      ImageFielder<unsigned char, 1, 255> fred(*this, field);
-      setupAndProcess(fred, args);
-    }
-    break;
-      
-    case OFX::eBitDepthUShort : 
-    {
-      ImageFielder<unsigned short, 1, 65535> fred(*this, field);
-      setupAndProcess(fred, args);
-    }                          
-    break;
-      
-    case OFX::eBitDepthFloat : 
-    {
-      ImageFielder<float, 1, 1> fred(*this, field);
-      setupAndProcess(fred, args);
-    }                          
-    break;
-    default :
-      OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
-    }
-  } 
+  OFX::dispatchPixelFormat(dstBitDepth, dstComponents, [&](auto format) {
+    typedef decltype(format) Format;
+    ImageFielder<typename Format::Pixel, Format::kComponents, Format::kMaxValue> fred(*this, field);
+    setupAndProcess(fred, args);
+  });
 }
 
 mDeclarePluginFactory(FieldExamplePluginFactory, {}, {});
@@ -111,39 +111,24 @@ void GainExample::processImagesOpenCL()
 #endif
 }
 
-void GainExample::multiThreadProcessImages(OfxRectI p_ProcWindow)
+/** @brief scales each component of an RGBA float pixel */
+struct GainKernel
 {
-    for (int y = p_ProcWindow.y1; y < p_ProcWindow.y2; ++y)
-    {
-        if (_effect.abort()) break;
+    const float* scales;
 
-        float* dstPix = static_cast<float*>(_dstImg->getPixelAddress(p_ProcWindow.x1, y));
-
-        for (int x = p_ProcWindow.x1; x < p_ProcWindow.x2; ++x)
+    void operator()(const float* p_SrcPix, float* p_DstPix) const
+    {
+        for (int c = 0; c < 4; ++c)
         {
-            float* srcPix = static_cast<float*>(_srcImg ? _srcImg->getPixelAddress(x, y) : 0);
-
-            // do we have a source image to scale up
-            if (srcPix)
-            {
-                for(int c = 0; c < 4; ++c)
-                {
-                    dstPix[c] = srcPix[c] * _scales[c];
-                }
-            }
-            else
-            {
-                // no src pixel here, be black and transparent
-                for (int c = 0; c < 4; ++c)
-                {
-                    dstPix[c] = 0;
-                }
-            }
-
-            // increment the dst pixel
-            dstPix += 4;
+            p_DstPix[c] = p_SrcPix[c] * scales[c];
         }
     }
+};
+
+void GainExample::multiThreadProcessImages(OfxRectI p_ProcWindow)
+{
+    GainKernel kernel = {_scales};
+    OFX::PixelKernelRows<GainKernel, float, 4>::process(kernel, _effect, _srcImg, *_dstImg, p_ProcWindow);
 }
 
 void GainExample::setSrcImg(OFX::Image* p_SrcImg)
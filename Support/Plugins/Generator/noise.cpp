@@ -7,6 +7,7 @@
 #include "ofxsMultiThread.h"
 
 #include "../include/ofxsProcessing.H"
+#include "ofxsImageView.h"
 
 #include <random>
 
@@ -55,11 +56,13 @@ public :
     mt.seed(_seed + procWindow.y1);
     std::uniform_real_distribution<double> dist(0.0, max * noiseLevel);
 
+    OFX::ImageView<PIX, nComponents> dstView(_dstImg);
+
     // push pixels
     for(int y = procWindow.y1; y < procWindow.y2; y++) {
       if(_effect.abort()) break;
 
-      PIX *dstPix = (PIX *) _dstImg->getPixelAddress(procWindow.x1, y);
+      PIX *dstPix = dstView.getPixel(procWindow.x1, y);
 
       for(int x = procWindow.x1; x < procWindow.x2; x++) {
         for(int c = 0; c < nComponents; c++) {
@@ -170,59 +173,11 @@ NoisePlugin::render(const OFX::RenderArguments &args)
   OFX::PixelComponentEnum dstComponents  = dstClip_->getPixelComponents();
 
   // do the rendering
-  if(dstComponents == OFX::ePixelComponentRGBA) {
-    switch(dstBitDepth)
-    {
-    case OFX::eBitDepthUByte : {
-      NoiseGenerator<unsigned char, 4, 255> fred(*this);
-      setupAndProcess(fred, args);
-                               }
-                               break;
-
-    case OFX::eBitDepthUShort :
-      {
-        NoiseGenerator<unsigned short, 4, 65535> fred(*this);
-        setupAndProcess(fred, args);
-      }
-      break;
-
-    case OFX::eBitDepthFloat :
-      {
-        NoiseGenerator<float, 4, 1> fred(*this);
-        setupAndProcess(fred, args);
-      }
-      break;
-    default :
-      OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
-    }
-  }
-  else {
-    switch(dstBitDepth)
-    {
-    case OFX::eBitDepthUByte :
-      {
-        NoiseGenerator<unsigned char, 1, 255> fred(*this);
-        setupAndProcess(fred, args);
-      }
-      break;
-
-    case OFX::eBitDepthUShort :
-      {
-        NoiseGenerator<unsigned short, 1, 65535> fred(*this);
-        setupAndProcess(fred, args);
-      }
-      break;
-
-    case OFX::eBitDepthFloat :
-      {
-        NoiseGenerator<float, 1, 1> fred(*this);
-        setupAndProcess(fred, args);
-      }
-      break;
-    default :
-      OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
-    }
-  }
+  OFX::dispatchPixelFormat(dstBitDepth, dstComponents, [&](auto format) {
+    typedef decltype(format) Format;
+    NoiseGenerator<typename Format::Pixel, Format::kComponents, Format::kMaxValue> fred(*this);
+    setupAndProcess(fred, args);
+  });
 }
 
 mDeclarePluginFactory(NoiseExamplePluginFactory, {}, {});
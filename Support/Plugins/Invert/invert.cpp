@@ -10,6 +10,7 @@
 #include "ofxsMultiThread.h"
 
 #include "../include/ofxsProcessing.H"
+#include "ofxsImageView.h"
 
 
 // Base class for the RGBA and the Alpha processor
@@ -40,20 +41,26 @@ public :
   // and do some processing
   void multiThreadProcessImages(OfxRectI procWindow)
   {
+    OFX::ImageView<PIX, nComponents> dstView(_dstImg);
+    OFX::ImageView<const PIX, nComponents> srcView(_srcImg);
+
     for(int y = procWindow.y1; y < procWindow.y2; y++) {
       if(_effect.abort()) break;
 
-      PIX *dstPix = (PIX *) _dstImg->getPixelAddress(procWindow.x1, y);
+      PIX *dstPix = dstView.getPixel(procWindow.x1, y);
 
-      for(int x = procWindow.x1; x < procWindow.x2; x++) {
+      // the run of the row the source has pixels for
+      typename OFX::ImageView<const PIX, nComponents>::Span srcSpan = srcView.getSpan(y, procWindow.x1, procWindow.x2);
+      const PIX *srcPix = srcSpan.begin();
 
-        PIX *srcPix = (PIX *)  (_srcImg ? _srcImg->getPixelAddress(x, y) : 0);
+      for(int x = procWindow.x1; x < procWindow.x2; x++) {
 
         // do we have a source image to scale up
-        if(srcPix) {
+        if(x >= srcSpan.x1() && x < srcSpan.x2()) {
           for(int c = 0; c < nComponents; c++) {
             dstPix[c] = max - srcPix[c];
           }
+          srcPix += nComponents;
         }
         else {
           // no src pixel here, be black and transparent
@@ -145,52 +152,11 @@ InvertPlugin::render(const OFX::RenderArguments &args)
   OFX::PixelComponentEnum dstComponents  = dstClip_->getPixelComponents();
 
   // do the rendering
-  if(dstComponents == OFX::ePixelComponentRGBA) {
-    switch(dstBitDepth) {
-case OFX::eBitDepthUByte : {      
-  ImageInverter<unsigned char, 4, 255> fred(*this);
-  setupAndProcess(fred, args);
-                           }
-                           break;
-
-case OFX::eBitDepthUShort : {
-  ImageInverter<unsigned short, 4, 65535> fred(*this);
-  setupAndProcess(fred, args);
-                            }                          
-                            break;
-
-case OFX::eBitDepthFloat : {
-  ImageInverter<float, 4, 1> fred(*this);
-  setupAndProcess(fred, args);
-                           }
-                           break;
-default :
-  OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
-    }
-  }
-  else {
-    switch(dstBitDepth) {
-case OFX::eBitDepthUByte : {
-  ImageInverter<unsigned char, 1, 255> fred(*this);
-  setupAndProcess(fred, args);
-                           }
-                           break;
-
-case OFX::eBitDepthUShort : {
-  ImageInverter<unsigned short, 1, 65535> fred(*this);
-  setupAndProcess(fred, args);
-                            }                          
-                            break;
-
-case OFX::eBitDepthFloat : {
-  ImageInverter<float, 1, 1> fred(*this);
-  setupAndProcess(fred, args);
-                           }                          
-                           break;
-default :
-  OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
-    }
-  } 
+  OFX::dispatchPixelFormat(dstBitDepth, dstComponents, [&](auto format) {
+    typedef decltype(format) Format;
+    ImageInverter<typename Format::Pixel, Format::kComponents, Format::kMaxValue> fred(*this);
+    setupAndProcess(fred, args);
+  });
 }
 
 mDeclarePluginFactory(InvertExamplePluginFactory, {}, {});
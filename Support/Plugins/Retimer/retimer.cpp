@@ -146,9 +146,11 @@ RetimerPlugin::setupAndProcess(OFX::ImageBlenderBase &processor, const OFX::Rend
     double blend;
     framesNeeded(sourceTime, args.fieldToRender, &fromTime, &toTime, &blend);
 
-    // fetch the two source images
-    std::unique_ptr<OFX::Image> fromImg(srcClip_->fetchImage(fromTime));
-    std::unique_ptr<OFX::Image> toImg(srcClip_->fetchImage(toTime));
+    // fetch the two source images, starting both before waiting on either
+    std::unique_ptr<OFX::ImageFetch> fromFetch(srcClip_->fetchImageAsync(fromTime));
+    std::unique_ptr<OFX::ImageFetch> toFetch(srcClip_->fetchImageAsync(toTime));
+    std::unique_ptr<OFX::Image> fromImg(fromFetch->getImage());
+    std::unique_ptr<OFX::Image> toImg(toFetch->getImage());
 
     // make sure bit depths are sane
     if(fromImg.get()) checkComponents(*fromImg, dstBitDepth, dstComponents);
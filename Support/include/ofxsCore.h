@@ -73,6 +73,17 @@ of the direct OFX objects and any library side only functions.
 #include <stdexcept>
 #include <sstream>
 
+/** @brief Defined when the compiler has std::string_view, the string view property accessors and enum mappings are only declared then.
+
+Everything else in the support library builds as C++11. The string view functions are all inline,
+over exported functions that take a pointer and a length, so the library exports the same symbols
+whichever standard it and the plugins using it are compiled with.
+*/
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#  define OFXS_HAS_STRING_VIEW
+#  include <string_view>
+#endif
+
 #ifdef OFX_CLIENT_EXCEPTION_HEADER
 #include OFX_CLIENT_EXCEPTION_HEADER
 #endif
@@ -288,6 +299,15 @@ namespace OFX {
 
     /// get a string property
     std::string propGetString(const char* property, int idx, bool throwOnFailure = true) const;
+
+    /** @brief get a string property without copying it
+
+    This is the host's own string, which the property suite keeps valid until the property
+    is next set or the set is destroyed, and it must not be held any longer. A string the
+    host does not give is returned as "", never as NULL.
+    */
+    const char *propGetCString(const char* property, int idx, bool throwOnFailure = true) const;
+
     /// get a double property
     double      propGetDouble(const char* property, int idx, bool throwOnFailure = true) const;
 
@@ -306,6 +326,12 @@ namespace OFX {
       return propGetString(property, 0, throwOnFailure);
     }
 
+    /// get a string property with index 0 without copying it, see the indexed version for how long it lasts
+    const char *propGetCString(const char* property, bool throwOnFailure = true) const
+    {
+      return propGetCString(property, 0, throwOnFailure);
+    }
+
     /// get a double property with index 0
     double propGetDouble(const char* property, bool throwOnFailure = true) const
     {
@@ -320,6 +346,31 @@ namespace OFX {
 
     std::list<std::string> propGetNString(const char* property, bool throwOnFailure = true) const;
 
+    /// get all the values of a string property without copying them, they last as long as those of propGetCString
+    void propGetNCString(const char* property, std::vector<const char *> &values, bool throwOnFailure = true) const;
+
+#ifdef OFXS_HAS_STRING_VIEW
+    /// get a string property as a view, which lasts as long as the string from propGetCString
+    std::string_view propGetStringView(const char* property, int idx, bool throwOnFailure = true) const
+    {
+      return std::string_view(propGetCString(property, idx, throwOnFailure));
+    }
+
+    /// get a string property with index 0 as a view, which lasts as long as the string from propGetCString
+    std::string_view propGetStringView(const char* property, bool throwOnFailure = true) const
+    {
+      return std::string_view(propGetCString(property, 0, throwOnFailure));
+    }
+
+    /// get all the values of a string property as views, which last as long as the strings from propGetCString
+    std::vector<std::string_view> propGetNStringView(const char* property, bool throwOnFailure = true) const
+    {
+      std::vector<const char *> values;
+      propGetNCString(property, values, throwOnFailure);
+      return std::vector<std::string_view>(values.begin(), values.end());
+    }
+#endif
+
   };
 
   // forward decl of the image effect
@@ -18,6 +18,7 @@ of the direct OFX objects and any library side only functions.
 #include "ofxProgress.h"
 #include "ofxTimeLine.h"
 #include "ofxParametricParam.h"
+#include "ofxAsyncImageFetch.h"
 
 /** @brief Nasty macro used to define empty protected copy ctors and assign ops */
 #define mDeclareProtectedAssignAndCC(CLASS) \
@@ -118,10 +119,20 @@ namespace OFX {
 
   /** @brief turns a field string into and enum */
   FieldEnum mapStrToFieldEnum(const std::string &str);
+  FieldEnum mapStrToFieldEnum(const char *str);
+  FieldEnum mapStrToFieldEnum(const char *str, size_t len);
+#ifdef OFXS_HAS_STRING_VIEW
+  inline FieldEnum mapStrToFieldEnum(std::string_view str) { return mapStrToFieldEnum(str.data(), str.size()); }
+#endif
 
   ////////////////////////////////////////////////////////////////////////////////
-  /** @brief map a std::string to a context enum */
+  /** @brief map a string to a context enum */
   ContextEnum mapToContextEnum(const std::string &s);
+  ContextEnum mapToContextEnum(const char *s);
+  ContextEnum mapToContextEnum(const char *s, size_t len);
+#ifdef OFXS_HAS_STRING_VIEW
+  inline ContextEnum mapToContextEnum(std::string_view s) { return mapToContextEnum(s.data(), s.size()); }
+#endif
 
   const char* mapContextEnumToStr(ContextEnum context);
 
@@ -130,12 +141,27 @@ namespace OFX {
   OFX::Message::MessageReplyEnum mapToMessageReplyEnum(OfxStatus stat);
 
   InstanceChangeReason mapToInstanceChangedReason(const std::string &s);
+  InstanceChangeReason mapToInstanceChangedReason(const char *s);
+  InstanceChangeReason mapToInstanceChangedReason(const char *s, size_t len);
+#ifdef OFXS_HAS_STRING_VIEW
+  inline InstanceChangeReason mapToInstanceChangedReason(std::string_view s) { return mapToInstanceChangedReason(s.data(), s.size()); }
+#endif
 
   BitDepthEnum mapStrToBitDepthEnum(const std::string &str);
+  BitDepthEnum mapStrToBitDepthEnum(const char *str);
+  BitDepthEnum mapStrToBitDepthEnum(const char *str, size_t len);
+#ifdef OFXS_HAS_STRING_VIEW
+  inline BitDepthEnum mapStrToBitDepthEnum(std::string_view str) { return mapStrToBitDepthEnum(str.data(), str.size()); }
+#endif
 
   const char* mapBitDepthEnumToStr(BitDepthEnum bitDepth);
 
   PixelComponentEnum mapStrToPixelComponentEnum(const std::string &str);
+  PixelComponentEnum mapStrToPixelComponentEnum(const char *str);
+  PixelComponentEnum mapStrToPixelComponentEnum(const char *str, size_t len);
+#ifdef OFXS_HAS_STRING_VIEW
+  inline PixelComponentEnum mapStrToPixelComponentEnum(std::string_view str) { return mapStrToPixelComponentEnum(str.data(), str.size()); }
+#endif
 
   const char* mapPixelComponentEnumToStr(PixelComponentEnum pixelComponent);
 
@@ -264,6 +290,7 @@ namespace OFX {
     int maxPages;
     int pageRowCount;
     int pageColumnCount;
+    int rowAlignment;       /**< @brief byte alignment the host guarantees for the start of every image row, 0 if none */
     typedef std::vector<PixelComponentEnum> PixelComponentArray;
     PixelComponentArray _supportedComponents;
     typedef std::vector<ContextEnum> ContextArray;
@@ -593,6 +620,14 @@ namespace OFX {
     can't know the pixel size to do the work.
     */
     const void *getPixelAddress(int x, int y) const;
+
+    /** @brief the alignment in bytes, up to a cache line, of the start of every row of this image
+
+    This is the alignment the rows actually have, whatever the host guarantees in
+    ImageEffectHostDescription::rowAlignment, so kernels can pick aligned loads per image.
+    Returns 0 if there is no pixel data.
+    */
+    int getRowAlignment(void) const;
   };
 
   ////////////////////////////////////////////////////////////////////////////////
@@ -616,6 +651,58 @@ namespace OFX {
     inline int getTarget() const {return _target;}
   };
 
+  class Clip;
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /** @brief An image being fetched from a clip, as returned by Clip::fetchImageAsync
+
+  Start all the fetches a render needs, then get the images from them, so a host with the
+  async image fetch suite can fetch them at the same time. On hosts without the suite the
+  image is fetched when it is asked for, which costs no more than calling Clip::fetchImage.
+
+  Deleting a fetch whose image has not been got abandons it.
+  */
+  class ImageFetch {
+  protected :
+    mDeclareProtectedAssignAndCC(ImageFetch);
+
+    /** @brief clip the image is fetched from */
+    Clip *_clip;
+
+    /** @brief time the image is fetched at */
+    double _time;
+
+    /** @brief region the image is fetched over, if _hasBounds */
+    OfxRectD _bounds;
+    bool _hasBounds;
+
+    /** @brief handle of the host's fetch, null if the host could not start one */
+    OfxImageFetchHandle _handle;
+
+    /** @brief has the image been got */
+    bool _done;
+
+    /** @brief hidden constructor, starts the fetch */
+    ImageFetch(Clip *clip, double t, const OfxRectD *bounds);
+
+    /** @brief so one can be made */
+    friend class Clip;
+
+  public :
+    /** @brief dtor, abandons the fetch if the image has not been got */
+    ~ImageFetch();
+
+    /** @brief is the host fetching the image in the background */
+    bool isAsync(void) const {return _handle != 0;}
+
+    /** @brief wait for the image and return it
+
+    When finished with, the client code must delete the image. Returns NULL if there is no
+    image, as Clip::fetchImage does, and NULL on any call after the first.
+    */
+    Image *getImage(void);
+  };
+
   ////////////////////////////////////////////////////////////////////////////////
   /** @brief Wraps up a clip instance */
   class Clip {
@@ -740,6 +827,18 @@ namespace OFX {
         return fetchImage(t);
     }
 
+    /** @brief start fetching an image, with an optional region in canonical coordinates
+
+    When finished with, the client code must delete the fetch, and the image got from it.
+    */
+    ImageFetch *fetchImageAsync(double t, const OfxRectD *bounds = NULL);
+
+    /** @brief start fetching an image, with a specific region in canonical coordinates
+
+    When finished with, the client code must delete the fetch, and the image got from it.
+    */
+    ImageFetch *fetchImageAsync(double t, const OfxRectD &bounds) {return fetchImageAsync(t, &bounds);}
+
 #ifdef OFX_SUPPORTS_OPENGLRENDER
     Texture *loadTexture(double t, BitDepthEnum format = eBitDepthNone, const OfxRectD *region = NULL);
 #endif
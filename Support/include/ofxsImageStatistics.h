@@ -0,0 +1,78 @@
+#ifndef _ofxsImageStatistics_H_
+#define _ofxsImageStatistics_H_
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+/** @file This file contains code to gather statistics over the pixels of an image.
+
+Any of the per component minimum and maximum, mean and histogram, and the bounds of the
+pixels with a non zero alpha, are gathered in a single pass over a window of the image,
+spread over the host's threads. Rows are converted to floats a chunk at a time, with
+bytes and shorts scaled to 0 to 1 as by OFX::PixelConversion, so the statistics of all
+depths are in the same units.
+*/
+
+#include <vector>
+
+#include "ofxsImageEffect.h"
+
+/** @brief The core 'OFX Support' namespace, used by plugin implementations. All code for these are defined in the common support libraries.
+*/
+namespace OFX {
+
+  /** @brief Namespace for gathering statistics over images */
+  namespace ImageStatistics {
+
+    /** @brief Enumerates the statistics that can be gathered, or them together to gather several */
+    enum StatisticEnum {
+      eStatisticMinMax      = 1, /**< @brief the least and greatest value of each component */
+      eStatisticMean        = 2, /**< @brief the mean value of each component */
+      eStatisticHistogram   = 4, /**< @brief a histogram of the values of each component */
+      eStatisticAlphaBounds = 8, /**< @brief the bounds of the pixels whose alpha is not zero */
+      eStatisticAll         = 15 /**< @brief all of the above */
+    };
+
+    /** @brief What to gather */
+    struct Options {
+      unsigned int statistics; /**< @brief the statistics to gather, an or of StatisticEnum */
+      int nBins;               /**< @brief the number of bins in the histogram of each component */
+      float low;               /**< @brief the value at the bottom of the first bin, anything lower goes in it */
+      float high;              /**< @brief the value at the top of the last bin, anything higher goes in it */
+
+      Options(unsigned int s = eStatisticAll, int n = 256, float l = 0.f, float h = 1.f)
+        : statistics(s)
+        , nBins(n)
+        , low(l)
+        , high(h)
+      {}
+    };
+
+    /** @brief The statistics gathered over a window of an image */
+    struct Results {
+      int nComponents;                  /**< @brief the number of components in each pixel */
+      long long nPixels;                /**< @brief the number of pixels the statistics were gathered over */
+      float min[4];                     /**< @brief the least value of each component, if eStatisticMinMax was asked for */
+      float max[4];                     /**< @brief the greatest value of each component, if eStatisticMinMax was asked for */
+      double mean[4];                   /**< @brief the mean value of each component, if eStatisticMean was asked for */
+      int nBins;                        /**< @brief the number of bins in each component's histogram */
+      std::vector<long long> histogram; /**< @brief nBins counts for the first component, then for the next and so on */
+      OfxRectI alphaBounds;             /**< @brief the bounds of the pixels with a non zero alpha, empty if there are none,
+                                             the whole window for images without alpha */
+
+      /** @brief the count in a bin of a component's histogram */
+      long long getCount(int component, int bin) const {return histogram[(size_t) component * nBins + bin];}
+    };
+
+    /** @brief Gather statistics over the pixels of an image within a window.
+
+    The window is clipped to the image's bounds. NaNs are ignored by the minimum and maximum,
+    and counted in the first bin of the histogram. Throws kOfxStatErrUnsupported if the
+    depth is not one of byte, short, half or float, and kOfxStatErrImageFormat if pixels have
+    more than four components.
+    */
+    Results compute(const Image &image, const OfxRectI &window, const Options &options = Options());
+
+  };
+};
+
+#endif
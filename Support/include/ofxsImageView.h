@@ -0,0 +1,244 @@
+#ifndef _ofxsImageView_H_
+#define _ofxsImageView_H_
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+/** @file This file contains typed views onto the pixels of an image.
+
+An OFX::Image only knows its pixel type at run time, so getPixelAddress has to bounds check
+and multiply on every call. A view is made once per image by a processor that already knows
+the pixel type as template arguments, after which rows and runs of pixels within them are had
+with an add or two, leaving inner loops to walk plain pointers.
+
+dispatchPixelFormat does the switch over depth and components a render needs to pick the
+template arguments to instantiate its processor with.
+*/
+
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+
+#include "ofxsImageEffect.h"
+
+/** @brief The core 'OFX Support' namespace, used by plugin implementations. All code for these are defined in the common support libraries.
+*/
+namespace OFX {
+
+  /** @brief A run of pixels along a row, from x1 up to but not including x2, in the style of a std::span.
+
+  PIX may be const qualified for a run of a source image.
+  */
+  template <class PIX, int nComponents>
+  class PixelSpan {
+  protected :
+    PIX *_data; /**< @brief the first component of the pixel at x1 */
+    int _x1;    /**< @brief the first pixel */
+    int _x2;    /**< @brief one past the last pixel */
+
+  public :
+    /** @brief an empty run */
+    PixelSpan() : _data(0), _x1(0), _x2(0) {}
+
+    /** @brief a run of pixels starting at data */
+    PixelSpan(PIX *data, int x1, int x2) : _data(data), _x1(x1), _x2(x2) {}
+
+    /** @brief the first component of the pixel at x1 */
+    PIX *data() const {return _data;}
+
+    /** @brief the first pixel in the run */
+    int x1() const {return _x1;}
+
+    /** @brief one past the last pixel in the run */
+    int x2() const {return _x2;}
+
+    /** @brief the number of pixels in the run */
+    int size() const {return _x2 - _x1;}
+
+    /** @brief is the run empty */
+    bool empty() const {return _x2 <= _x1;}
+
+    /** @brief the first component of the first pixel */
+    PIX *begin() const {return _data;}
+
+    /** @brief one past the last component of the last pixel */
+    PIX *end() const {return _data + (std::ptrdiff_t) size() * nComponents;}
+
+    /** @brief the pixel i pixels along the run */
+    PIX *operator[](int i) const {return _data + (std::ptrdiff_t) i * nComponents;}
+
+    /** @brief the pixel at x, which must lie within the run */
+    PIX *pixel(int x) const {return _data + (std::ptrdiff_t) (x - _x1) * nComponents;}
+  };
+
+  /** @brief A view onto the pixels of an OFX::Image whose type is known at compile time.
+
+  PIX is the type of a component, const qualified for a view of a source image, and
+  nComponents the number of them per pixel. A view of a NULL image is valid, but empty.
+  Nothing is bounds checked but the spans.
+  */
+  template <class PIX, int nComponents>
+  class ImageView {
+  public :
+    typedef PixelSpan<PIX, nComponents> Span;
+
+  protected :
+    char *_origin;           /**< @brief the pixel at the bottom left of the bounds */
+    std::ptrdiff_t _rowBytes; /**< @brief bytes from one row to the next, may be negative */
+    OfxRectI _bounds;        /**< @brief the bounds on the pixel data */
+
+  public :
+    /** @brief an empty view */
+    ImageView()
+      : _origin(0)
+      , _rowBytes(0)
+    {
+      _bounds.x1 = _bounds.y1 = _bounds.x2 = _bounds.y2 = 0;
+    }
+
+    /** @brief a view of an image, which may be NULL, whose pixels must be of the view's type.
+
+    A view of a const image must have a const PIX.
+    */
+    template <class IMG>
+    explicit ImageView(IMG *image)
+      : _origin(0)
+      , _rowBytes(0)
+    {
+      _bounds.x1 = _bounds.y1 = _bounds.x2 = _bounds.y2 = 0;
+      if(image && image->getPixelData()) {
+        assert(image->getPixelComponentCount() == nComponents);
+        // fails to compile if a const image is viewed with a non const PIX
+        PIX *data = static_cast<PIX *>(image->getPixelData());
+        _origin = (char *) data;
+        _rowBytes = image->getRowBytes();
+        _bounds = image->getBounds();
+      }
+    }
+
+    /** @brief does the view have any pixels */
+    bool isValid() const {return _origin != 0;}
+
+    /** @brief the bounds on the pixel data */
+    const OfxRectI &getBounds() const {return _bounds;}
+
+    /** @brief is the pixel at (x, y) within the bounds */
+    bool contains(int x, int y) const
+    {
+      return _origin && x >= _bounds.x1 && x < _bounds.x2 && y >= _bounds.y1 && y < _bounds.y2;
+    }
+
+    /** @brief the pixel at the left of the bounds in row y, which must lie within them */
+    PIX *getRow(int y) const
+    {
+      return (PIX *) (_origin + (y - _bounds.y1) * _rowBytes);
+    }
+
+    /** @brief the pixel at (x, y), which must lie within the bounds */
+    PIX *getPixel(int x, int y) const
+    {
+      return getRow(y) + (std::ptrdiff_t) (x - _bounds.x1) * nComponents;
+    }
+
+    /** @brief the whole of row y, which must lie within the bounds */
+    Span getRowSpan(int y) const
+    {
+      return Span(getRow(y), _bounds.x1, _bounds.x2);
+    }
+
+    /** @brief the pixels from x1 up to x2 in row y, clipped to the bounds, which is empty if none are in them */
+    Span getSpan(int y, int x1, int x2) const
+    {
+      x1 = std::max(x1, _bounds.x1);
+      x2 = std::min(x2, _bounds.x2);
+      if(!_origin || y < _bounds.y1 || y >= _bounds.y2 || x1 >= x2)
+        return Span();
+      return Span(getPixel(x1, y), x1, x2);
+    }
+
+    /** @brief call fn(y, span) for each row of the window that lies within the bounds, with the
+    span of that row clipped to them, stopping early if fn returns false
+    */
+    template <class F>
+    void forEachSpan(const OfxRectI &window, F fn) const
+    {
+      if(!_origin)
+        return;
+      int x1 = std::max(window.x1, _bounds.x1);
+      int x2 = std::min(window.x2, _bounds.x2);
+      int y1 = std::max(window.y1, _bounds.y1);
+      int y2 = std::min(window.y2, _bounds.y2);
+      if(x1 >= x2)
+        return;
+      for(int y = y1; y < y2; ++y) {
+        if(!fn(y, Span(getPixel(x1, y), x1, x2)))
+          return;
+      }
+    }
+  };
+
+  /** @brief The pixel type a processor is instantiated for, as handed to a dispatchPixelFormat functor */
+  template <class PIX, int nComponents, int maxValue>
+  struct PixelFormat {
+    typedef PIX Pixel;                               /**< @brief the type of a component */
+    static const int kComponents = nComponents;      /**< @brief the number of components per pixel */
+    static const int kMaxValue = maxValue;           /**< @brief the value of a component at full intensity */
+  };
+
+  /** @brief Call functor(PixelFormat<PIX, nComponents, maxValue>()) for the given depth and components.
+
+  Byte, short and float depths of RGBA, RGB and alpha components are dispatched, anything else
+  throws kOfxStatErrUnsupported. A generic lambda can then instantiate a processor with,
+
+  @verbatim
+    dispatchPixelFormat(depth, components, [&](auto format) {
+      typedef decltype(format) Format;
+      MyProcessor<typename Format::Pixel, Format::kComponents, Format::kMaxValue> processor(*this);
+      setupAndProcess(processor, args);
+    });
+  @endverbatim
+  */
+  template <class F>
+  void dispatchPixelFormat(BitDepthEnum depth, PixelComponentEnum components, F &&functor)
+  {
+    int nComponents = (components == ePixelComponentRGBA ? 4 :
+                       components == ePixelComponentRGB ? 3 :
+                       components == ePixelComponentAlpha ? 1 : 0);
+    switch(depth) {
+    case eBitDepthUByte :
+      switch(nComponents) {
+      case 4 : functor(PixelFormat<unsigned char, 4, 255>()); return;
+      case 3 : functor(PixelFormat<unsigned char, 3, 255>()); return;
+      case 1 : functor(PixelFormat<unsigned char, 1, 255>()); return;
+      }
+      break;
+    case eBitDepthUShort :
+      switch(nComponents) {
+      case 4 : functor(PixelFormat<unsigned short, 4, 65535>()); return;
+      case 3 : functor(PixelFormat<unsigned short, 3, 65535>()); return;
+      case 1 : functor(PixelFormat<unsigned short, 1, 65535>()); return;
+      }
+      break;
+    case eBitDepthFloat :
+      switch(nComponents) {
+      case 4 : functor(PixelFormat<float, 4, 1>()); return;
+      case 3 : functor(PixelFormat<float, 3, 1>()); return;
+      case 1 : functor(PixelFormat<float, 1, 1>()); return;
+      }
+      break;
+    default :
+      break;
+    }
+    throwSuiteStatusException(kOfxStatErrUnsupported);
+  }
+
+  /** @brief Call functor(PixelFormat<PIX, nComponents, maxValue>()) for the depth and components of an image */
+  template <class F>
+  void dispatchPixelFormat(const ImageBase &image, F &&functor)
+  {
+    dispatchPixelFormat(image.getPixelDepth(), image.getPixelComponents(), std::forward<F>(functor));
+  }
+
+};
+
+#endif
@@ -4,7 +4,30 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 /** @file This file contains OFX logging header code
+
+Messages are formatted into a ring buffer owned by the thread logging them, and written to
+the log file in time order by a background thread, so threads never wait on the file or on
+each other to log. Timestamps are kept as raw clock ticks until written.
+
+The OFX_LOG_DEBUG, OFX_LOG_INFO, OFX_LOG_WARNING and OFX_LOG_ERROR macros compile to nothing,
+arguments and all, for levels below OFX_LOG_LEVEL.
+*/
+
+#include <string>
+
+/** @brief The level below which the OFX_LOG_ macros compile to nothing, a LevelEnum value.
+
+Defaults to everything in DEBUG builds, and to errors otherwise, so that property validation
+can report problems from release builds. Release builds only open the log file if the
+OFX_PLUGIN_LOGFILE environment variable names one, so logging costs them nothing unless asked for.
 */
+#ifndef OFX_LOG_LEVEL
+#  ifdef DEBUG
+#    define OFX_LOG_LEVEL 0
+#  else
+#    define OFX_LOG_LEVEL 3
+#  endif
+#endif
 
 /** @brief The core 'OFX Support' namespace, used by plugin implementations. All code for these are defined in the common support libraries.
 */
@@ -12,21 +35,39 @@ namespace OFX {
 
   /** @brief this namespace wraps up logging functionality */
   namespace Log {
-    /** @brief Indent it, not MP sane at the moment */
+    /** @brief Enumerates the levels of messages */
+    enum LevelEnum {
+      eLevelDebug = 0,  /**< @brief traces of what the support code is doing */
+      eLevelInfo,       /**< @brief ordinary messages */
+      eLevelWarning,    /**< @brief something odd that can be carried on from */
+      eLevelError,      /**< @brief something that went wrong */
+      eLevelNone        /**< @brief as OFX_LOG_LEVEL, nothing is logged */
+    };
+
+    /** @brief Indent the calling thread's messages */
     void indent(void);
 
-    /** @brief Outdent it, not MP sane at the moment */
+    /** @brief Outdent the calling thread's messages */
     void outdent(void);
 
     /** @brief Sets the name of the log file. */
     void setFileName(const std::string &value);
 
-    /** @brief Opens the log file, returns whether this was successful or not. */
+    /** @brief Opens the log file and starts the thread writing to it, returns whether this was successful or not.
+
+    Outside of DEBUG builds this only opens the file if OFX_PLUGIN_LOGFILE is set.
+    */
     bool open(void);
 
-    /** @brief Closes the log file. */
+    /** @brief Writes out any messages waiting, stops the writing thread and closes the log file. */
     void close(void);
 
+    /** @brief Writes out the messages logged so far, returning once they are in the file. */
+    void flush(void);
+
+    /** @brief Logs a message at the given level, prefixed with a notice for warnings and errors. */
+    void log(LevelEnum level, const char *format, ...);
+
     /** @brief Prints to the log file. */
     void print(const char *format, ...);
 
@@ -38,4 +79,28 @@ namespace OFX {
   };
 };
 
+#if OFX_LOG_LEVEL <= 0
+#  define OFX_LOG_DEBUG(...) OFX::Log::log(OFX::Log::eLevelDebug, __VA_ARGS__)
+#else
+#  define OFX_LOG_DEBUG(...) ((void) 0)
+#endif
+
+#if OFX_LOG_LEVEL <= 1
+#  define OFX_LOG_INFO(...) OFX::Log::log(OFX::Log::eLevelInfo, __VA_ARGS__)
+#else
+#  define OFX_LOG_INFO(...) ((void) 0)
+#endif
+
+#if OFX_LOG_LEVEL <= 2
+#  define OFX_LOG_WARNING(...) OFX::Log::log(OFX::Log::eLevelWarning, __VA_ARGS__)
+#else
+#  define OFX_LOG_WARNING(...) ((void) 0)
+#endif
+
+#if OFX_LOG_LEVEL <= 3
+#  define OFX_LOG_ERROR(...) OFX::Log::log(OFX::Log::eLevelError, __VA_ARGS__)
+#else
+#  define OFX_LOG_ERROR(...) ((void) 0)
+#endif
+
 #endif
@@ -9,6 +9,9 @@ This file only holds code that is visible to a plugin implementation, and so hid
 of the direct OFX objects and any library side only functions.
 */
 
+#include <algorithm>
+#include <vector>
+
 #include "ofxsCore.h"
 
 typedef struct OfxMutex* OfxMutexHandle;
@@ -50,6 +53,145 @@ namespace OFX {
     /** @brief The index of the current thread. From 0 to numCPUs() - 1 */
     unsigned int getThreadIndex(void);
 
+    /** @brief A half open range of indices, from begin up to but not including end */
+    struct Range {
+      int begin; /**< @brief the first index */
+      int end;   /**< @brief one past the last index */
+
+      Range() : begin(0), end(0) {}
+      Range(int b, int e) : begin(b), end(e) {}
+
+      /** @brief the number of indices in the range */
+      int size() const {return end > begin ? end - begin : 0;}
+    };
+
+    /** @brief The number of indices in each chunk parallelFor and parallelReduce cut a range into.
+
+    A grain of 0 or less picks one giving a few hundred chunks. Ranges are never cut into more
+    than a thousand or so chunks, whatever the grain asked for.
+    */
+    int getGrain(const Range &range, int grain);
+
+    /** @brief Call fn(chunk, arg) once for each chunk from 0 to nChunks - 1, spread over the CPUs.
+
+    Threads take chunks in turn from a shared counter until there are none left, so chunks that
+    take longer than others do not hold the rest up. If fn throws, no more chunks are started
+    and the first exception is rethrown on the calling thread. When called from a spawned thread
+    the chunks are done in order on that thread.
+    */
+    void forEachChunk(int nChunks, void (*fn)(int chunk, void *arg), void *arg);
+
+    /** @brief The size of a cache line, which data written by different threads should not share */
+    static const size_t kCacheLineBytes = 64;
+
+    /** @brief A value alone on its cache lines, so threads updating neighbouring values do not contend */
+    template <class T>
+    struct alignas(kCacheLineBytes) CacheLinePadded {
+      T value;
+
+      CacheLinePadded() : value() {}
+      explicit CacheLinePadded(const T &v) : value(v) {}
+    };
+
+    /** @brief Call fn(Range) over the chunks of a range, in parallel.
+
+    fn is called from several threads at once, on chunks of grain indices, so must only write
+    to what the chunk it is given owns.
+
+    @verbatim
+      OFX::MultiThread::parallelFor(OFX::MultiThread::Range(y1, y2), 8, [&](const OFX::MultiThread::Range &rows) {
+        for(int y = rows.begin; y < rows.end; ++y)
+          processRow(y);
+      });
+    @endverbatim
+    */
+    template <class F>
+    void parallelFor(const Range &range, int grain, F fn)
+    {
+      struct Closure {
+        Range range;
+        int grain;
+        F *fn;
+
+        static void call(int chunk, void *arg)
+        {
+          Closure *closure = (Closure *) arg;
+          int begin = closure->range.begin + chunk * closure->grain;
+          (*closure->fn)(Range(begin, std::min(begin + closure->grain, closure->range.end)));
+        }
+      };
+
+      int size = range.size();
+      if(size == 0)
+        return;
+      Closure closure = {range, getGrain(range, grain), &fn};
+      forEachChunk((size + closure.grain - 1) / closure.grain, &Closure::call, (void *) &closure);
+    }
+
+    /** @brief Reduce a range to a single value, in parallel.
+
+    The range is cut into one contiguous slice per CPU, each reduced by its own thread into a
+    partial value, starting from a copy of identity, by calling fn(Range, partial) on each chunk
+    of grain indices of the slice in order. The partials are then folded into a copy of
+    identity with combine(result, partial), in slice order, on the calling thread. Partials sit
+    on cache lines of their own and nothing is locked, and for a given number of CPUs the
+    same range gives the same result every time, floating point sums included.
+
+    @verbatim
+      std::vector<int> histogram = OFX::MultiThread::parallelReduce(OFX::MultiThread::Range(y1, y2), std::vector<int>(256),
+        [&](const OFX::MultiThread::Range &rows, std::vector<int> &partial) {
+          for(int y = rows.begin; y < rows.end; ++y)
+            countRow(y, partial);
+        },
+        [](std::vector<int> &result, const std::vector<int> &partial) {
+          for(size_t i = 0; i < result.size(); ++i)
+            result[i] += partial[i];
+        });
+    @endverbatim
+    */
+    template <class T, class F, class C>
+    T parallelReduce(const Range &range, const T &identity, F fn, C combine, int grain = 0)
+    {
+      struct Closure {
+        Range range;
+        int grain;
+        int nChunks;
+        int nSlices;
+        F *fn;
+        std::vector<CacheLinePadded<T> > *partials;
+
+        static void call(int slice, void *arg)
+        {
+          Closure *closure = (Closure *) arg;
+          // the chunks of this slice, shared out as evenly as can be
+          int chunk1 = (int) ((long long) closure->nChunks * slice / closure->nSlices);
+          int chunk2 = (int) ((long long) closure->nChunks * (slice + 1) / closure->nSlices);
+          T &partial = (*closure->partials)[slice].value;
+          for(int chunk = chunk1; chunk < chunk2; ++chunk) {
+            int begin = closure->range.begin + chunk * closure->grain;
+            (*closure->fn)(Range(begin, std::min(begin + closure->grain, closure->range.end)), partial);
+          }
+        }
+      };
+
+      T result(identity);
+      int size = range.size();
+      if(size == 0)
+        return result;
+
+      int g = getGrain(range, grain);
+      int nChunks = (size + g - 1) / g;
+      int nSlices = (int) std::min<unsigned int>(getNumCPUs(), (unsigned int) nChunks);
+      std::vector<CacheLinePadded<T> > partials(nSlices, CacheLinePadded<T>(identity));
+
+      Closure closure = {range, g, nChunks, nSlices, &fn, &partials};
+      forEachChunk(nSlices, &Closure::call, (void *) &closure);
+
+      for(int i = 0; i < nSlices; ++i)
+        combine(result, partials[i].value);
+      return result;
+    }
+
     /** @brief An OFX mutex */
     class Mutex {
     protected :
@@ -1239,6 +1239,12 @@ namespace OFX {
         /** @brief get value */
         double getValueAtTime(double t) {double v; getValueAtTime(t, v); return v;}
 
+        /** @brief get the values at each of an array of times, values must hold nTimes doubles */
+        void getValuesAtTimes(const double *times, int nTimes, double *values);
+
+        /** @brief get the values at nTimes times spaced step apart from start, values must hold nTimes doubles */
+        void getValuesOverRange(double start, double step, int nTimes, double *values);
+
         /** @brief set value */
         void setValue(double v);
 
@@ -1299,6 +1305,12 @@ namespace OFX {
         /** @brief get the value at a time */
         void getValueAtTime(double t, double &x, double &y);
 
+        /** @brief get the values at each of an array of times, values must hold 2 * nTimes doubles, as x, y pairs */
+        void getValuesAtTimes(const double *times, int nTimes, double *values);
+
+        /** @brief get the values at nTimes times spaced step apart from start, values must hold 2 * nTimes doubles, as x, y pairs */
+        void getValuesOverRange(double start, double step, int nTimes, double *values);
+
         /** @brief set value */
         void setValue(double x, double y);
 
@@ -1436,6 +1448,12 @@ namespace OFX {
         /** @brief get the value at a time */
         void getValueAtTime(double t, double &r, double &g, double &b, double &a);
 
+        /** @brief get the values at each of an array of times, values must hold 4 * nTimes doubles, as r, g, b, a quads */
+        void getValuesAtTimes(const double *times, int nTimes, double *values);
+
+        /** @brief get the values at nTimes times spaced step apart from start, values must hold 4 * nTimes doubles, as r, g, b, a quads */
+        void getValuesOverRange(double start, double step, int nTimes, double *values);
+
         /** @brief set value */
         void setValue(double r, double g, double b, double a);
 
@@ -0,0 +1,75 @@
+#ifndef _ofxsPixelConversion_H_
+#define _ofxsPixelConversion_H_
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+/** @file This file contains code to convert pixels between bit depths.
+
+Rows are converted a chunk at a time, through floats where the depths need it, with kernels
+picked once at run time for the best instruction set the CPU has. Conversions to integral
+depths round to nearest, ties to even, and clamp to the depth's range, with NaN going to 0.
+Conversions to half round to nearest even and overflow to infinity.
+*/
+
+#include "ofxsImageEffect.h"
+
+/** @brief The core 'OFX Support' namespace, used by plugin implementations. All code for these are defined in the common support libraries.
+*/
+namespace OFX {
+
+  /** @brief Namespace for converting pixels between bit depths */
+  namespace PixelConversion {
+
+    /** @brief Enumerates the instruction sets conversions may be done with */
+    enum InstructionSetEnum {
+      eInstructionSetPortable, /**< @brief plain C++ */
+      eInstructionSetF16C,     /**< @brief AVX and F16C, for converting to and from half */
+      eInstructionSetAVX2,     /**< @brief AVX2 and F16C */
+      eInstructionSetAVX512    /**< @brief AVX-512F */
+    };
+
+    /** @brief Enumerates the ways a conversion to a coarser integral depth may be dithered */
+    enum DitherEnum {
+      eDitherNone,    /**< @brief round each value to nearest */
+      eDitherOrdered  /**< @brief add a 4x4 ordered dither pattern before rounding, to break up banding */
+    };
+
+    /** @brief the instruction set conversions are being done with */
+    InstructionSetEnum getInstructionSet(void);
+
+    /** @brief convert a float to a half, as stored in an eBitDepthHalf image */
+    unsigned short floatToHalf(float f);
+
+    /** @brief convert a half, as stored in an eBitDepthHalf image, to a float */
+    float halfToFloat(unsigned short h);
+
+    /** @brief Convert a row of pixels between two depths.
+
+    \arg src, the first pixel to convert
+    \arg srcDepth, the depth of the source pixels
+    \arg dst, where to put the first converted pixel, which may not overlap the source
+    \arg dstDepth, the depth to convert to
+    \arg nPixels, the number of pixels in the row
+    \arg nComponents, the number of components in each pixel
+    \arg dither, whether to dither conversions to a coarser integral depth
+    \arg x, y, the position of the first pixel, which sets the phase of any dither
+
+    Throws kOfxStatErrUnsupported if either depth is not one of byte, short, half or float.
+    */
+    void convertRow(const void *src, BitDepthEnum srcDepth,
+                    void *dst, BitDepthEnum dstDepth,
+                    int nPixels, int nComponents,
+                    DitherEnum dither = eDitherNone, int x = 0, int y = 0);
+
+    /** @brief Convert the pixels of one image within a window into another.
+
+    The window is clipped to the bounds of both images. Throws kOfxStatErrImageFormat if
+    the images' components differ, and kOfxStatErrUnsupported if either depth is not one of
+    byte, short, half or float.
+    */
+    void convertImage(const Image &src, Image &dst, const OfxRectI &window, DitherEnum dither = eDitherNone);
+
+  };
+};
+
+#endif
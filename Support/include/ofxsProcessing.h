@@ -37,7 +37,10 @@ England
 */
 
 #include <cassert>
+#include <cstdlib>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 
 #include "ofxsImageEffect.h"
 #include "ofxsMultiThread.h"
@@ -54,6 +57,16 @@ namespace OFX {
     ////////////////////////////////////////////////////////////////////////////////
     // base class to process images with
     class ImageProcessor : public OFX::MultiThread::Processor {
+    public :
+        /** @brief how the render window is shared out between the threads processing it */
+        enum SchedulingEnum {
+            eSchedulingBands, /**< @brief each thread processes one equal band of rows, the default */
+            eSchedulingTiles  /**< @brief threads take cache sized tiles from a shared counter until none are left */
+        };
+
+        /** @brief the number of bytes of destination a tile is sized to start at, about an L2 cache's worth */
+        static const int kTileBytes = 256 * 1024;
+
     protected :
         OFX::ImageEffect &_effect;      /**< @brief effect to render with */
         OFX::Image       *_dstImg;        /**< @brief image to process into */
@@ -64,6 +77,70 @@ namespace OFX {
         void*            _pOpenCLCmdQ;           /**< @brief OpenCL Command Queue Handle */
         void*            _pCudaStream;           /**< @brief Cuda Stream Handle */
         void*            _pMetalCmdQ;           /**< @brief Metal Command Queue Handle */
+        SchedulingEnum   _scheduling;            /**< @brief how the render window is shared out */
+        int              _tileRows;              /**< @brief rows a tile starts with, when scheduling by tiles */
+        int              _tileColumns;           /**< @brief columns a tile has, when scheduling by tiles */
+        std::atomic<int> _nextTileRow;           /**< @brief the first row not yet taken by a thread, when scheduling by tiles */
+
+        /** @brief size the tiles to start with and reset the shared counter, called by process before going MP */
+        void setupTiles(void)
+        {
+            int width = _renderWindow.x2 - _renderWindow.x1;
+            // bytes of destination per pixel, guessing at float RGBA if there is no destination
+            int pixelBytes = 16;
+            if (_dstImg) {
+                int boundsWidth = _dstImg->getBounds().x2 - _dstImg->getBounds().x1;
+                if (boundsWidth > 0) {
+                    pixelBytes = std::max(1, std::abs(_dstImg->getRowBytes()) / boundsWidth);
+                }
+            }
+            // rows wider than a tile's worth are processed a block of columns at a time
+            _tileColumns = std::max(1, std::min(width, kTileBytes / pixelBytes));
+            _tileRows = std::max(1, kTileBytes / (_tileColumns * pixelBytes));
+            _nextTileRow = _renderWindow.y1;
+        }
+
+        /** @brief process tiles from the shared counter until the render window is done, called on each thread */
+        void multiThreadProcessTiles(unsigned int nThreads)
+        {
+            // Tiles that take much less than kMinTileTime spend too much of it
+            // going to the counter, so this thread takes more rows at a time,
+            // while ones that take more than kMaxTileTime risk leaving the
+            // other threads idle at the end, so it takes fewer.
+            const double kMinTileTime = 50e-6;
+            const double kMaxTileTime = 2e-3;
+
+            int rows = _tileRows;
+            for (;;) {
+                // near the end take smaller tiles, so that the threads finish together
+                int remaining = _renderWindow.y2 - _nextTileRow.load(std::memory_order_relaxed);
+                int n = std::max(1, std::min(rows, remaining / (int)(2 * nThreads)));
+
+                int y1 = _nextTileRow.fetch_add(n, std::memory_order_relaxed);
+                if (y1 >= _renderWindow.y2 || _effect.abort()) {
+                    return;
+                }
+
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+                OfxRectI win = _renderWindow;
+                win.y1 = y1;
+                win.y2 = std::min(y1 + n, _renderWindow.y2);
+                for (int x1 = _renderWindow.x1; x1 < _renderWindow.x2; x1 += _tileColumns) {
+                    win.x1 = x1;
+                    win.x2 = std::min(x1 + _tileColumns, _renderWindow.x2);
+                    multiThreadProcessImages(win);
+                }
+
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (seconds < kMinTileTime && n == rows) {
+                    rows *= 2;
+                }
+                else if (seconds > kMaxTileTime && rows > 1) {
+                    rows /= 2;
+                }
+            }
+        }
 
     public :
         /** @brief ctor */
@@ -76,6 +153,10 @@ namespace OFX {
           , _pOpenCLCmdQ(NULL)
           , _pCudaStream(NULL)
           , _pMetalCmdQ(NULL)
+          , _scheduling(eSchedulingBands)
+          , _tileRows(1)
+          , _tileColumns(1)
+          , _nextTileRow(0)
         {
             _renderWindow.x1 = _renderWindow.y1 = _renderWindow.x2 = _renderWindow.y2 = 0;
         }
@@ -107,9 +188,25 @@ namespace OFX {
         /** @brief reset the render window */
         void setRenderWindow(OfxRectI rect) {_renderWindow = rect;}
 
+        /** @brief Set how the render window is shared out between threads.
+
+        Scheduling by tiles suits processors whose cost varies across the image, or is
+        not known up front, as well as large windows, but multiThreadProcessImages is
+        then called many times per thread, on windows that may not span whole rows.
+        */
+        void setScheduling(SchedulingEnum v) {_scheduling = v;}
+
+        /** @brief how the render window is shared out between threads */
+        SchedulingEnum getScheduling(void) const {return _scheduling;}
+
         /** @brief overridden from OFX::MultiThread::Processor. This function is called once on each SMP thread by the base class */
         void multiThreadFunction(unsigned int threadId, unsigned int nThreads)
         {
+            if (_scheduling == eSchedulingTiles) {
+                multiThreadProcessTiles(nThreads);
+                return;
+            }
+
             // slice the y range into the number of threads it has
             unsigned int dy = _renderWindow.y2 - _renderWindow.y1;
             // the following is equivalent to std::ceil(dy/(double)nThreads);
@@ -140,28 +237,28 @@ namespace OFX {
         /** @brief this is called by process to actually process images using OpenCL when isEnabledOpenCLRender is true, override in derived classes */
         virtual void processImagesOpenCL(void)
         {
-            OFX::Log::print("processImagesOpenCL not implemented");
+            OFX_LOG_DEBUG("processImagesOpenCL not implemented");
             OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
         };
 
         /** @brief this is called by process to actually process images using CUDA when isEnabledCudaRender is true, override in derived classes */
         virtual void processImagesCuda(void)
         {
-            OFX::Log::print("processImagesCuda not implemented");
+            OFX_LOG_DEBUG("processImagesCuda not implemented");
             OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
         };
 
         /** @brief this is called by process to actually process images using Metal when isEnabledMetalRender is true, override in derived classes */
         virtual void processImagesMetal(void)
         {
-            OFX::Log::print("processImagesMetal not implemented");
+            OFX_LOG_DEBUG("processImagesMetal not implemented");
             OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
         };
 
         /** @brief this is called by multiThreadFunction to actually process images, override in derived classes */
         virtual void multiThreadProcessImages(OfxRectI window)
         {
-            OFX::Log::print("multiThreadProcessImages not implemented");
+            OFX_LOG_DEBUG("multiThreadProcessImages not implemented");
             OFX::throwSuiteStatusException(kOfxStatErrUnsupported);
         };
 
@@ -191,25 +288,33 @@ namespace OFX {
 
             if (_isEnabledOpenCLRender)
             {
-              OFX::Log::print("processing via OpenCL");
+              OFX_LOG_DEBUG("processing via OpenCL");
                 processImagesOpenCL();
             }
             else if (_isEnabledCudaRender)
             {
-              OFX::Log::print("processing via CUDA");
+              OFX_LOG_DEBUG("processing via CUDA");
                 processImagesCuda();
             }
             else if (_isEnabledMetalRender)
             {
-              OFX::Log::print("processing via Metal");
+              OFX_LOG_DEBUG("processing via Metal");
                 processImagesMetal();
             }
             else // is CPU
             {
-              OFX::Log::print("processing via CPU");
-                // make sure there are at least 4096 pixels per CPU and at least 1 line par CPU
-                unsigned int nCPUs = (std::min(_renderWindow.x2 - _renderWindow.x1, 4096) *
-                                      (_renderWindow.y2 - _renderWindow.y1)) / 4096;
+              OFX_LOG_DEBUG("processing via CPU");
+                unsigned int nCPUs;
+                if (_scheduling == eSchedulingTiles) {
+                    // there is no point in more threads than there are tiles to start with
+                    setupTiles();
+                    nCPUs = (_renderWindow.y2 - _renderWindow.y1 + _tileRows - 1) / _tileRows;
+                }
+                else {
+                    // make sure there are at least 4096 pixels per CPU and at least 1 line par CPU
+                    nCPUs = (std::min(_renderWindow.x2 - _renderWindow.x1, 4096) *
+                             (_renderWindow.y2 - _renderWindow.y1)) / 4096;
+                }
                 // make sure the number of CPUs is valid (and use at least 1 CPU)
                 nCPUs = std::max(1u, std::min(nCPUs, OFX::MultiThread::getNumCPUs()));
 
@@ -223,6 +328,217 @@ namespace OFX {
 
     };
 
+    ////////////////////////////////////////////////////////////////////////////////
+    // pixel kernels
+
+// the row loops are compiled for several x86 instruction sets with gcc and clang's target attributes
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define OFXS_KERNEL_X86
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#  define OFXS_KERNEL_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#  define OFXS_KERNEL_INLINE __forceinline
+#else
+#  define OFXS_KERNEL_INLINE inline
+#endif
+
+// tells the compiler the source and destination rows do not overlap
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#  define OFXS_KERNEL_RESTRICT __restrict
+#else
+#  define OFXS_KERNEL_RESTRICT
+#endif
+
+// tells the compiler the pixels of a batch are independent, so it can vectorise without checking
+#if defined(__clang__)
+#  define OFXS_KERNEL_INDEPENDENT _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#  define OFXS_KERNEL_INDEPENDENT _Pragma("GCC ivdep")
+#else
+#  define OFXS_KERNEL_INDEPENDENT
+#endif
+
+    /** @brief Enumerates the vector instruction sets pixel kernels are run with */
+    enum VectorISAEnum {
+        eVectorISADefault, /**< @brief whatever the plugin was compiled for */
+        eVectorISANEON,    /**< @brief ARM NEON, which the default build uses where it is available */
+        eVectorISASSE4,    /**< @brief SSE 4.2 */
+        eVectorISAAVX2,    /**< @brief AVX2 and FMA */
+        eVectorISAAVX512   /**< @brief AVX-512 F, BW and VL */
+    };
+
+    /** @brief the best vector instruction set the CPU has, found on first use */
+    inline VectorISAEnum getVectorISA(void)
+    {
+        struct Local {
+            static VectorISAEnum find(void)
+            {
+#ifdef OFXS_KERNEL_X86
+                __builtin_cpu_init();
+                if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl"))
+                    return eVectorISAAVX512;
+                if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+                    return eVectorISAAVX2;
+                if(__builtin_cpu_supports("sse4.2"))
+                    return eVectorISASSE4;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+                return eVectorISANEON;
+#endif
+                return eVectorISADefault;
+            }
+        };
+        static const VectorISAEnum isa = Local::find();
+        return isa;
+    }
+
+    /** @brief Runs a pixel kernel along spans of a row.
+
+    The kernel is any type with a const member that does one pixel,
+    @verbatim
+      void operator()(const PIX *srcPix, PIX *dstPix) const;
+    @endverbatim
+    where each pointer is to the nComponents components of a pixel, and the source and destination
+    rows do not overlap. The span loop hands the
+    kernel pixels in fixed size batches, which the compiler can unroll and vectorise, then
+    the remaining pixels one at a time. On x86 the loop is compiled for each of SSE4, AVX2 and
+    AVX-512 and the best the CPU has is picked at run time, the kernel being inlined into each
+    so long as it is defined where it is visible, eg: in the body of its class.
+    */
+    template <class KERNEL, class PIX, int nComponents>
+    class PixelKernelRows {
+    public :
+        /** @brief the pixels handed to the kernel at a time in the body of a span */
+        static const int kBatch = 16;
+
+        /** @brief a function to run the kernel along a span of n pixels */
+        typedef void (*SpanFunction)(const KERNEL &kernel, const PIX *src, PIX *dst, int n);
+
+    protected :
+        static OFXS_KERNEL_INLINE void span(const KERNEL &kernel, const PIX *OFXS_KERNEL_RESTRICT src, PIX *OFXS_KERNEL_RESTRICT dst, int n)
+        {
+            int x = 0;
+            for(; x + kBatch <= n; x += kBatch) {
+                OFXS_KERNEL_INDEPENDENT
+                for(int b = 0; b < kBatch; ++b)
+                    kernel(src + (x + b) * nComponents, dst + (x + b) * nComponents);
+            }
+            for(; x < n; ++x)
+                kernel(src + x * nComponents, dst + x * nComponents);
+        }
+
+        static void spanDefault(const KERNEL &kernel, const PIX *src, PIX *dst, int n) {span(kernel, src, dst, n);}
+
+#ifdef OFXS_KERNEL_X86
+        __attribute__((target("sse4.2")))
+        static void spanSSE4(const KERNEL &kernel, const PIX *src, PIX *dst, int n) {span(kernel, src, dst, n);}
+
+        __attribute__((target("avx2,fma")))
+        static void spanAVX2(const KERNEL &kernel, const PIX *src, PIX *dst, int n) {span(kernel, src, dst, n);}
+
+        __attribute__((target("avx512f,avx512bw,avx512vl")))
+        static void spanAVX512(const KERNEL &kernel, const PIX *src, PIX *dst, int n) {span(kernel, src, dst, n);}
+#endif
+
+    public :
+        /** @brief the span function for the given instruction set */
+        static SpanFunction getSpanFunction(VectorISAEnum isa = getVectorISA())
+        {
+#ifdef OFXS_KERNEL_X86
+            switch(isa) {
+            case eVectorISAAVX512 : return spanAVX512;
+            case eVectorISAAVX2 : return spanAVX2;
+            case eVectorISASSE4 : return spanSSE4;
+            default : break;
+            }
+#else
+            (void) isa;
+#endif
+            return spanDefault;
+        }
+
+        /** @brief Run the kernel over the rows of a window of the destination image.
+
+        Destination pixels with no source pixel under them, or all of them if there is no
+        source image, are set to zero, as with the other processors. Stops early if the
+        effect is asked to abort.
+        */
+        static void process(const KERNEL &kernel, OFX::ImageEffect &effect,
+                            const OFX::Image *srcImg, OFX::Image &dstImg, const OfxRectI &window)
+        {
+            SpanFunction spanFunction = getSpanFunction();
+
+            for(int y = window.y1; y < window.y2; y++) {
+                if(effect.abort()) break;
+
+                PIX *dstPix = (PIX *) dstImg.getPixelAddress(window.x1, y);
+
+                // the part of the row the source covers
+                int x1 = window.x2, x2 = window.x2;
+                if(srcImg) {
+                    const OfxRectI &srcBounds = srcImg->getBounds();
+                    if(y >= srcBounds.y1 && y < srcBounds.y2) {
+                        x1 = std::min(std::max(window.x1, srcBounds.x1), window.x2);
+                        x2 = std::max(std::min(window.x2, srcBounds.x2), x1);
+                    }
+                }
+                if(x1 == x2)
+                    x1 = x2 = window.x2;
+
+                // no src pixels here, be black and transparent
+                std::fill(dstPix, dstPix + (x1 - window.x1) * nComponents, PIX(0));
+                if(x2 > x1)
+                    spanFunction(kernel, (const PIX *) srcImg->getPixelAddress(x1, y), dstPix + (x1 - window.x1) * nComponents, x2 - x1);
+                std::fill(dstPix + (x2 - window.x1) * nComponents, dstPix + (window.x2 - window.x1) * nComponents, PIX(0));
+            }
+        }
+    };
+
+    /** @brief A processor that runs a pixel kernel over a source image into the destination.
+
+    Plugin authors write the kernel, as described by PixelKernelRows, and instantiate this for
+    each pixel type and component count they support, eg:
+    @verbatim
+      template <class PIX, int max>
+      struct Invert {
+        void operator()(const PIX *srcPix, PIX *dstPix) const
+        {
+          for(int c = 0; c < 4; c++)
+            dstPix[c] = max - srcPix[c];
+        }
+      };
+
+      OFX::PixelKernelProcessor<Invert<unsigned char, 255>, unsigned char, 4> processor(*this, Invert<unsigned char, 255>());
+    @endverbatim
+    */
+    template <class KERNEL, class PIX, int nComponents>
+    class PixelKernelProcessor : public ImageProcessor {
+    protected :
+        KERNEL _kernel;           /**< @brief the kernel to run */
+        OFX::Image *_srcImg;      /**< @brief image to process from */
+
+    public :
+        /** @brief ctor */
+        PixelKernelProcessor(OFX::ImageEffect &effect, const KERNEL &kernel = KERNEL())
+          : ImageProcessor(effect)
+          , _kernel(kernel)
+          , _srcImg(0)
+        {
+        }
+
+        /** @brief set the src image */
+        void setSrcImg(OFX::Image *v) {_srcImg = v;}
+
+        /** @brief the kernel, to set any state on it before processing */
+        KERNEL &getKernel(void) {return _kernel;}
+
+        /** @brief overridden from ImageProcessor, runs the kernel over the window */
+        virtual void multiThreadProcessImages(OfxRectI window)
+        {
+            PixelKernelRows<KERNEL, PIX, nComponents>::process(_kernel, _effect, _srcImg, *_dstImg, window);
+        }
+    };
 
 };
 #endif
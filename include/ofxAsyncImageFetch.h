@@ -0,0 +1,86 @@
+#ifndef _ofxAsyncImageFetch_h_
+#define _ofxAsyncImageFetch_h_
+
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file ofxAsyncImageFetch.h
+
+This file contains an optional suite for fetching images from clips without blocking.
+
+OfxImageEffectSuiteV1::clipGetImage does not return until the host has the image, which may
+mean rendering a whole upstream branch. A plugin that needs several images, eg: a number of
+frames from one clip or a frame from each of several clips, waits for each in turn. With this
+suite the plugin starts all of its fetches first and then waits on each of them, leaving the
+host free to make them at the same time.
+
+Fetches may only be started and finished from within an action in which the plugin could
+call OfxImageEffectSuiteV1::clipGetImage, and every fetch started in an action must be
+finished or abandoned before that action returns.
+*/
+
+/** @brief The name of the async image fetch suite, used to fetch from a host via
+    OfxHost::fetchSuite
+ */
+#define kOfxAsyncImageFetchSuite "OfxAsyncImageFetchSuite"
+
+/** @brief Blind handle to an image fetch in progress */
+typedef struct OfxImageFetchStruct *OfxImageFetchHandle;
+
+typedef struct OfxAsyncImageFetchSuiteV1
+{
+  /** @brief Starts fetching an image from a clip, without waiting for it.
+
+  \arg \c clip   clip to fetch the image from
+  \arg \c time   time to fetch the image at
+  \arg \c region region to fetch, as for OfxImageEffectSuiteV1::clipGetImage, may be NULL
+  \arg \c fetch  handle to the fetch, to pass to ::clipFinishImageFetch or ::clipAbandonImageFetch
+
+  @returns
+    - ::kOfxStatOK            - the fetch has started
+    - ::kOfxStatErrBadHandle  - the clip handle was invalid
+    - ::kOfxStatErrMemory     - the host could not start the fetch, the plugin should fall back to OfxImageEffectSuiteV1::clipGetImage
+  */
+  OfxStatus (*clipStartImageFetch)(OfxImageClipHandle clip,
+                                   OfxTime time,
+                                   const OfxRectD *region,
+                                   OfxImageFetchHandle *fetch);
+
+  /** @brief Waits for a fetch to finish and gets the image it fetched.
+
+  \arg \c fetch       handle of the fetch, which is no longer valid after this call
+  \arg \c imageHandle property set containing the image's data, which must be released
+                      with OfxImageEffectSuiteV1::clipReleaseImage
+
+  @returns the same as OfxImageEffectSuiteV1::clipGetImage would have
+  */
+  OfxStatus (*clipFinishImageFetch)(OfxImageFetchHandle fetch,
+                                    OfxPropertySetHandle *imageHandle);
+
+  /** @brief Abandons a fetch, releasing the image should it have been fetched.
+
+  \arg \c fetch handle of the fetch, which is no longer valid after this call
+
+  The host may wait for the fetch to finish before returning.
+
+  @returns
+    - ::kOfxStatOK            - the fetch was abandoned
+    - ::kOfxStatErrBadHandle  - the fetch handle was invalid
+  */
+  OfxStatus (*clipAbandonImageFetch)(OfxImageFetchHandle fetch);
+} OfxAsyncImageFetchSuiteV1;
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
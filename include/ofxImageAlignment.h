@@ -0,0 +1,44 @@
+#ifndef _ofxImageAlignment_h_
+#define _ofxImageAlignment_h_
+
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file ofxImageAlignment.h
+
+This file contains an optional host property that tells plugins how the rows of the images
+they are given are aligned in memory.
+
+Plugins that process images with vector instructions can only count on a row starting at an
+aligned address if the host says so, and otherwise have to assume the worst. Hosts that pad
+their images' rows so that each starts on a cache line can say so with this property.
+*/
+
+/** @brief Indicates the alignment, in bytes, the host guarantees for the start of every row of the images it hands to plugins.
+
+    - Type - int X 1
+    - Property Set - host descriptor (read only, optional)
+    - Default - 0, no guarantee
+    - Valid Values - 0, or a power of two
+
+When this is N, the address of the pixel at the left of the bounds of every row of every
+image the host returns from clipGetImage, and of the images it renders into, is a multiple
+of N, as is kOfxImagePropRowBytes. Pixels within a row are only as aligned as that and their
+size allow. Hosts that do not support this property will not set it.
+*/
+#define kOfxImageEffectHostPropRowAlignment "OfxImageEffectHostPropRowAlignment"
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef _ofxParamBatch_h_
+#define _ofxParamBatch_h_
+
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "ofxCore.h"
+#include "ofxParam.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file ofxParamBatch.h
+
+This file contains an optional suite for evaluating a parameter at many times in a single call.
+
+Motion blur and other temporal effects typically read the same animated parameter at many
+sub-frame times during a render. Going through OfxParameterSuiteV1::paramGetValueAtTime for
+each of those costs a var args call per sample, this suite lets the host fill a whole buffer
+of samples at once, which lets it walk its animation curves in order.
+
+Only parameters whose values are doubles can be batch evaluated, that is parameters of type
+::kOfxParamTypeDouble, ::kOfxParamTypeDouble2D, ::kOfxParamTypeDouble3D, ::kOfxParamTypeRGB
+and ::kOfxParamTypeRGBA.
+*/
+
+/** @brief The name of the parameter batch suite, used to fetch from a host via
+    OfxHost::fetchSuite
+ */
+#define kOfxParameterBatchSuite "OfxParameterBatchSuite"
+
+typedef struct OfxParameterBatchSuiteV1
+{
+  /** @brief Gets the value of a parameter at each of an array of times.
+
+  \arg \c paramHandle parameter handle to fetch values from
+  \arg \c times       array of \e nTimes times to evaluate the parameter at
+  \arg \c nTimes      number of times to evaluate the parameter at
+  \arg \c values      buffer to write the values into
+
+  The values are written interleaved, the value at times[i] for dimension d of the
+  parameter is written to values[i * dimension + d], so \e values must hold
+  \e nTimes times the dimension of the parameter doubles. The times need not be
+  sorted, though hosts will generally evaluate sorted times fastest.
+
+  @returns
+    - ::kOfxStatOK       - all was OK
+    - ::kOfxStatErrBadHandle  - if the parameter handle was invalid
+    - ::kOfxStatErrUnsupported - if the parameter is not of a type that can be batch evaluated
+  */
+  OfxStatus (*paramGetValuesAtTimes)(OfxParamHandle  paramHandle,
+                                     const OfxTime *times,
+                                     int nTimes,
+                                     double *values);
+
+  /** @brief Gets the value of a parameter at evenly spaced times.
+
+  \arg \c paramHandle parameter handle to fetch values from
+  \arg \c start       first time to evaluate the parameter at
+  \arg \c step        time between each evaluation
+  \arg \c nTimes      number of times to evaluate the parameter at
+  \arg \c values      buffer to write the values into
+
+  This is the same as ::paramGetValuesAtTimes with times[i] = start + i * step.
+
+  @returns
+    - ::kOfxStatOK       - all was OK
+    - ::kOfxStatErrBadHandle  - if the parameter handle was invalid
+    - ::kOfxStatErrUnsupported - if the parameter is not of a type that can be batch evaluated
+  */
+  OfxStatus (*paramGetValuesOverRange)(OfxParamHandle  paramHandle,
+                                       OfxTime start,
+                                       OfxTime step,
+                                       int nTimes,
+                                       double *values);
+} OfxParameterBatchSuiteV1;
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
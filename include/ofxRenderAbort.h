@@ -0,0 +1,46 @@
+#ifndef _ofxRenderAbort_h_
+#define _ofxRenderAbort_h_
+
+// Copyright OpenFX and contributors to the OpenFX project.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "ofxCore.h"
+#include "ofxImageEffect.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file ofxRenderAbort.h
+
+This file contains an optional render action argument that lets a plugin see that a render
+has been cancelled without calling back into the host.
+
+Plugins typically poll OfxImageEffectSuiteV1::abort once per row of the image they are
+processing, from every thread they render on. Hosts that want a cancelled render to stop
+promptly, eg: when scrubbing, can instead hand the plugin the address of the flag they set
+when they cancel the render, which the plugin can read at the cost of a single load.
+*/
+
+/** @brief Indicates the address of a flag the host sets when it cancels the render.
+
+    - Type - pointer X 1
+    - Property Set - a read only in argument property to the ::kOfxImageEffectActionRender action (optional)
+
+The flag is an int, aligned as an int, which is 0 while the render may continue and which the
+host sets to 1, atomically, from any thread, to cancel the render. It is never set back to 0
+while the render action is running, and it remains valid until the render action returns.
+
+Reading the flag is equivalent to calling OfxImageEffectSuiteV1::abort, a plugin that sees it
+set should stop rendering and return from the render action as soon as it can. Hosts that
+do not support this property will not set it, in which case plugins call the suite instead.
+*/
+#define kOfxImageEffectPropRenderAbortFlag "OfxImageEffectPropRenderAbortFlag"
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif